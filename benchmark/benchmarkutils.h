@@ -0,0 +1,72 @@
+#ifndef BENCHMARK_BENCHMARKUTILS_H
+#define BENCHMARK_BENCHMARKUTILS_H
+
+#include "core/stream/syntheticstream.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cassert>
+
+
+namespace benchmarks
+{
+
+constexpr size_t WIDTH = core::SyntheticStream::WIDTH_INPUT_STREAM;
+constexpr size_t HEIGHT = core::SyntheticStream::HEIGHT_INPUT_STREAM;
+constexpr size_t PIXELS_COUNT = WIDTH * HEIGHT;
+
+// frames/s and ns/pixel instead of plain time per iteration (one iteration = one frame)
+inline void setFrameCounters(benchmark::State& state, size_t pixelsCount = PIXELS_COUNT)
+{
+    state.counters["frames/s"] = benchmark::Counter(1.0, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["ns/pixel"] = benchmark::Counter(double(pixelsCount) * 1e-9, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+inline core::ImageData createRaw14ImageData(uint64_t frameNumber = 0)
+{
+    core::ImageData imageData(core::ImageData::Type::Raw14Bit);
+    imageData.data.resize(PIXELS_COUNT * 2);
+    core::SyntheticStream::generateRaw14(frameNumber, imageData.data);
+    return imageData;
+}
+
+inline core::ImageData createYuyv422ImageData(uint64_t frameNumber = 0)
+{
+    core::ImageData imageData(core::ImageData::Type::YUYV422);
+    imageData.data.resize(PIXELS_COUNT * 2);
+    core::SyntheticStream::generateYuyv422(frameNumber, imageData.data);
+    return imageData;
+}
+
+inline core::ImageData createPaletteIndicesImageData(uint64_t frameNumber = 0)
+{
+    core::ImageData imageData(core::ImageData::Type::PaletteIndices);
+    imageData.data.resize(PIXELS_COUNT);
+    for (size_t i = 0; i < imageData.data.size(); ++i)
+    {
+        imageData.data[i] = static_cast<uint8_t>(i % WIDTH + i / WIDTH + frameNumber);
+    }
+    return imageData;
+}
+
+inline core::ImageData createImageData(core::ImageData::Type type)
+{
+    switch (type)
+    {
+    case core::ImageData::Type::Raw14Bit:
+        return createRaw14ImageData();
+    case core::ImageData::Type::PaletteIndices:
+        return createPaletteIndicesImageData();
+    case core::ImageData::Type::YUYV422:
+        return createYuyv422ImageData();
+    case core::ImageData::Type::RGB:
+        break;
+    }
+
+    assert(false && "Unsupported type!");
+    return core::ImageData(type);
+}
+
+} // namespace benchmarks
+
+#endif // BENCHMARK_BENCHMARKUTILS_H
@@ -0,0 +1,292 @@
+#include "emulateddatalink.h"
+
+#include "core/connection/resultdeviceinfo.h"
+#include "core/connection/tcsipacket.h"
+#include "core/wtc640/memoryspacewtc640.h"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+
+namespace benchmarks
+{
+
+namespace
+{
+
+using core::connection::TCSIPacket;
+
+constexpr size_t COMMAND_POSITION = 1;
+constexpr size_t ADDRESS_POSITION = 2;
+constexpr size_t COUNT_POSITION = 6;
+
+constexpr uint8_t COMMAND_READ = 0x80;
+constexpr uint8_t COMMAND_WRITE = 0x81;
+constexpr uint8_t COMMAND_FLASH_BURST_START = 0x82;
+constexpr uint8_t COMMAND_FLASH_BURST_END = 0x83;
+
+// main firmware of current version, user mode and ready
+constexpr std::array<uint8_t, 4> DEVICE_IDENTIFICATOR_VALUE {0x57, 0x06, 0x4D, 0x06};
+constexpr uint32_t STATUS_VALUE = 0b01 << 3;
+
+} // namespace
+
+const EmulatedDataLink::LinkParameters EmulatedDataLink::IDEAL_LINK {};
+const EmulatedDataLink::LinkParameters EmulatedDataLink::UART_921600 {std::chrono::microseconds(200), 92'160}; // 8N1
+const EmulatedDataLink::LinkParameters EmulatedDataLink::USB_FULL_SPEED {std::chrono::microseconds(1000), 1'000'000};
+
+EmulatedDataLink::EmulatedDataLink(const LinkParameters& linkParameters) :
+    m_linkParameters(linkParameters)
+{
+    writeMemoryImpl(core::connection::MemorySpaceWtc640::DEVICE_IDENTIFICATOR.getFirstAddress(), DEVICE_IDENTIFICATOR_VALUE);
+
+    std::array<uint8_t, sizeof(STATUS_VALUE)> status;
+    boost::endian::store_little_u32(status.data(), STATUS_VALUE);
+    writeMemoryImpl(core::connection::MemorySpaceWtc640::STATUS.getFirstAddress(), status);
+}
+
+std::shared_ptr<EmulatedDataLink> EmulatedDataLink::createInstance(const LinkParameters& linkParameters)
+{
+    return std::shared_ptr<EmulatedDataLink>(new EmulatedDataLink(linkParameters));
+}
+
+bool EmulatedDataLink::isOpened() const
+{
+    const std::scoped_lock lock(m_mutex);
+
+    return m_opened;
+}
+
+void EmulatedDataLink::closeConnection()
+{
+    const std::scoped_lock lock(m_mutex);
+
+    m_opened = false;
+}
+
+size_t EmulatedDataLink::getMaxDataSize() const
+{
+    return std::numeric_limits<size_t>::max();
+}
+
+core::VoidResult EmulatedDataLink::read(std::span<uint8_t> buffer, const std::chrono::steady_clock::duration& timeout)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (!m_opened)
+    {
+        return core::VoidResult::createError("Unable to read - no connection", "emulated link closed", &core::connection::INFO_NO_CONNECTION);
+    }
+
+    if (m_response.size() - m_responsePosition < buffer.size())
+    {
+        lock.unlock();
+        std::this_thread::sleep_for(timeout);
+        return core::VoidResult::createError("Read error", "emulated device timed out", &core::connection::INFO_NO_RESPONSE);
+    }
+
+    const auto responseReadyTime = m_responseReadyTime;
+    std::copy_n(m_response.begin() + m_responsePosition, buffer.size(), buffer.begin());
+    m_responsePosition += buffer.size();
+    lock.unlock();
+
+    std::this_thread::sleep_until(responseReadyTime);
+    return core::VoidResult::createOk();
+}
+
+core::VoidResult EmulatedDataLink::write(std::span<const uint8_t> buffer, const std::chrono::steady_clock::duration& timeout)
+{
+    const std::scoped_lock lock(m_mutex);
+
+    if (!m_opened)
+    {
+        return core::VoidResult::createError("Unable to write - no connection", "emulated link closed", &core::connection::INFO_NO_CONNECTION);
+    }
+
+    m_request.insert(m_request.end(), buffer.begin(), buffer.end());
+    processRequest();
+
+    return core::VoidResult::createOk();
+}
+
+void EmulatedDataLink::dropPendingData()
+{
+    const std::scoped_lock lock(m_mutex);
+
+    m_request.clear();
+    m_response.clear();
+    m_responsePosition = 0;
+}
+
+bool EmulatedDataLink::isConnectionLost() const
+{
+    return false;
+}
+
+void EmulatedDataLink::writeMemory(uint32_t address, std::span<const uint8_t> data)
+{
+    const std::scoped_lock lock(m_mutex);
+
+    writeMemoryImpl(address, data);
+}
+
+void EmulatedDataLink::readMemory(uint32_t address, std::span<uint8_t> data) const
+{
+    const std::scoped_lock lock(m_mutex);
+
+    readMemoryImpl(address, data);
+}
+
+void EmulatedDataLink::setRejectedWriteRange(const std::optional<core::connection::AddressRange>& addressRange)
+{
+    const std::scoped_lock lock(m_mutex);
+
+    m_rejectedWriteRange = addressRange;
+}
+
+EmulatedDataLink::Statistics EmulatedDataLink::getStatistics() const
+{
+    const std::scoped_lock lock(m_mutex);
+
+    return m_statistics;
+}
+
+void EmulatedDataLink::processRequest()
+{
+    if (m_request.size() < TCSIPacket::HEADER_SIZE)
+    {
+        return;
+    }
+
+    const size_t requestSize = TCSIPacket::MINIMUM_PACKET_SIZE + m_request[COUNT_POSITION];
+    if (m_request.size() < requestSize)
+    {
+        return;
+    }
+
+    const std::vector<uint8_t> request(m_request.begin(), m_request.begin() + requestSize);
+    m_request.erase(m_request.begin(), m_request.begin() + requestSize);
+
+    // previous response not read completely is overwritten like by late device
+    m_response = createResponse(request);
+    m_responsePosition = 0;
+
+    // whole request has to arrive before device answers, response is complete after its transfer
+    const auto now = std::chrono::steady_clock::now();
+    m_responseReadyTime = now + getTransferDuration(request.size()) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_linkParameters.latency) + getTransferDuration(m_response.size());
+
+    ++m_statistics.requestsCount;
+    m_statistics.bytesTransferred += request.size() + m_response.size();
+}
+
+std::vector<uint8_t> EmulatedDataLink::createResponse(const std::vector<uint8_t>& request)
+{
+    const TCSIPacket packet(request);
+    const uint32_t address = boost::endian::load_little_u32(request.data() + ADDRESS_POSITION);
+
+    if (!packet.validateAsRequest().isOk())
+    {
+        return TCSIPacket::createErrorResponse(packet.getPacketId(), address, TCSIPacket::Status::WRONG_CHECKSUM).getPacketData();
+    }
+
+    const auto payload = packet.getPayloadData();
+    switch (request[COMMAND_POSITION])
+    {
+        case COMMAND_READ:
+        {
+            std::vector<uint8_t> data(payload.front(), 0);
+            readMemoryImpl(address, data);
+            return TCSIPacket::createOkResponse(packet.getPacketId(), address, data).getPacketData();
+        }
+
+        case COMMAND_WRITE:
+            if (m_rejectedWriteRange.has_value() && !payload.empty() && m_rejectedWriteRange->overlaps(core::connection::AddressRange::firstAndSize(address, payload.size())))
+            {
+                return TCSIPacket::createErrorResponse(packet.getPacketId(), address, TCSIPacket::Status::INCORRECT_VALUE).getPacketData();
+            }
+            writeMemoryImpl(address, payload);
+            break;
+
+        case COMMAND_FLASH_BURST_START:
+            m_flashBurstAddress = address;
+            ++m_statistics.flashBurstsCount;
+            break;
+
+        case COMMAND_FLASH_BURST_END:
+            if (m_flashBurstAddress != address)
+            {
+                return TCSIPacket::createErrorResponse(packet.getPacketId(), address, TCSIPacket::Status::FLASH_BURST_ERROR).getPacketData();
+            }
+            m_flashBurstAddress = std::nullopt;
+            break;
+
+        default:
+            return TCSIPacket::createErrorResponse(packet.getPacketId(), address, TCSIPacket::Status::UNKNOWN_COMMAND).getPacketData();
+    }
+
+    return TCSIPacket::createOkResponse(packet.getPacketId(), address, {}).getPacketData();
+}
+
+void EmulatedDataLink::writeMemoryImpl(uint32_t address, std::span<const uint8_t> data)
+{
+    for (size_t position = 0; position < data.size(); )
+    {
+        const uint32_t currentAddress = address + position;
+        const uint32_t offset = currentAddress % PAGE_SIZE;
+        const size_t size = std::min<size_t>(PAGE_SIZE - offset, data.size() - position);
+
+        auto& page = m_pages[currentAddress / PAGE_SIZE];
+        page.resize(PAGE_SIZE, 0);
+        std::copy_n(data.begin() + position, size, page.begin() + offset);
+
+        position += size;
+    }
+}
+
+void EmulatedDataLink::readMemoryImpl(uint32_t address, std::span<uint8_t> data) const
+{
+    for (size_t position = 0; position < data.size(); )
+    {
+        const uint32_t currentAddress = address + position;
+        const uint32_t offset = currentAddress % PAGE_SIZE;
+        const size_t size = std::min<size_t>(PAGE_SIZE - offset, data.size() - position);
+
+        // never written memory reads as zeros
+        const auto pageIt = m_pages.find(currentAddress / PAGE_SIZE);
+        if (pageIt != m_pages.end())
+        {
+            std::copy_n(pageIt->second.begin() + offset, size, data.begin() + position);
+        }
+        else
+        {
+            std::fill_n(data.begin() + position, size, 0);
+        }
+
+        position += size;
+    }
+}
+
+std::chrono::steady_clock::duration EmulatedDataLink::getTransferDuration(size_t bytesCount) const
+{
+    if (m_linkParameters.bytesPerSecond == 0)
+    {
+        return std::chrono::steady_clock::duration(0);
+    }
+
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(bytesCount * 1'000'000'000ULL / m_linkParameters.bytesPerSecond));
+}
+
+EmulatedDevice::EmulatedDevice(const EmulatedDataLink::LinkParameters& linkParameters) :
+    link(EmulatedDataLink::createInstance(linkParameters)),
+    status(std::make_shared<core::connection::Status>()),
+    protocolInterface(std::make_shared<core::connection::ProtocolInterfaceTCSI>(status)),
+    deviceInterface(std::make_shared<core::connection::DeviceInterfaceWtc640>(protocolInterface, status))
+{
+    protocolInterface->setDataLinkInterface(link);
+    deviceInterface->setMemorySpace(core::connection::MemorySpaceWtc640::getDeviceSpace(core::DevicesWtc640::MAIN_USER));
+}
+
+} // namespace benchmarks
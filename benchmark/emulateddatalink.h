@@ -0,0 +1,108 @@
+#ifndef BENCHMARK_EMULATEDDATALINK_H
+#define BENCHMARK_EMULATEDDATALINK_H
+
+#include "core/connection/addressrange.h"
+#include "core/connection/idatalinkinterface.h"
+#include "core/connection/protocolinterfacetcsi.h"
+#include "core/wtc640/deviceinterfacewtc640.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+// in-process WTC640 answering TCSI requests from sparse memory - transfer is delayed according to latency and bandwidth of emulated link
+class EmulatedDataLink final : public core::connection::IDataLinkInterface
+{
+public:
+    struct LinkParameters
+    {
+        std::chrono::nanoseconds latency {0}; // per request-response turnaround
+        uint64_t bytesPerSecond {0}; // 0 = unlimited
+    };
+
+    struct Statistics
+    {
+        uint64_t requestsCount {0};
+        uint64_t bytesTransferred {0};
+        uint64_t flashBurstsCount {0};
+    };
+
+    static const LinkParameters IDEAL_LINK;
+    static const LinkParameters UART_921600;
+    static const LinkParameters USB_FULL_SPEED;
+
+private:
+    explicit EmulatedDataLink(const LinkParameters& linkParameters);
+
+public:
+    static std::shared_ptr<EmulatedDataLink> createInstance(const LinkParameters& linkParameters);
+
+    virtual bool isOpened() const override;
+    virtual void closeConnection() override;
+
+    virtual size_t getMaxDataSize() const override;
+
+    [[nodiscard]] virtual core::VoidResult read(std::span<uint8_t> buffer, const std::chrono::steady_clock::duration& timeout) override;
+    [[nodiscard]] virtual core::VoidResult write(std::span<const uint8_t> buffer, const std::chrono::steady_clock::duration& timeout) override;
+
+    virtual void dropPendingData() override;
+
+    virtual bool isConnectionLost() const override;
+
+    // direct access to emulated memory, bypasses link
+    void writeMemory(uint32_t address, std::span<const uint8_t> data);
+    void readMemory(uint32_t address, std::span<uint8_t> data) const;
+
+    // writes overlapping range are refused by device (INCORRECT_VALUE), nullopt = all writes accepted
+    void setRejectedWriteRange(const std::optional<core::connection::AddressRange>& addressRange);
+
+    Statistics getStatistics() const;
+
+private:
+    void processRequest();
+    std::vector<uint8_t> createResponse(const std::vector<uint8_t>& request);
+
+    void writeMemoryImpl(uint32_t address, std::span<const uint8_t> data);
+    void readMemoryImpl(uint32_t address, std::span<uint8_t> data) const;
+
+    std::chrono::steady_clock::duration getTransferDuration(size_t bytesCount) const;
+
+    static constexpr uint32_t PAGE_SIZE = 4096;
+
+    const LinkParameters m_linkParameters;
+
+    mutable std::mutex m_mutex;
+    bool m_opened {true};
+
+    std::map<uint32_t, std::vector<uint8_t>> m_pages;
+    std::optional<uint32_t> m_flashBurstAddress;
+    std::optional<core::connection::AddressRange> m_rejectedWriteRange;
+
+    std::vector<uint8_t> m_request;
+    std::vector<uint8_t> m_response;
+    size_t m_responsePosition {0};
+    std::chrono::steady_clock::time_point m_responseReadyTime;
+
+    Statistics m_statistics;
+};
+
+// protocol and device interface stack of PropertiesWtc640 over emulated link, already identified as main firmware
+struct EmulatedDevice
+{
+    explicit EmulatedDevice(const EmulatedDataLink::LinkParameters& linkParameters);
+
+    std::shared_ptr<EmulatedDataLink> link;
+    std::shared_ptr<core::connection::Status> status;
+    std::shared_ptr<core::connection::ProtocolInterfaceTCSI> protocolInterface;
+    std::shared_ptr<core::connection::DeviceInterfaceWtc640> deviceInterface;
+};
+
+} // namespace benchmarks
+
+#endif // BENCHMARK_EMULATEDDATALINK_H
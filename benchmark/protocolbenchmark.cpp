@@ -0,0 +1,264 @@
+#include "emulateddatalink.h"
+
+#include "core/misc/imainthreadindicator.h"
+#include "core/properties/taskmanagerqueued.h"
+#include "core/wtc640/propertieswtc640.h"
+
+#include <benchmark/benchmark.h>
+#include <boost/log/core.hpp>
+
+#include <condition_variable>
+#include <numeric>
+
+
+namespace benchmarks
+{
+
+namespace
+{
+
+using core::connection::AddressRange;
+using core::connection::MemorySpaceWtc640;
+
+// per packet logging would dominate measured times
+const bool LOGGING_DISABLED = []()
+{
+    boost::log::core::get()->set_logging_enabled(false);
+    return true;
+}();
+
+// links are passed as benchmark argument
+enum class Link
+{
+    IDEAL,
+    UART_921600,
+    USB_FULL_SPEED,
+};
+
+const std::vector<int64_t> ALL_LINKS = {static_cast<int64_t>(Link::IDEAL), static_cast<int64_t>(Link::UART_921600), static_cast<int64_t>(Link::USB_FULL_SPEED)};
+// whole matrices over uart take seconds per iteration
+const std::vector<int64_t> FAST_LINKS = {static_cast<int64_t>(Link::IDEAL), static_cast<int64_t>(Link::USB_FULL_SPEED)};
+
+EmulatedDataLink::LinkParameters getLinkParameters(benchmark::State& state)
+{
+    switch (static_cast<Link>(state.range(0)))
+    {
+        case Link::IDEAL:
+            state.SetLabel("ideal");
+            return EmulatedDataLink::IDEAL_LINK;
+
+        case Link::UART_921600:
+            state.SetLabel("uart 921600");
+            return EmulatedDataLink::UART_921600;
+
+        case Link::USB_FULL_SPEED:
+            state.SetLabel("usb full speed");
+            return EmulatedDataLink::USB_FULL_SPEED;
+    }
+
+    assert(false && "Unknown link!");
+    return EmulatedDataLink::IDEAL_LINK;
+}
+
+class MainThreadIndicator final : public core::IMainThreadIndicator
+{
+public:
+    [[nodiscard]] virtual bool isInGuiThread() override
+    {
+        return false;
+    }
+};
+
+void setLinkCounters(benchmark::State& state, const EmulatedDataLink::Statistics& statistics)
+{
+    state.counters["requests"] = benchmark::Counter(double(statistics.requestsCount), benchmark::Counter::kAvgIterations);
+    state.counters["linkBytes"] = benchmark::Counter(double(statistics.bytesTransferred), benchmark::Counter::kAvgIterations);
+}
+
+const AddressRange NUC_MATRIX = AddressRange::firstAndSize(MemorySpaceWtc640::RAM_CALIBRATION_MATRICE.getFirstAddress(), MemorySpaceWtc640::PRESET_MATRIX_SIZE);
+const AddressRange FLASH_MATRIX = AddressRange::firstAndSize(MemorySpaceWtc640::FLASH_MEMORY.getFirstAddress() + 0x0010'0000, MemorySpaceWtc640::PRESET_MATRIX_SIZE);
+
+
+// request-response turnaround without device interface checks and retries
+void BM_ProtocolReadRegister(benchmark::State& state)
+{
+    const EmulatedDevice device(getLinkParameters(state));
+    std::array<uint8_t, 4> data;
+
+    for (auto _ : state)
+    {
+        const auto result = device.protocolInterface->readData(data, MemorySpaceWtc640::MAIN_FIRMWARE_VERSION.getFirstAddress(), std::chrono::seconds(1));
+        if (!result.isOk())
+        {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(data.data());
+    }
+    setLinkCounters(state, device.link->getStatistics());
+}
+BENCHMARK(BM_ProtocolReadRegister)->ArgsProduct({ALL_LINKS})->UseRealTime();
+
+void BM_DeviceReadRegister(benchmark::State& state)
+{
+    const EmulatedDevice device(getLinkParameters(state));
+
+    for (auto _ : state)
+    {
+        const auto result = device.deviceInterface->readTypedDataFromRange<uint32_t>(MemorySpaceWtc640::MAIN_FIRMWARE_VERSION, core::ProgressTask());
+        if (!result.isOk())
+        {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result.getValue().data());
+    }
+    setLinkCounters(state, device.link->getStatistics());
+}
+BENCHMARK(BM_DeviceReadRegister)->ArgsProduct({ALL_LINKS})->UseRealTime();
+
+// one NUC matrix split into maximum sized packets
+void BM_DeviceReadNucMatrix(benchmark::State& state)
+{
+    const EmulatedDevice device(getLinkParameters(state));
+
+    for (auto _ : state)
+    {
+        const auto result = device.deviceInterface->readTypedDataFromRange<uint16_t>(NUC_MATRIX, core::ProgressTask());
+        if (!result.isOk())
+        {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result.getValue().data());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * NUC_MATRIX.getSize());
+    setLinkCounters(state, device.link->getStatistics());
+}
+BENCHMARK(BM_DeviceReadNucMatrix)->ArgsProduct({FAST_LINKS})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// burst start/end per flash sector, words in maximum sized packets
+void BM_DeviceWriteFlashBurst(benchmark::State& state)
+{
+    const EmulatedDevice device(getLinkParameters(state));
+
+    std::vector<uint16_t> matrix(NUC_MATRIX.getSize() / sizeof(uint16_t));
+    std::iota(matrix.begin(), matrix.end(), 0);
+
+    for (auto _ : state)
+    {
+        const auto result = device.deviceInterface->writeTypedData<uint16_t>(matrix, FLASH_MATRIX.getFirstAddress(), core::ProgressTask());
+        if (!result.isOk())
+        {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * FLASH_MATRIX.getSize());
+    setLinkCounters(state, device.link->getStatistics());
+    state.counters["flashBursts"] = benchmark::Counter(double(device.link->getStatistics().flashBurstsCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DeviceWriteFlashBurst)->ArgsProduct({FAST_LINKS})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// identification and prefetched read of all readable properties - what application waits for after connect
+void BM_PropertiesConnectAndRefresh(benchmark::State& state)
+{
+    const auto link = EmulatedDataLink::createInstance(getLinkParameters(state));
+    const auto properties = core::PropertiesWtc640::createInstance(core::Properties::Mode::SYNC_DIRECT, std::make_shared<MainThreadIndicator>(), nullptr);
+
+    if (const auto result = properties->createConnectionStateTransaction().connectDataLink(link); !result.isOk())
+    {
+        state.SkipWithError(result.toString().c_str());
+        return;
+    }
+
+    std::vector<core::PropertyId> readableProperties;
+    {
+        const auto transaction = properties->createPropertiesTransaction();
+        for (const auto& propertyId : transaction.getAllProperyIds())
+        {
+            if (transaction.isPropertyReadable(propertyId))
+            {
+                readableProperties.push_back(propertyId);
+            }
+        }
+        properties->setPropertiesToTouchAfterConnect(readableProperties, transaction);
+    }
+
+    const auto statisticsBefore = link->getStatistics();
+    for (auto _ : state)
+    {
+        // properties are touched when connection state transaction is finished
+        if (const auto result = properties->createConnectionStateTransaction().connectDataLink(link); !result.isOk())
+        {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+
+    auto statistics = link->getStatistics();
+    statistics.requestsCount -= statisticsBefore.requestsCount;
+    statistics.bytesTransferred -= statisticsBefore.bytesTransferred;
+    setLinkCounters(state, statistics);
+    state.counters["properties"] = double(readableProperties.size());
+
+    properties->createConnectionStateTransaction().disconnectCore();
+}
+BENCHMARK(BM_PropertiesConnectAndRefresh)->ArgsProduct({ALL_LINKS})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// N independent tasks added at once, measured until all of them finished
+void BM_TaskManagerQueued(benchmark::State& state)
+{
+    const EmulatedDevice device(EmulatedDataLink::IDEAL_LINK);
+    const auto tasksCount = static_cast<size_t>(state.range(0));
+    const bool readRegister = state.range(1) != 0;
+    state.SetLabel(readRegister ? "register read" : "empty task");
+
+    const auto taskManager = core::TaskManagerQueued::createInstance(device.deviceInterface);
+
+    std::vector<AddressRange> addressRanges;
+    for (size_t i = 0; i < tasksCount; ++i)
+    {
+        addressRanges.push_back(AddressRange::firstAndSize(MemorySpaceWtc640::RAM.getFirstAddress() + i * sizeof(uint32_t), sizeof(uint32_t)));
+    }
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t unfinishedTasksCount = 0;
+
+    for (auto _ : state)
+    {
+        {
+            const std::scoped_lock lock(mutex);
+            unfinishedTasksCount = tasksCount;
+        }
+
+        for (const auto& addressRange : addressRanges)
+        {
+            taskManager->addTaskSimple(addressRange, core::ITaskManager::TaskType::READ_WILD, [&, addressRange]()
+            {
+                auto result = core::VoidResult::createOk();
+                if (readRegister)
+                {
+                    result = device.deviceInterface->readTypedDataFromRange<uint32_t>(addressRange, core::ProgressTask()).toVoidResult();
+                }
+
+                const std::scoped_lock lock(mutex);
+                if (--unfinishedTasksCount == 0)
+                {
+                    finished.notify_one();
+                }
+                return result;
+            });
+        }
+
+        std::unique_lock lock(mutex);
+        finished.wait(lock, [&unfinishedTasksCount]() { return unfinishedTasksCount == 0; });
+    }
+    state.counters["tasks/s"] = benchmark::Counter(double(tasksCount), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_TaskManagerQueued)->ArgsProduct({{1, 8, 64, 512}, {0, 1}})->UseRealTime();
+
+} // namespace
+
+} // namespace benchmarks
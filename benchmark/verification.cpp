@@ -0,0 +1,995 @@
+#include "emulateddatalink.h"
+
+#include "core/connection/deviceinterfacewritecombining.h"
+#include "core/misc/colorizationkernels.h"
+#include "core/misc/framestatistics.h"
+#include "core/misc/imainthreadindicator.h"
+#include "core/misc/instructionset.h"
+#include "core/misc/temporalfilter.h"
+#include "core/properties/properties.inl"
+#include "core/properties/propertiescache.h"
+#include "core/stream/framegrabber.h"
+#include "core/stream/rawvideorecorder.h"
+#include "core/stream/rawvideoreplaystream.h"
+#include "core/stream/streamhub.h"
+#include "core/stream/syntheticstream.h"
+#include "core/wtc640/deadpixelsreplacement.h"
+#include "core/wtc640/nuccorrection.h"
+#include "core/wtc640/postprocessingmatrices.h"
+#include "core/wtc640/propertieswtc640.h"
+#include "core/wtc640/propertyidwtc640.h"
+#include "core/utils.h"
+
+#include <boost/log/core.hpp>
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+
+
+namespace benchmarks
+{
+
+namespace
+{
+
+using core::VoidResult;
+using core::connection::MemorySpaceWtc640;
+
+// failed check ends its section with error naming the condition
+#define EXPECT_TRUE(condition) \
+    if (!(condition)) \
+    { \
+        return VoidResult::createError("Check failed!", utils::format("line {}: {}", __LINE__, #condition)); \
+    }
+
+#define EXPECT_OK(expression) \
+    if (const auto verifyResult = (expression); !verifyResult.isOk()) \
+    { \
+        return VoidResult::createError("Check failed!", utils::format("line {}: {} => {}", __LINE__, #expression, verifyResult.toString())); \
+    }
+
+std::string getTemporaryFilename(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / ("thermal-core-verification-" + name)).string();
+}
+
+// runs function with every instruction set supported by cpu (scalar first), instruction set of kernels is restored afterwards
+VoidResult forEachInstructionSet(const std::function<VoidResult (core::simd::InstructionSet)>& function)
+{
+    using core::simd::InstructionSet;
+
+    const auto previousInstructionSet = core::simd::getInstructionSet();
+    auto result = VoidResult::createOk();
+    for (const auto instructionSet : {InstructionSet::SCALAR, InstructionSet::SSE41, InstructionSet::AVX2})
+    {
+        if (instructionSet > core::simd::getSupportedInstructionSet())
+        {
+            break;
+        }
+
+        core::simd::setInstructionSet(instructionSet);
+        result = function(instructionSet);
+        if (!result.isOk())
+        {
+            break;
+        }
+    }
+    core::simd::setInstructionSet(previousInstructionSet);
+    return result;
+}
+
+class MainThreadIndicator final : public core::IMainThreadIndicator
+{
+public:
+    [[nodiscard]] virtual bool isInGuiThread() override
+    {
+        return false;
+    }
+};
+
+// little endian raw data of values
+std::vector<uint8_t> toRawData(const std::vector<uint16_t>& values)
+{
+    std::vector<uint8_t> rawData(values.size() * 2);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        rawData[2 * i] = static_cast<uint8_t>(values[i]);
+        rawData[2 * i + 1] = static_cast<uint8_t>(values[i] >> 8);
+    }
+    return rawData;
+}
+
+// PropertiesWtc640 connected to emulated device in SYNC_DIRECT mode
+struct ConnectedProperties
+{
+    ConnectedProperties() :
+        link(EmulatedDataLink::createInstance(EmulatedDataLink::IDEAL_LINK)),
+        properties(core::PropertiesWtc640::createInstance(core::Properties::Mode::SYNC_DIRECT, std::make_shared<MainThreadIndicator>(), nullptr))
+    {
+    }
+
+    ~ConnectedProperties()
+    {
+        properties->createConnectionStateTransaction().disconnectCore();
+    }
+
+    VoidResult connect()
+    {
+        return properties->createConnectionStateTransaction().connectDataLink(link);
+    }
+
+    std::shared_ptr<EmulatedDataLink> link;
+    std::shared_ptr<core::PropertiesWtc640> properties;
+};
+
+
+// prefetch after connect reads only ranges of touched properties
+VoidResult verifyPrefetchOfTouchedProperties()
+{
+    ConnectedProperties device;
+    EXPECT_OK(device.connect());
+
+    const auto getConnectStatistics = [&device](const std::vector<core::PropertyId>& propertiesToTouch) -> core::ValueResult<EmulatedDataLink::Statistics>
+    {
+        device.properties->setPropertiesToTouchAfterConnect(propertiesToTouch, device.properties->createPropertiesTransaction());
+
+        const auto statisticsBefore = device.link->getStatistics();
+        if (const auto result = device.connect(); !result.isOk())
+        {
+            return core::ValueResult<EmulatedDataLink::Statistics>::createFromError(result);
+        }
+        const auto statisticsAfter = device.link->getStatistics();
+        return EmulatedDataLink::Statistics {statisticsAfter.requestsCount - statisticsBefore.requestsCount,
+                                             statisticsAfter.bytesTransferred - statisticsBefore.bytesTransferred,
+                                             0};
+    };
+
+    const auto withoutTouch = getConnectStatistics({});
+    EXPECT_OK(withoutTouch);
+    // adjacent registers and their adjacent flash copies
+    const auto withLeds = getConnectStatistics({core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT,
+                                                core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT,
+                                                core::PropertyIdWtc640::LED_B_BRIGHTNESS_CURRENT,
+                                                core::PropertyIdWtc640::LED_R_BRIGHTNESS_IN_FLASH,
+                                                core::PropertyIdWtc640::LED_G_BRIGHTNESS_IN_FLASH,
+                                                core::PropertyIdWtc640::LED_B_BRIGHTNESS_IN_FLASH});
+    EXPECT_OK(withLeds);
+
+    // registers and protocol overhead, not ranges of all properties
+    EXPECT_TRUE(withLeds.getValue().bytesTransferred > withoutTouch.getValue().bytesTransferred);
+    EXPECT_TRUE(withLeds.getValue().bytesTransferred - withoutTouch.getValue().bytesTransferred < 256);
+    // registers are read by one word per packet (not prefetched), flash copies are prefetched by one packet
+    EXPECT_TRUE(withLeds.getValue().requestsCount - withoutTouch.getValue().requestsCount == 3 + 1);
+
+    const auto transaction = device.properties->createPropertiesTransaction();
+    EXPECT_TRUE(transaction.getValue<unsigned>(core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT).containsValue());
+
+    return VoidResult::createOk();
+}
+
+// cache key follows settings changed behind application's back, file round trip, corrupted files are refused without huge allocations
+VoidResult verifyPropertiesCache()
+{
+    ConnectedProperties device;
+    device.properties->setPropertiesToTouchAfterConnect({core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT, core::PropertyIdWtc640::LED_B_BRIGHTNESS_CURRENT},
+                                                        device.properties->createPropertiesTransaction());
+    EXPECT_OK(device.connect());
+
+    const auto createCache = [&device]()
+    {
+        const auto transaction = device.properties->createConnectionExclusiveTransactionWtc640(false);
+        return device.properties->createPropertiesCache(transaction.getConnectionExclusiveTransaction());
+    };
+
+    const auto cache = createCache();
+    EXPECT_OK(cache);
+    EXPECT_TRUE(!cache.getValue().getBlocks().empty());
+
+    // e.g. another application changed setting
+    const std::array<uint8_t, 4> brightness {3, 0, 0, 0};
+    device.link->writeMemory(MemorySpaceWtc640::LED_G_BRIGHTNESS_CURRENT.getFirstAddress(), brightness);
+    const auto changedCache = createCache();
+    EXPECT_OK(changedCache);
+    EXPECT_TRUE(changedCache.getValue().getKey() != cache.getValue().getKey());
+
+    // every cached range is covered, palettes through their flash image
+    const std::array<uint8_t, 4> paletteColor {1, 2, 3, 4};
+    device.link->writeMemory(MemorySpaceWtc640::getPaletteDataInFlash(MemorySpaceWtc640::PALETTES_FACTORY_MAX_COUNT).getFirstAddress(), paletteColor);
+    const auto changedPaletteCache = createCache();
+    EXPECT_OK(changedPaletteCache);
+    EXPECT_TRUE(changedPaletteCache.getValue().getKey() != changedCache.getValue().getKey());
+
+    const auto filename = getTemporaryFilename("properties.cache");
+    EXPECT_OK(cache.getValue().saveToFile(filename));
+    const auto loadedCache = core::PropertiesCache::loadFromFile(filename);
+    EXPECT_OK(loadedCache);
+    EXPECT_TRUE(loadedCache.getValue().getKey() == cache.getValue().getKey());
+    EXPECT_TRUE(loadedCache.getValue().getBlocks() == cache.getValue().getBlocks());
+
+    // truncated in last block
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 1);
+    EXPECT_TRUE(!core::PropertiesCache::loadFromFile(filename).isOk());
+
+    // valid header and key, then blocks count far above file size
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        const std::array<uint32_t, 5> header {0x43505757, 1, 0, 0xFFFF'FFFF, 0};
+        file.write(reinterpret_cast<const char*>(header.data()), sizeof(header));
+    }
+    EXPECT_TRUE(!core::PropertiesCache::loadFromFile(filename).isOk());
+
+    std::filesystem::remove(filename);
+    return VoidResult::createOk();
+}
+
+// adjacent registers written by applyValues reach the device, invalid value refuses whole set
+VoidResult verifyApplyValues()
+{
+    ConnectedProperties device;
+    EXPECT_OK(device.connect());
+
+    const auto readRegister = [&device](const core::connection::AddressRange& addressRange)
+    {
+        std::array<uint8_t, 4> data {};
+        device.link->readMemory(addressRange.getFirstAddress(), data);
+        return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+    };
+
+    const auto transaction = device.properties->createPropertiesTransaction();
+    EXPECT_OK(transaction.applyValues({{core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT, std::any(2u)},
+                                       {core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT, std::any(3u)},
+                                       {core::PropertyIdWtc640::LED_B_BRIGHTNESS_CURRENT, std::any(4u)}}));
+
+    EXPECT_TRUE(readRegister(MemorySpaceWtc640::LED_R_BRIGHTNESS_CURRENT) == 2);
+    EXPECT_TRUE(readRegister(MemorySpaceWtc640::LED_G_BRIGHTNESS_CURRENT) == 3);
+    EXPECT_TRUE(readRegister(MemorySpaceWtc640::LED_B_BRIGHTNESS_CURRENT) == 4);
+    EXPECT_OK(transaction.getLastWriteResult(core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT));
+    EXPECT_OK(transaction.getLastWriteResult(core::PropertyIdWtc640::LED_B_BRIGHTNESS_CURRENT));
+
+    // LED_R below minimum
+    const auto requestsBefore = device.link->getStatistics().requestsCount;
+    EXPECT_TRUE(!transaction.applyValues({{core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT, std::any(0u)},
+                                          {core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT, std::any(5u)}}).isOk());
+    EXPECT_TRUE(device.link->getStatistics().requestsCount == requestsBefore);
+    EXPECT_TRUE(readRegister(MemorySpaceWtc640::LED_G_BRIGHTNESS_CURRENT) == 3);
+
+    return VoidResult::createOk();
+}
+
+// write refused by device is reported and its value reset - also when it was flushed early by read of pending data (read-modify-write)
+VoidResult verifyWriteFailures()
+{
+    const auto ledR = MemorySpaceWtc640::LED_R_BRIGHTNESS_CURRENT;
+    const auto ledG = MemorySpaceWtc640::LED_G_BRIGHTNESS_CURRENT;
+
+    {
+        const EmulatedDevice device(EmulatedDataLink::IDEAL_LINK);
+        core::connection::DeviceInterfaceWriteCombining deviceInterface(device.deviceInterface.get());
+        device.link->setRejectedWriteRange(ledR);
+
+        const std::array<uint8_t, 4> value {2, 0, 0, 0};
+        EXPECT_OK(deviceInterface.writeData(value, ledR.getFirstAddress(), core::ProgressTask()));
+        // read of pending register flushes it, device refuses the write
+        std::array<uint8_t, 4> readValue {};
+        EXPECT_TRUE(!deviceInterface.readData(readValue, ledR.getFirstAddress(), core::ProgressTask()).isOk());
+        EXPECT_OK(deviceInterface.writeData(value, ledG.getFirstAddress(), core::ProgressTask()));
+
+        // nothing of failed write is left for final flush
+        EXPECT_OK(deviceInterface.flush(core::ProgressTask()));
+        EXPECT_TRUE(deviceInterface.getFailedRanges() == std::vector<core::connection::AddressRange> {ledR});
+        EXPECT_TRUE(!deviceInterface.getFirstFailedWriteResult().isOk());
+    }
+
+    ConnectedProperties device;
+    EXPECT_OK(device.connect());
+    device.link->setRejectedWriteRange(ledG);
+
+    const auto transaction = device.properties->createPropertiesTransaction();
+    EXPECT_TRUE(!transaction.applyValues({{core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT, std::any(2u)},
+                                          {core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT, std::any(3u)}}).isOk());
+    EXPECT_OK(transaction.getLastWriteResult(core::PropertyIdWtc640::LED_R_BRIGHTNESS_CURRENT));
+    EXPECT_TRUE(!transaction.getLastWriteResult(core::PropertyIdWtc640::LED_G_BRIGHTNESS_CURRENT).isOk());
+
+    std::array<uint8_t, 4> data {};
+    device.link->readMemory(ledR.getFirstAddress(), data);
+    EXPECT_TRUE(data[0] == 2);
+    device.link->readMemory(ledG.getFirstAddress(), data);
+    EXPECT_TRUE(data[0] != 3);
+
+    return VoidResult::createOk();
+}
+
+// subscriber types are checked against acquisition type on start, converted frames have sizes of their types
+VoidResult verifyStreamHub()
+{
+    using core::ImageData;
+    using core::SyntheticStream;
+
+    const auto hub = core::StreamHub::createInstance(SyntheticStream::createStream(std::chrono::nanoseconds(0)));
+    const auto indicesSubscriber = hub->subscribe(ImageData::Type::PaletteIndices);
+    EXPECT_OK(indicesSubscriber);
+    const auto rgbSubscriber = hub->subscribe(ImageData::Type::RGB);
+    EXPECT_OK(rgbSubscriber);
+
+    // palette indices cannot be converted from YUYV
+    EXPECT_TRUE(!hub->start(ImageData::Type::YUYV422).isOk());
+    EXPECT_TRUE(!hub->isRunning());
+
+    EXPECT_OK(hub->start(ImageData::Type::Raw14Bit));
+    const size_t pixelsCount = SyntheticStream::WIDTH_INPUT_STREAM * SyntheticStream::HEIGHT_INPUT_STREAM;
+
+    const auto indices = indicesSubscriber.getValue()->read(std::chrono::seconds(1));
+    EXPECT_TRUE(indices != nullptr);
+    EXPECT_TRUE(indices->type == ImageData::Type::PaletteIndices && indices->data.size() == pixelsCount);
+
+    const auto rgb = rgbSubscriber.getValue()->read(std::chrono::seconds(1));
+    EXPECT_TRUE(rgb != nullptr);
+    EXPECT_TRUE(rgb->type == ImageData::Type::RGB && rgb->data.size() == pixelsCount * 3);
+
+    hub->stop();
+    EXPECT_TRUE(!hub->isRunning());
+
+    return VoidResult::createOk();
+}
+
+// stream giving frames one by one as released by test - sequence number of frame counts from 1
+class GatedStream final : public core::IStream
+{
+public:
+    [[nodiscard]] virtual VoidResult startStream(core::ImageData::Type) override
+    {
+        m_running = true;
+        return VoidResult::createOk();
+    }
+
+    [[nodiscard]] virtual VoidResult stopStream() override
+    {
+        m_running = false;
+        return VoidResult::createOk();
+    }
+
+    [[nodiscard]] virtual bool isRunning() const override
+    {
+        return m_running;
+    }
+
+    [[nodiscard]] virtual VoidResult readFrame(core::Frame& frame) override
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_condition.wait_for(lock, std::chrono::milliseconds(10), [this]()
+            {
+                return m_releasedCount > m_readCount;
+            }))
+        {
+            return VoidResult::createError("No frame released!");
+        }
+
+        core::FrameMetadata metadata;
+        metadata.sequenceNumber = ++m_readCount;
+        frame.assign(core::ImageData::Type::Raw14Bit, m_data, nullptr, nullptr);
+        frame.setMetadata(metadata);
+
+        return VoidResult::createOk();
+    }
+
+    void releaseFrame()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_releasedCount;
+        }
+        m_condition.notify_all();
+    }
+
+private:
+    std::atomic<bool> m_running {false};
+    std::array<uint8_t, 4> m_data {};
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    uint64_t m_releasedCount {0};
+    uint64_t m_readCount {0};
+};
+
+// frame pinned by one consumer is skipped by grabber, other consumer keeps reading every frame without drops (OVERWRITE_OLDEST)
+VoidResult verifyFrameGrabberPinnedFrame()
+{
+    using core::FrameGrabber;
+
+    constexpr size_t CAPACITY = 4;
+    constexpr uint64_t FRAMES_COUNT = 5 * CAPACITY;
+
+    const auto stream = std::make_shared<GatedStream>();
+    EXPECT_OK(stream->startStream(core::ImageData::Type::Raw14Bit));
+
+    const auto grabber = FrameGrabber::createInstance(stream, CAPACITY, FrameGrabber::OverflowPolicy::OVERWRITE_OLDEST);
+    const auto holdingConsumer = grabber->createConsumer();
+    const auto readingConsumer = grabber->createConsumer();
+    EXPECT_OK(grabber->start());
+
+    stream->releaseFrame();
+    FrameGrabber::FrameRef heldFrame;
+    EXPECT_TRUE(holdingConsumer->read(heldFrame, std::chrono::seconds(1)));
+    EXPECT_TRUE(heldFrame.getFrame().getMetadata().sequenceNumber == 1);
+
+    FrameGrabber::FrameRef frame;
+    EXPECT_TRUE(readingConsumer->read(frame, std::chrono::seconds(1)));
+    for (uint64_t frameNumber = 2; frameNumber <= FRAMES_COUNT; ++frameNumber)
+    {
+        // previous frame released before next one is grabbed - no frame of reading consumer is pinned, so none may be dropped
+        frame.reset();
+        stream->releaseFrame();
+        EXPECT_TRUE(readingConsumer->read(frame, std::chrono::seconds(1)));
+        EXPECT_TRUE(frame.getFrame().getMetadata().sequenceNumber == frameNumber);
+    }
+    frame.reset();
+
+    EXPECT_TRUE(readingConsumer->getDroppedFramesCount() == 0);
+    EXPECT_TRUE(grabber->getStatistics().framesGrabbed == FRAMES_COUNT);
+    EXPECT_TRUE(grabber->getStatistics().framesDropped == 0);
+    EXPECT_TRUE(heldFrame.getFrame().getMetadata().sequenceNumber == 1);
+
+    heldFrame.reset();
+    grabber->stop();
+
+    return VoidResult::createOk();
+}
+
+// recorded frames are replayed with same data and metadata, small chunks => records split over several chunks
+VoidResult verifyRawVideoRoundTrip()
+{
+    using core::ImageData;
+
+    constexpr uint32_t WIDTH = 16;
+    constexpr uint32_t HEIGHT = 8;
+    constexpr size_t FRAMES_COUNT = 7;
+
+    const auto getRawData = [](size_t frameIndex)
+    {
+        std::vector<uint8_t> data(WIDTH * HEIGHT * 2);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<uint8_t>(frameIndex * 31 + i);
+        }
+        return data;
+    };
+    const auto getMetadata = [](size_t frameIndex)
+    {
+        core::FrameMetadata metadata;
+        metadata.deviceTimestamp = std::chrono::milliseconds(frameIndex * 33);
+        metadata.sequenceNumber = frameIndex;
+        metadata.blockId = 100 + frameIndex;
+        return metadata;
+    };
+
+    const auto filename = getTemporaryFilename("video.raw");
+    const auto recorder = core::RawVideoRecorder::createInstance(1024, 4);
+    EXPECT_OK(recorder->open(filename, WIDTH, HEIGHT));
+    for (size_t frameIndex = 0; frameIndex < FRAMES_COUNT; ++frameIndex)
+    {
+        EXPECT_TRUE(recorder->addFrame(ImageData::Type::Raw14Bit, getRawData(frameIndex), getMetadata(frameIndex)));
+    }
+    // frame of other type is stored, but not replayed as raw
+    const std::vector<uint8_t> yuyvData(WIDTH * HEIGHT * 2, 0x80);
+    EXPECT_TRUE(recorder->addFrame(ImageData::Type::YUYV422, yuyvData, getMetadata(FRAMES_COUNT)));
+    EXPECT_OK(recorder->close());
+
+    const auto stream = core::RawVideoReplayStream::createStream(filename, core::RawVideoReplayStream::Pacing::MAXIMUM, false);
+    EXPECT_OK(stream);
+    EXPECT_TRUE(stream.getValue()->getFileHeader().width == WIDTH && stream.getValue()->getFileHeader().height == HEIGHT);
+    EXPECT_TRUE(stream.getValue()->getFramesCount() == FRAMES_COUNT + 1);
+
+    EXPECT_OK(stream.getValue()->startStream(ImageData::Type::Raw14Bit));
+    for (size_t frameIndex = 0; frameIndex < FRAMES_COUNT; ++frameIndex)
+    {
+        core::Frame frame;
+        EXPECT_OK(stream.getValue()->readFrame(frame));
+        EXPECT_TRUE(frame.getType() == ImageData::Type::Raw14Bit);
+
+        const auto expectedData = getRawData(frameIndex);
+        EXPECT_TRUE(std::equal(frame.getData().begin(), frame.getData().end(), expectedData.begin(), expectedData.end()));
+
+        // host timestamp is time of replay
+        auto expectedMetadata = getMetadata(frameIndex);
+        expectedMetadata.hostTimestamp = frame.getMetadata().hostTimestamp;
+        EXPECT_TRUE(frame.getMetadata() == expectedMetadata);
+    }
+    EXPECT_OK(stream.getValue()->stopStream());
+
+    std::filesystem::remove(filename);
+    return VoidResult::createOk();
+}
+
+// outputs of every colorization kernel for one pixel format, min/max results appended as raw data
+template<core::colorization::PixelFormat FORMAT>
+std::vector<std::vector<uint8_t>> colorizeByAllKernels(const std::vector<uint8_t>& rawData, const std::vector<uint8_t>& indices, const std::vector<uint8_t>& yuyvData)
+{
+    using namespace core::colorization;
+
+    constexpr uint8_t ALPHA = 200;
+    const size_t pixelsCount = rawData.size() / 2;
+    const auto packedPalette = createPackedPalette<FORMAT>(core::Palette(), ALPHA);
+    const auto [min, max] = findRaw14MinMax(rawData);
+
+    std::vector<std::vector<uint8_t>> outputs(5, std::vector<uint8_t>(pixelsCount * PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL));
+    colorizePaletteIndices<FORMAT>(indices, packedPalette, outputs[0]);
+    colorizeRaw14<FORMAT>(rawData, Raw14Window::create(min, max), packedPalette, outputs[1]);
+
+    auto lut = std::make_unique<Raw14Lut>();
+    fillRaw14Lut(Raw14Window::create(min, max), packedPalette, *lut);
+    colorizeRaw14WithLut<FORMAT>(rawData, *lut, outputs[2]);
+    const auto [fusedMin, fusedMax] = colorizeRaw14WithLutAndFindMinMax<FORMAT>(rawData, *lut, outputs[3]);
+
+    outputs[4].resize(yuyvData.size() / 2 * PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL);
+    convertYuyv422<FORMAT>(yuyvData, ALPHA, outputs[4]);
+
+    outputs.push_back(toRawData({min, max, fusedMin, fusedMax}));
+    return outputs;
+}
+
+// every colorization kernel (palette indices, raw 14bit with window, lut, lut fused with min/max, YUYV) gives same output with every instruction set,
+// lengths not divisible by vector widths exercise tails, flat frames map to first palette color
+VoidResult verifyColorizationKernels()
+{
+    using core::colorization::PixelFormat;
+
+    std::mt19937 generator(2);
+
+    for (const size_t pixelsCount : {size_t(1), size_t(2), size_t(7), size_t(15), size_t(16), size_t(31), size_t(33), size_t(1003), size_t(640 * 3 + 18)})
+    {
+        for (const bool flat : {false, true})
+        {
+            std::vector<uint16_t> values(pixelsCount, 9'000);
+            std::vector<uint8_t> indices(pixelsCount, 17);
+            std::vector<uint8_t> yuyvData((pixelsCount + 1) / 2 * 4, 0x80);
+            if (!flat)
+            {
+                // values above 14 bits are clamped by lut kernels
+                std::generate(values.begin(), values.end(), [&generator]() { return static_cast<uint16_t>(generator() % 16'384 + (generator() % 50 == 0 ? 40'000 : 0)); });
+                std::generate(indices.begin(), indices.end(), [&generator]() { return static_cast<uint8_t>(generator()); });
+                std::generate(yuyvData.begin(), yuyvData.end(), [&generator]() { return static_cast<uint8_t>(generator()); });
+            }
+            const auto rawData = toRawData(values);
+
+            // min/max found by kernels equal naive min/max
+            const auto [naiveMin, naiveMax] = std::minmax_element(values.begin(), values.end());
+            const auto expectedMinMax = toRawData({*naiveMin, *naiveMax, *naiveMin, *naiveMax});
+
+            std::optional<std::array<std::vector<std::vector<uint8_t>>, 3>> firstOutputs;
+            EXPECT_OK(forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+            {
+                const std::array<std::vector<std::vector<uint8_t>>, 3> outputs {colorizeByAllKernels<PixelFormat::ARGB>(rawData, indices, yuyvData),
+                                                                                colorizeByAllKernels<PixelFormat::BGRA>(rawData, indices, yuyvData),
+                                                                                colorizeByAllKernels<PixelFormat::RGB24>(rawData, indices, yuyvData)};
+                for (const auto& formatOutputs : outputs)
+                {
+                    EXPECT_TRUE(formatOutputs.back() == expectedMinMax);
+                    // same lut => same colors with and without fused min/max
+                    EXPECT_TRUE(formatOutputs[2] == formatOutputs[3]);
+                    if (flat)
+                    {
+                        EXPECT_TRUE(formatOutputs[1] == formatOutputs[2]);
+                    }
+                }
+
+                if (!firstOutputs.has_value())
+                {
+                    firstOutputs = outputs;
+                }
+                EXPECT_TRUE(outputs == firstOutputs.value());
+
+                return VoidResult::createOk();
+            }));
+        }
+    }
+
+    return VoidResult::createOk();
+}
+
+// dead pixel replacement of every instruction set equals average of replacement pixels, entry counts not divisible by vector width,
+// entries using last pixel of frame (not gathered by vector code)
+VoidResult verifyDeadPixelsReplacement()
+{
+    using core::PixelCoordinates;
+
+    std::mt19937 generator(3);
+
+    core::DeadPixels deadPixels;
+    const auto& resolution = deadPixels.getResolutionInPixels();
+    const auto width = static_cast<unsigned>(resolution.width);
+    const auto height = static_cast<unsigned>(resolution.height);
+
+    // dead pixels in columns 4k + 2, replacements next to them => replacement pixel is never dead and replaces one pixel only
+    std::vector<std::pair<unsigned, std::vector<unsigned>>> expectedReplacements;
+    for (size_t i = 0; i < 501; ++i)
+    {
+        const PixelCoordinates coordinates {static_cast<unsigned>(generator() % height), static_cast<unsigned>(generator() % (width / 4)) * 4 + 2};
+        if (deadPixels.containsDeadPixel(coordinates))
+        {
+            continue;
+        }
+
+        core::DeadPixel deadPixel(coordinates);
+        EXPECT_TRUE(deadPixel.addReplacement({coordinates.row, coordinates.column - 1}));
+        if (i % 3 != 0)
+        {
+            EXPECT_TRUE(deadPixel.addReplacement({coordinates.row, coordinates.column + 1}));
+        }
+        EXPECT_OK(deadPixels.insertPixel(deadPixel));
+    }
+
+    // last pixel of frame as replacement
+    core::DeadPixel lastPixelNeighbour({height - 1, width - 2});
+    EXPECT_TRUE(lastPixelNeighbour.addReplacement({height - 1, width - 1}));
+    EXPECT_OK(deadPixels.insertPixel(lastPixelNeighbour));
+
+    const auto replacement = core::DeadPixelsReplacement::create(deadPixels);
+    EXPECT_OK(replacement);
+    EXPECT_TRUE(replacement.getValue().getSize() == deadPixels.getSize());
+
+    std::vector<uint16_t> frame(size_t(width) * height);
+    std::generate(frame.begin(), frame.end(), [&generator]() { return static_cast<uint16_t>(generator() % 16'384); });
+
+    auto expectedFrame = frame;
+    for (const auto& [deadPixel, replacements] : deadPixels.getDeadPixelToReplacementsMap())
+    {
+        const uint32_t a = frame[replacements.front().getPixelIndex(width)];
+        const uint32_t b = frame[replacements.back().getPixelIndex(width)];
+        expectedFrame[deadPixel.getPixelIndex(width)] = static_cast<uint16_t>((a + b) >> 1);
+    }
+
+    return forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+    {
+        auto replacedFrame = frame;
+        EXPECT_OK(replacement.getValue().apply(replacedFrame));
+        EXPECT_TRUE(replacedFrame == expectedFrame);
+
+        return VoidResult::createOk();
+    });
+}
+
+// NUC correction of every instruction set equals scalar float computation, results below zero and above 14 bits are clamped
+VoidResult verifyNucCorrection()
+{
+    std::mt19937 generator(4);
+
+    const size_t pixelsCount = size_t(core::DevicesWtc640::WIDTH) * core::DevicesWtc640::HEIGHT;
+    core::PostProcessingMatrices matrices;
+    matrices.resize(pixelsCount);
+    for (size_t i = 0; i < pixelsCount; ++i)
+    {
+        matrices.nuc[i] = static_cast<float>(static_cast<int16_t>(generator() % 32'768)) / core::PostProcessingMatrices::NUC_FACTOR;
+        matrices.onuc[i] = static_cast<int16_t>(generator() % 4'000) - 2'000;
+        matrices.offset[i] = static_cast<int16_t>(generator() % 4'000) - 2'000;
+    }
+
+    const auto correction = core::NucCorrection::create(matrices);
+    EXPECT_OK(correction);
+
+    std::vector<uint16_t> frame(pixelsCount);
+    std::generate(frame.begin(), frame.end(), [&generator]() { return static_cast<uint16_t>(generator() % 16'384); });
+
+    std::optional<std::vector<uint16_t>> firstFrame;
+    size_t clampedCount = 0;
+    EXPECT_OK(forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+    {
+        auto correctedFrame = frame;
+        EXPECT_OK(correction.getValue().apply(correctedFrame));
+
+        if (!firstFrame.has_value())
+        {
+            firstFrame = correctedFrame;
+            clampedCount = static_cast<size_t>(std::count_if(correctedFrame.begin(), correctedFrame.end(), [](uint16_t value) { return value == 0 || value == 16'383; }));
+        }
+        EXPECT_TRUE(correctedFrame == firstFrame.value());
+
+        return VoidResult::createOk();
+    }));
+    EXPECT_TRUE(clampedCount > 0);
+
+    // corrected = nuc * (raw + onuc) + offset
+    for (size_t i = 0; i < pixelsCount; i += 997)
+    {
+        const double expected = std::clamp(double(matrices.nuc[i]) * (frame[i] + matrices.onuc[i]) + matrices.offset[i], 0.0, 16'383.0);
+        EXPECT_TRUE(std::abs(double(firstFrame.value()[i]) - expected) <= 1.0);
+    }
+
+    return VoidResult::createOk();
+}
+
+// matrices decoded by every instruction set equal original element by element decoding, chunks of pixels not divisible by vector width
+VoidResult verifyPostProcessingMatricesDecoding()
+{
+    using core::PostProcessingMatrices;
+
+    std::mt19937 generator(5);
+
+    const size_t pixelsCount = 2'000;
+    std::vector<uint16_t> words(pixelsCount * PostProcessingMatrices::WORDS_PER_PIXEL);
+    std::generate(words.begin(), words.end(), [&generator]() { return static_cast<uint16_t>(generator()); });
+
+    // original decoding before vectorization
+    PostProcessingMatrices expected;
+    for (size_t i = 1; i < words.size(); i += 4)
+    {
+        expected.onuc.push_back(static_cast<int16_t>(words[i]));
+        expected.nuc.push_back(static_cast<float>(static_cast<int16_t>(words[i + 1])) / PostProcessingMatrices::NUC_FACTOR);
+        expected.offset.push_back(static_cast<int16_t>(words[i + 2]));
+    }
+
+    return forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+    {
+        const auto matrices = PostProcessingMatrices::createFromInterleaved(words);
+        EXPECT_TRUE(matrices.nuc == expected.nuc && matrices.onuc == expected.onuc && matrices.offset == expected.offset);
+
+        // streamed chunks
+        PostProcessingMatrices chunked;
+        chunked.resize(pixelsCount);
+        size_t firstPixel = 0;
+        for (const size_t chunkPixels : {size_t(1), size_t(7), size_t(8), size_t(13), size_t(1'003)})
+        {
+            chunked.decodeInterleaved(std::span<const uint16_t>(words).subspan(firstPixel * PostProcessingMatrices::WORDS_PER_PIXEL, chunkPixels * PostProcessingMatrices::WORDS_PER_PIXEL), firstPixel);
+            firstPixel += chunkPixels;
+        }
+        chunked.decodeInterleaved(std::span<const uint16_t>(words).subspan(firstPixel * PostProcessingMatrices::WORDS_PER_PIXEL), firstPixel);
+        EXPECT_TRUE(chunked.nuc == expected.nuc && chunked.onuc == expected.onuc && chunked.offset == expected.offset);
+
+        return VoidResult::createOk();
+    });
+}
+
+// statistics computed by every instruction set equal naive computation, frame heights split into several row bands
+VoidResult verifyFrameStatistics()
+{
+    using core::FrameStatistics;
+
+    std::mt19937 generator(1);
+
+    for (const auto& size : {core::Size {640, 480}, core::Size {1000, 300}, core::Size {37, 5}})
+    {
+        const size_t width = size.width;
+        const size_t height = size.height;
+
+        std::vector<uint16_t> values(width * height);
+        for (auto& value : values)
+        {
+            // rare values above 14 bits go to last bin of histogram
+            value = static_cast<uint16_t>(generator() % 16'000 + (generator() % 64 == 0 ? 50'000 : 0));
+        }
+        const auto rawData = toRawData(values);
+
+        std::vector<FrameStatistics::Roi> rois;
+        for (size_t i = 0; i < 20; ++i)
+        {
+            FrameStatistics::Roi roi;
+            roi.column = generator() % width;
+            roi.row = generator() % height;
+            roi.width = 1 + generator() % (width - roi.column);
+            roi.height = 1 + generator() % (height - roi.row);
+            if (i % 4 == 0)
+            {
+                roi.mask.resize(roi.width * roi.height);
+                std::generate(roi.mask.begin(), roi.mask.end(), [&generator]() { return static_cast<uint8_t>(generator() % 2); });
+            }
+            rois.push_back(roi);
+        }
+
+        std::optional<FrameStatistics::Statistics> firstGlobal;
+        std::vector<FrameStatistics::Statistics> firstRois;
+        std::vector<uint32_t> firstHistogram;
+
+        const auto isEqual = [](const FrameStatistics::Statistics& first, const FrameStatistics::Statistics& second)
+        {
+            return first.pixelsCount == second.pixelsCount && first.min == second.min && first.max == second.max &&
+                   first.minLocation == second.minLocation && first.maxLocation == second.maxLocation &&
+                   first.mean == second.mean && first.stddev == second.stddev && first.percentiles == second.percentiles;
+        };
+
+        EXPECT_OK(forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+        {
+            FrameStatistics statistics;
+            statistics.setRois(rois);
+            // second frame reuses buffers
+            EXPECT_OK(statistics.compute(rawData, size));
+            EXPECT_OK(statistics.compute(rawData, size));
+
+            if (!firstGlobal.has_value())
+            {
+                firstGlobal = statistics.getGlobalStatistics();
+                firstRois = statistics.getRoiStatistics();
+                firstHistogram = statistics.getHistogram();
+                return VoidResult::createOk();
+            }
+
+            EXPECT_TRUE(isEqual(statistics.getGlobalStatistics(), firstGlobal.value()));
+            EXPECT_TRUE(std::equal(firstRois.begin(), firstRois.end(), statistics.getRoiStatistics().begin(), statistics.getRoiStatistics().end(), isEqual));
+            EXPECT_TRUE(statistics.getHistogram() == firstHistogram);
+            return VoidResult::createOk();
+        }));
+
+        const auto minIt = std::min_element(values.begin(), values.end());
+        const auto maxIt = std::max_element(values.begin(), values.end());
+        const auto getLocation = [&values, width](std::vector<uint16_t>::const_iterator it)
+        {
+            const size_t index = it - values.begin();
+            return FrameStatistics::Location {static_cast<unsigned>(index / width), static_cast<unsigned>(index % width)};
+        };
+        const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+
+        EXPECT_TRUE(firstGlobal->pixelsCount == values.size());
+        EXPECT_TRUE(firstGlobal->min == *minIt && firstGlobal->minLocation == getLocation(minIt));
+        EXPECT_TRUE(firstGlobal->max == *maxIt && firstGlobal->maxLocation == getLocation(maxIt));
+        EXPECT_TRUE(std::abs(firstGlobal->mean - mean) < 1e-6);
+        EXPECT_TRUE(std::accumulate(firstHistogram.begin(), firstHistogram.end(), uint64_t(0)) == values.size());
+
+        for (size_t i = 0; i < rois.size(); ++i)
+        {
+            const auto& roi = rois[i];
+            uint64_t pixelsCount = 0;
+            double sum = 0.0;
+            for (size_t row = 0; row < roi.height; ++row)
+            {
+                for (size_t column = 0; column < roi.width; ++column)
+                {
+                    if (roi.mask.empty() || roi.mask[row * roi.width + column] != 0)
+                    {
+                        ++pixelsCount;
+                        sum += values[(roi.row + row) * width + roi.column + column];
+                    }
+                }
+            }
+
+            EXPECT_TRUE(firstRois[i].pixelsCount == pixelsCount);
+            EXPECT_TRUE(pixelsCount == 0 || std::abs(firstRois[i].mean - sum / pixelsCount) < 1e-6);
+        }
+    }
+
+    return VoidResult::createOk();
+}
+
+// filter output of every instruction set is equal and reuses output buffer, running mean equals naive rounded mean
+VoidResult verifyTemporalFilter()
+{
+    using core::ImageData;
+    using core::TemporalFilter;
+
+    constexpr size_t PIXELS_COUNT = 1003;
+    constexpr unsigned WINDOW_SIZE = 5;
+
+    std::mt19937 generator(3);
+    std::vector<ImageData> frames;
+    for (size_t frameIndex = 0; frameIndex < 20; ++frameIndex)
+    {
+        ImageData frame(ImageData::Type::Raw14Bit);
+        frame.metadata.sequenceNumber = frameIndex;
+        for (size_t i = 0; i < PIXELS_COUNT; ++i)
+        {
+            const auto value = static_cast<uint16_t>(generator() % 16'384);
+            frame.data.push_back(static_cast<uint8_t>(value));
+            frame.data.push_back(static_cast<uint8_t>(value >> 8));
+        }
+        frames.push_back(std::move(frame));
+    }
+    const auto getValue = [](const ImageData& frame, size_t pixel)
+    {
+        return static_cast<unsigned>(frame.data[2 * pixel] | (frame.data[2 * pixel + 1] << 8));
+    };
+
+    for (const auto mode : {TemporalFilter::Mode::RUNNING_MEAN, TemporalFilter::Mode::EXPONENTIAL, TemporalFilter::Mode::MOTION_GATED})
+    {
+        std::vector<ImageData> firstOutputs;
+        EXPECT_OK(forEachInstructionSet([&](core::simd::InstructionSet) -> VoidResult
+        {
+            TemporalFilter filter;
+            EXPECT_OK(filter.setSettings({mode, WINDOW_SIZE, 3, 100}));
+
+            std::vector<ImageData> outputs;
+            ImageData output(ImageData::Type::Raw14Bit);
+            const uint8_t* outputBuffer = nullptr;
+            for (const auto& frame : frames)
+            {
+                EXPECT_OK(filter.filter(frame, output));
+                EXPECT_TRUE(outputBuffer == nullptr || output.data.data() == outputBuffer);
+                outputBuffer = output.data.data();
+                EXPECT_TRUE(output.metadata == frame.metadata);
+                outputs.push_back(output);
+            }
+
+            if (firstOutputs.empty())
+            {
+                firstOutputs = std::move(outputs);
+            }
+            EXPECT_TRUE(outputs.empty() || outputs == firstOutputs);
+            return VoidResult::createOk();
+        }));
+
+        if (mode == TemporalFilter::Mode::RUNNING_MEAN)
+        {
+            for (size_t frameIndex = 0; frameIndex < frames.size(); ++frameIndex)
+            {
+                const size_t firstFrame = frameIndex + 1 >= WINDOW_SIZE ? frameIndex + 1 - WINDOW_SIZE : 0;
+                const size_t framesCount = frameIndex + 1 - firstFrame;
+                for (size_t pixel = 0; pixel < PIXELS_COUNT; ++pixel)
+                {
+                    unsigned sum = 0;
+                    for (size_t i = firstFrame; i <= frameIndex; ++i)
+                    {
+                        sum += getValue(frames[i], pixel);
+                    }
+                    EXPECT_TRUE(getValue(firstOutputs[frameIndex], pixel) == (sum + framesCount / 2) / framesCount);
+                }
+            }
+        }
+    }
+
+    TemporalFilter filter;
+    EXPECT_TRUE(!filter.setSettings({TemporalFilter::Mode::RUNNING_MEAN, TemporalFilter::MAX_WINDOW_SIZE + 1, 3, 100}).isOk());
+
+    // filter fed by stream hub subscriber
+    const auto hub = core::StreamHub::createInstance(core::SyntheticStream::createStream(std::chrono::nanoseconds(0)));
+    const auto subscriber = hub->subscribe(ImageData::Type::Raw14Bit);
+    EXPECT_OK(subscriber);
+    EXPECT_OK(hub->start(ImageData::Type::Raw14Bit));
+    ImageData output(ImageData::Type::Raw14Bit);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto result = subscriber.getValue()->readFiltered(filter, output, std::chrono::seconds(1));
+        EXPECT_OK(result);
+        EXPECT_TRUE(result.getValue());
+    }
+    hub->stop();
+    EXPECT_TRUE(filter.getFramesCount() == 3);
+    EXPECT_TRUE(output.data.size() == size_t(core::SyntheticStream::WIDTH_INPUT_STREAM) * core::SyntheticStream::HEIGHT_INPUT_STREAM * 2);
+
+    return VoidResult::createOk();
+}
+
+} // namespace
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    // per packet logging of emulated device would flood output
+    boost::log::core::get()->set_logging_enabled(false);
+
+    const std::vector<std::pair<std::string, std::function<VoidResult ()>>> sections = {
+        {"prefetch of touched properties", verifyPrefetchOfTouchedProperties},
+        {"properties cache", verifyPropertiesCache},
+        {"apply values", verifyApplyValues},
+        {"write failures", verifyWriteFailures},
+        {"stream hub", verifyStreamHub},
+        {"frame grabber pinned frame", verifyFrameGrabberPinnedFrame},
+        {"raw video round trip", verifyRawVideoRoundTrip},
+        {"colorization kernels", verifyColorizationKernels},
+        {"dead pixels replacement", verifyDeadPixelsReplacement},
+        {"nuc correction", verifyNucCorrection},
+        {"post processing matrices decoding", verifyPostProcessingMatricesDecoding},
+        {"frame statistics", verifyFrameStatistics},
+        {"temporal filter", verifyTemporalFilter},
+    };
+
+    int failedCount = 0;
+    for (const auto& [name, function] : sections)
+    {
+        const auto result = function();
+        std::cout << (result.isOk() ? "PASS " : "FAIL ") << name << (result.isOk() ? "" : ": " + result.getDetailErrorMessage()) << std::endl;
+        failedCount += result.isOk() ? 0 : 1;
+    }
+
+    return failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
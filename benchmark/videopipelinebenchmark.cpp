@@ -0,0 +1,288 @@
+#include "benchmarkutils.h"
+
+#include "core/misc/framestatistics.h"
+#include "core/misc/imagecolorization.h"
+#include "core/misc/instructionset.h"
+#include "core/misc/raw14equalizer.h"
+#include "core/misc/raw14lutcolorizer.h"
+#include "core/stream/framebufferpool.h"
+
+
+namespace benchmarks
+{
+
+namespace
+{
+
+using core::ImageColorization;
+using core::ImageData;
+using core::colorization::PixelFormat;
+
+constexpr uint8_t ALPHA = 255;
+
+// types are passed as benchmark argument
+ImageData::Type getType(const benchmark::State& state)
+{
+    return static_cast<ImageData::Type>(state.range(0));
+}
+
+const std::vector<int64_t> TYPE_ARGUMENTS = {static_cast<int64_t>(ImageData::Type::Raw14Bit), static_cast<int64_t>(ImageData::Type::PaletteIndices), static_cast<int64_t>(ImageData::Type::YUYV422)};
+
+
+void BM_Mono14ColorizationWithPalette(benchmark::State& state)
+{
+    const core::Palette palette;
+    const auto imageData = createRaw14ImageData();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ImageColorization::mono14ColorizationWithPalette(palette, imageData.data));
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_Mono14ColorizationWithPalette)->UseRealTime();
+
+void BM_Mono8ColorizationWithPalette(benchmark::State& state)
+{
+    const core::Palette palette;
+    const auto imageData = createPaletteIndicesImageData();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ImageColorization::mono8ColorizationWithPalette(palette, imageData.data));
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_Mono8ColorizationWithPalette)->UseRealTime();
+
+// legacy std::function pixel format - YUYV422 runs YUYV422ColorizationAsync
+template<uint32_t (*PIXEL_FORMAT)(int, int, int, int)>
+void BM_GetColorDataFunction(benchmark::State& state)
+{
+    const auto imageData = createImageData(getType(state));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ImageColorization::getColorData(core::Palette(), imageData, PIXEL_FORMAT, ALPHA).get());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_GetColorDataFunction<ImageColorization::ARGB_PIXEL_FORMAT>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+BENCHMARK(BM_GetColorDataFunction<ImageColorization::BGRA_PIXEL_FORMAT>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+
+// custom pixel format is not vectorized
+void BM_GetColorDataCustomFunction(benchmark::State& state)
+{
+    const auto imageData = createImageData(getType(state));
+    const ImageColorization::PixelFormatConversionFunction pixelFormat = [](int r, int g, int b, int a)
+    {
+        return ImageColorization::ARGB_PIXEL_FORMAT(r, g, b, a);
+    };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ImageColorization::getColorData(core::Palette(), imageData, pixelFormat, ALPHA).get());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_GetColorDataCustomFunction)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+
+template<PixelFormat FORMAT>
+void BM_GetColorData(benchmark::State& state)
+{
+    const auto imageData = createImageData(getType(state));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ImageColorization::getColorData<FORMAT>(core::Palette(), imageData, ALPHA).get());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_GetColorData<PixelFormat::ARGB>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+BENCHMARK(BM_GetColorData<PixelFormat::BGRA>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+BENCHMARK(BM_GetColorData<PixelFormat::RGB24>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+
+// into caller buffer, no allocation
+template<PixelFormat FORMAT>
+void BM_Colorize(benchmark::State& state)
+{
+    const auto type = getType(state);
+    const auto imageData = createImageData(type);
+    const std::optional<core::Palette> palette = core::Palette();
+    std::vector<uint8_t> output(ImageColorization::getColorDataSize<FORMAT>(type, imageData.data.size()));
+
+    for (auto _ : state)
+    {
+        ImageColorization::colorize<FORMAT>(palette, type, imageData.data, ALPHA, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_Colorize<PixelFormat::ARGB>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+BENCHMARK(BM_Colorize<PixelFormat::RGB24>)->ArgsProduct({TYPE_ARGUMENTS})->UseRealTime();
+
+// single threaded kernel per instruction set
+void BM_ColorizeRaw14Kernel(benchmark::State& state)
+{
+    using namespace core::colorization;
+    using namespace core::simd;
+
+    const auto instructionSet = static_cast<InstructionSet>(state.range(0));
+    if (instructionSet > getSupportedInstructionSet())
+    {
+        state.SkipWithError("Instruction set is not supported by cpu!");
+        return;
+    }
+
+    const auto previousInstructionSet = getInstructionSet();
+    setInstructionSet(instructionSet);
+
+    const auto imageData = createRaw14ImageData();
+    const auto packedPalette = createPackedPalette<PixelFormat::ARGB>(core::Palette(), ALPHA);
+    std::vector<uint8_t> output(PIXELS_COUNT * PixelFormatTraits<PixelFormat::ARGB>::BYTES_PER_PIXEL);
+
+    for (auto _ : state)
+    {
+        const auto [min, max] = findRaw14MinMax(imageData.data);
+        colorizeRaw14<PixelFormat::ARGB>(imageData.data, Raw14Window::create(min, max), packedPalette, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    setFrameCounters(state);
+
+    setInstructionSet(previousInstructionSet);
+}
+BENCHMARK(BM_ColorizeRaw14Kernel)->DenseRange(static_cast<int64_t>(core::simd::InstructionSet::SCALAR), static_cast<int64_t>(core::simd::InstructionSet::AVX2));
+
+void BM_Raw14LutColorizer(benchmark::State& state)
+{
+    using namespace core::colorization;
+
+    Raw14LutColorizer<PixelFormat::ARGB> colorizer(core::Palette(), ALPHA);
+    std::vector<uint8_t> output(PIXELS_COUNT * PixelFormatTraits<PixelFormat::ARGB>::BYTES_PER_PIXEL);
+
+    // consecutive frames of moving pattern => window changes slightly, LUT is rebuilt only when above threshold
+    std::vector<ImageData> frames;
+    for (uint64_t frameNumber = 0; frameNumber < 16; ++frameNumber)
+    {
+        frames.push_back(createRaw14ImageData(frameNumber));
+    }
+
+    size_t frameIndex = 0;
+    for (auto _ : state)
+    {
+        colorizer.colorizeWithPreviousWindow(frames[frameIndex++ % frames.size()].data, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    setFrameCounters(state);
+    state.counters["lutRebuilds"] = double(colorizer.getLutRebuildsCount());
+}
+BENCHMARK(BM_Raw14LutColorizer)->UseRealTime();
+
+void BM_Raw14Equalizer(benchmark::State& state)
+{
+    core::colorization::Raw14Equalizer equalizer;
+    const auto imageData = createRaw14ImageData();
+    std::vector<uint8_t> output(PIXELS_COUNT);
+
+    for (auto _ : state)
+    {
+        equalizer.update(imageData.data);
+        equalizer.mapToPaletteIndices(imageData.data, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_Raw14Equalizer)->UseRealTime();
+
+// 200 rectangle rois, arguments: instruction set, detailed roi statistics
+void BM_FrameStatistics(benchmark::State& state)
+{
+    using namespace core::simd;
+
+    const auto instructionSet = static_cast<InstructionSet>(state.range(0));
+    if (instructionSet > getSupportedInstructionSet())
+    {
+        state.SkipWithError("Instruction set is not supported by cpu!");
+        return;
+    }
+
+    const auto previousInstructionSet = getInstructionSet();
+    setInstructionSet(instructionSet);
+
+    core::FrameStatistics::Settings settings;
+    settings.detailedRoiStatistics = state.range(1) != 0;
+    core::FrameStatistics statistics(settings);
+
+    std::vector<core::FrameStatistics::Roi> rois;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        core::FrameStatistics::Roi roi;
+        roi.column = static_cast<unsigned>((i * 37) % (WIDTH - 32));
+        roi.row = static_cast<unsigned>((i * 53) % (HEIGHT - 32));
+        roi.width = 32;
+        roi.height = 32;
+        rois.push_back(roi);
+    }
+    statistics.setRois(rois);
+
+    const auto imageData = createRaw14ImageData();
+    const core::Size size {static_cast<int>(WIDTH), static_cast<int>(HEIGHT)};
+
+    for (auto _ : state)
+    {
+        const auto result = statistics.compute(imageData, size);
+        benchmark::DoNotOptimize(result.isOk());
+    }
+    setFrameCounters(state);
+
+    setInstructionSet(previousInstructionSet);
+}
+BENCHMARK(BM_FrameStatistics)->ArgsProduct({{static_cast<int64_t>(core::simd::InstructionSet::SCALAR), static_cast<int64_t>(core::simd::InstructionSet::AVX2)}, {0, 1}})->UseRealTime();
+
+void BM_ConvertRGBtoYCbCr(benchmark::State& state)
+{
+    const core::Palette palette;
+    core::Palette::ColorData yCbCr;
+
+    for (auto _ : state)
+    {
+        core::Palette::convertRGBtoYCbCr(palette.getRgb(), yCbCr);
+        benchmark::DoNotOptimize(yCbCr.data());
+    }
+    state.counters["ns/color"] = benchmark::Counter(double(core::Palette::SIZE) * 1e-9, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_ConvertRGBtoYCbCr);
+
+// readImageData path of streams - driver packet (pooled buffer) borrowed by frame and copied into reused ImageData
+void BM_FrameCopyToImageData(benchmark::State& state)
+{
+    const auto type = getType(state);
+    const auto source = createImageData(type);
+    const auto bufferPool = core::FrameBufferPool::createInstance(4, source.data.size());
+    ImageData imageData(type);
+
+    // recycled buffers keep content - filled once like driver buffers
+    {
+        core::Frame frames[4];
+        for (auto& frame : frames)
+        {
+            const auto data = bufferPool->acquire(frame, type, source.data.size());
+            std::copy(source.data.begin(), source.data.end(), data.begin());
+        }
+    }
+
+    for (auto _ : state)
+    {
+        core::Frame frame;
+        (void)bufferPool->acquire(frame, type, source.data.size());
+
+        frame.copyTo(imageData);
+        benchmark::DoNotOptimize(imageData.data.data());
+    }
+    setFrameCounters(state);
+}
+BENCHMARK(BM_FrameCopyToImageData)->Arg(static_cast<int64_t>(ImageData::Type::Raw14Bit))->Arg(static_cast<int64_t>(ImageData::Type::YUYV422));
+
+} // namespace
+
+} // namespace benchmarks
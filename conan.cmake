@@ -34,6 +34,10 @@ function(conan_install)
         set(W_CONAN_ADDITIONAL_INSTALL_ARGS -s:a compiler.libcxx=libc++ ${W_CONAN_ADDITIONAL_INSTALL_ARGS})
     endif()
 
+    if (W_BUILD_BENCHMARKS)
+        set(W_CONAN_ADDITIONAL_INSTALL_ARGS -o "&:with_benchmarks=True" ${W_CONAN_ADDITIONAL_INSTALL_ARGS})
+    endif()
+
     message(STATUS "CMake-Conan: compiler=${_compiler}")
     message(STATUS "CMake-Conan: compiler.version=${_compiler_version}")
 
@@ -0,0 +1,57 @@
+from conan import ConanFile
+
+
+class ThermalCoreConan(ConanFile):
+    settings = "os", "compiler", "build_type", "arch"
+    generators = "CMakeDeps", "CMakeToolchain"
+
+    # Google Benchmark is needed only by benchmark targets (W_BUILD_BENCHMARKS), library consumers do not get it
+    options = {"with_benchmarks": [True, False]}
+    default_options = {
+        "with_benchmarks": False,
+        "ffmpeg/*:shared": True,
+        "ffmpeg/*:avfilter": False,
+        "ffmpeg/*:postproc": False,
+        "ffmpeg/*:with_asm": False,
+        "ffmpeg/*:with_sdl": False,
+        "ffmpeg/*:with_ssl": False,
+        "ffmpeg/*:with_xcb": False,
+        "ffmpeg/*:with_lzma": False,
+        "ffmpeg/*:with_opus": False,
+        "ffmpeg/*:with_xlib": False,
+        "ffmpeg/*:with_zlib": False,
+        "ffmpeg/*:swresample": False,
+        "ffmpeg/*:with_bzip2": False,
+        "ffmpeg/*:with_pulse": False,
+        "ffmpeg/*:with_vaapi": False,
+        "ffmpeg/*:with_vdpau": False,
+        "ffmpeg/*:with_libaom": False,
+        "ffmpeg/*:with_libdrm": False,
+        "ffmpeg/*:with_libvpx": False,
+        "ffmpeg/*:with_vorbis": False,
+        "ffmpeg/*:with_vulkan": False,
+        "ffmpeg/*:with_zeromq": False,
+        "ffmpeg/*:with_libalsa": False,
+        "ffmpeg/*:with_libwebp": False,
+        "ffmpeg/*:with_libx264": False,
+        "ffmpeg/*:with_libx265": False,
+        "ffmpeg/*:with_freetype": False,
+        "ffmpeg/*:with_libdav1d": False,
+        "ffmpeg/*:with_libiconv": False,
+        "ffmpeg/*:with_openh264": False,
+        "ffmpeg/*:with_openjpeg": False,
+        "ffmpeg/*:with_programs": False,
+        "ffmpeg/*:with_libsvtav1": False,
+        "ffmpeg/*:with_libfdk_aac": False,
+        "ffmpeg/*:with_libmp3lame": False,
+    }
+
+    def requirements(self):
+        self.requires("boost/1.85.0")
+        self.requires("libzip/1.11.3")
+        self.requires("ffmpeg/4.4.4")
+        self.requires("libusb/1.0.26")
+        self.requires("openssl/3.4.1")
+
+        if self.options.with_benchmarks:
+            self.requires("benchmark/1.8.4")
@@ -4,11 +4,15 @@
 #include "core/connection/asiodatalinkwithbaudrateandstreamsource.h"
 #include "core/device.h"
 #include "core/connection/serialportinfo.h"
+#include "core/stream/framebufferpool.h"
 
 #include <memory>
 #include <chrono>
+#include <condition_variable>
 
 struct AVFormatContext;
+struct AVPacket;
+struct AVFrame;
 struct AVInputFormat;
 struct AVCodecContext;
 struct AVCodec;
@@ -45,23 +49,44 @@ private:
         [[nodiscard]] virtual VoidResult startStream(ImageData::Type dataType) override;
         [[nodiscard]] virtual VoidResult stopStream() override;
         [[nodiscard]] virtual bool isRunning() const override;
-        [[nodiscard]] virtual VoidResult readImageData(ImageData& imageData) override;
+        [[nodiscard]] virtual VoidResult readFrame(Frame& frame) override;
 
         [[nodiscard]] static ValueResult<std::shared_ptr<UartStream>> createStream(const std::string& deviceName, const std::string inputFormat);
         static constexpr uint16_t WIDTH_INPUT_STREAM = 640;
         static constexpr uint16_t HEIGHT_INPUT_STREAM = 480;
 
     private:
-        [[nodiscard]] VoidResult getFrameData(std::vector<uint8_t>& data);
-        [[nodiscard]] VoidResult getRgbFrameData(std::vector<uint8_t>& data);
+        class PacketPool;
+
+        [[nodiscard]] VoidResult getFrameData(Frame& frame);
+        [[nodiscard]] VoidResult getRgbFrameData(Frame& frame);
+        FrameMetadata createFrameMetadata(const AVPacket* packet);
+
+        static constexpr size_t RGB_BUFFERS_COUNT = 4;
+        static constexpr int FRAME_RATE = 60;
 
         std::string m_deviceName;
         std::string m_inputFormat;
         std::mutex m_streamMutex;
         AVFormatContext* m_inputContext{nullptr};
+
+        // decoding state of RGB stream kept for whole stream lifetime, guarded by m_decodeMutex (locked after m_streamMutex, never both by reader)
+        std::mutex m_decodeMutex;
+        // readers decode packets in order they were read - ticket taken with packet under m_streamMutex, turn advanced under m_decodeMutex
+        std::condition_variable m_decodeTurnChanged;
+        uint64_t m_nextReadTicket{0};
+        uint64_t m_decodeTurn{0};
         AVCodecContext* m_codecContext{nullptr};
+        AVFrame* m_decodedFrame{nullptr};
         SwsContext* m_convertContext{nullptr};
+        int m_rgbFrameSize{0};
+
         ImageData::Type m_dataType;
+
+        // raw frames borrow packets read by ffmpeg, decoded frames are converted into pooled buffers
+        std::shared_ptr<PacketPool> m_packetPool;
+        std::shared_ptr<FrameBufferPool> m_rgbBufferPool;
+        FrameMetadataTracker m_metadataTracker;
     };
 
     void closeConnectionImpl() override;
@@ -0,0 +1,50 @@
+#ifndef CORE_CONNECTION_DEVICEINTERFACEPREFETCHED_H
+#define CORE_CONNECTION_DEVICEINTERFACEPREFETCHED_H
+
+#include "core/connection/ideviceinterface.h"
+
+#include <map>
+
+
+namespace core
+{
+
+namespace connection
+{
+
+// serves reads from blocks prefetched in advance, everything else is forwarded to underlying device
+class DeviceInterfacePrefetched : public IDeviceInterface
+{
+    using BaseClass = IDeviceInterface;
+
+public:
+    explicit DeviceInterfacePrefetched(IDeviceInterface* device);
+
+    // reads every (merged) range at once - blocks which cannot be read are skipped and later read directly from device
+    // ranges already contained in some block are not read again
+    void prefetch(const AddressRanges& addressRanges, ProgressTask progress);
+    void addBlock(const AddressRange& addressRange, const std::vector<uint8_t>& data);
+    void clear();
+
+    size_t getPrefetchedBlocksCount() const;
+    const std::map<AddressRange, std::vector<uint8_t>>& getBlocks() const;
+
+    [[nodiscard]] virtual VoidResult readData(std::span<uint8_t> data, uint32_t address, ProgressTask progress) override;
+    [[nodiscard]] virtual VoidResult writeData(std::span<const uint8_t> data, uint32_t address, ProgressTask progress) override;
+    [[nodiscard]] virtual ValueResult<std::vector<uint8_t>> readSomeData(uint32_t address, ProgressTask progress) override;
+    virtual std::optional<uint32_t> getReadPacketSize(uint32_t address) const override;
+
+private:
+    const std::pair<const AddressRange, std::vector<uint8_t>>* findBlockContaining(const AddressRange& addressRange) const;
+    void removeOverlappingBlocks(const AddressRange& addressRange);
+
+    IDeviceInterface* m_device {nullptr};
+
+    std::map<AddressRange, std::vector<uint8_t>> m_blocks;
+};
+
+} // namespace connection
+
+} // namespace core
+
+#endif // CORE_CONNECTION_DEVICEINTERFACEPREFETCHED_H
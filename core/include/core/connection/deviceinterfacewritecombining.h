@@ -0,0 +1,52 @@
+#ifndef CORE_CONNECTION_DEVICEINTERFACEWRITECOMBINING_H
+#define CORE_CONNECTION_DEVICEINTERFACEWRITECOMBINING_H
+
+#include "core/connection/ideviceinterface.h"
+
+#include <map>
+
+
+namespace core
+{
+
+namespace connection
+{
+
+// defers writes until flush() - overlapping and adjacent writes are coalesced into contiguous blocks written in address order
+// reads touching pending data flush first, so the device is always read after the write
+class DeviceInterfaceWriteCombining : public IDeviceInterface
+{
+    using BaseClass = IDeviceInterface;
+
+public:
+    explicit DeviceInterfaceWriteCombining(IDeviceInterface* device);
+
+    // block which cannot be written at once is written by the original writes one by one - ranges of failed writes are kept in getFailedRanges()
+    [[nodiscard]] VoidResult flush(ProgressTask progress);
+
+    bool hasPendingWrites() const;
+    // failed writes of all flushes (including flushes forced by reads) and error of first of them
+    const std::vector<AddressRange>& getFailedRanges() const;
+    const VoidResult& getFirstFailedWriteResult() const;
+
+    [[nodiscard]] virtual VoidResult readData(std::span<uint8_t> data, uint32_t address, ProgressTask progress) override;
+    [[nodiscard]] virtual VoidResult writeData(std::span<const uint8_t> data, uint32_t address, ProgressTask progress) override;
+    [[nodiscard]] virtual ValueResult<std::vector<uint8_t>> readSomeData(uint32_t address, ProgressTask progress) override;
+    virtual std::optional<uint32_t> getReadPacketSize(uint32_t address) const override;
+
+private:
+    bool overlapsPendingBlock(const AddressRange& addressRange) const;
+
+    IDeviceInterface* m_device {nullptr};
+
+    std::map<AddressRange, std::vector<uint8_t>> m_pendingBlocks;
+    std::vector<std::pair<AddressRange, std::vector<uint8_t>>> m_pendingWrites;
+    std::vector<AddressRange> m_failedRanges;
+    VoidResult m_firstFailedWriteResult {VoidResult::createOk()};
+};
+
+} // namespace connection
+
+} // namespace core
+
+#endif // CORE_CONNECTION_DEVICEINTERFACEWRITECOMBINING_H
@@ -7,6 +7,7 @@
 
 #include <boost/endian.hpp>
 
+#include <optional>
 #include <vector>
 #include <span>
 
@@ -35,6 +36,9 @@ public:
     // reads maximum possible data using one packet
     [[nodiscard]] virtual ValueResult<std::vector<uint8_t>> readSomeData(uint32_t address, ProgressTask progress) = 0;
 
+    // data size of one read packet at address, nullopt if unknown (outside of memory space, not connected)
+    virtual std::optional<uint32_t> getReadPacketSize(uint32_t address) const;
+
     [[nodiscard]] ValueResult<std::vector<uint8_t>> readAddressRange(const AddressRange& addressRange, ProgressTask progress);
 
     template<class T>
@@ -53,6 +57,8 @@ public:
     template<class T>
     [[nodiscard]] std::vector<uint8_t> toByteData(std::span<const T> data) const;
 
+    DeviceEndianity getDeviceEndianity() const;
+
 private:
     DeviceEndianity m_deviceEndianity {DeviceEndianity::LITTLE};
 };
@@ -0,0 +1,58 @@
+#ifndef CORE_ALIGNEDALLOCATOR_H
+#define CORE_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+namespace core
+{
+
+// allocator for std::vector with storage aligned for simd loads
+template<typename T, std::size_t ALIGNMENT>
+class AlignedAllocator
+{
+    static_assert(ALIGNMENT >= alignof(T) && (ALIGNMENT & (ALIGNMENT - 1)) == 0, "Invalid alignment!");
+
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(ALIGNMENT)));
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, ALIGNMENT>&) const noexcept
+    {
+        return true;
+    }
+};
+
+constexpr std::size_t SIMD_ALIGNMENT = 32;
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T, SIMD_ALIGNMENT>>;
+
+} // namespace core
+
+#endif // CORE_ALIGNEDALLOCATOR_H
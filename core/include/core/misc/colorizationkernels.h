@@ -0,0 +1,128 @@
+#ifndef CORE_COLORIZATIONKERNELS_H
+#define CORE_COLORIZATIONKERNELS_H
+
+#include "core/misc/palette.h"
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+#include <cstdint>
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+enum class PixelFormat
+{
+    ARGB,  // uint32_t (a << 24) | (r << 16) | (g << 8) | b
+    BGRA,  // uint32_t (b << 24) | (g << 16) | (r << 8) | a
+    RGB24, // 3 bytes r, g, b
+};
+
+template<PixelFormat FORMAT>
+struct PixelFormatTraits
+{
+    static constexpr size_t BYTES_PER_PIXEL = 4;
+
+    static constexpr uint32_t pack(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        if constexpr (FORMAT == PixelFormat::ARGB)
+        {
+            return (uint32_t(a) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b);
+        }
+        else
+        {
+            return (uint32_t(b) << 24) | (uint32_t(g) << 16) | (uint32_t(r) << 8) | uint32_t(a);
+        }
+    }
+};
+
+template<>
+struct PixelFormatTraits<PixelFormat::RGB24>
+{
+    static constexpr size_t BYTES_PER_PIXEL = 3;
+
+    // byte order r, g, b in memory on little endian - only low 3 bytes are stored
+    static constexpr uint32_t pack(uint8_t r, uint8_t g, uint8_t b, uint8_t)
+    {
+        return uint32_t(r) | (uint32_t(g) << 8) | (uint32_t(b) << 16);
+    }
+};
+
+// palette colors already packed to output pixel format
+using PackedPalette = std::array<uint32_t, Palette::SIZE>;
+
+template<PixelFormat FORMAT>
+PackedPalette createPackedPalette(const Palette& palette, uint8_t alpha);
+
+// maps raw 14bit value to palette index: (min(max(value - min, 0), range) * scale) >> 16
+// flat window (min == max) maps everything to index 0
+class Raw14Window
+{
+public:
+    static Raw14Window create(uint16_t min, uint16_t max);
+
+    uint16_t getMin() const;
+    uint32_t getRange() const;
+    uint32_t getScale() const;
+
+    uint8_t getPaletteIndex(uint16_t value) const
+    {
+        const uint32_t offset = value > m_min ? std::min<uint32_t>(value - m_min, m_range) : 0;
+        return static_cast<uint8_t>((offset * m_scale) >> 16);
+    }
+
+private:
+    uint16_t m_min {0};
+    uint32_t m_range {0};
+    uint32_t m_scale {0};
+};
+
+// little endian 16bit word of raw pixel - upper bits are not masked
+inline uint16_t readRaw14(const uint8_t* rawData, size_t index)
+{
+    return static_cast<uint16_t>(rawData[index * 2]) | (static_cast<uint16_t>(rawData[index * 2 + 1]) << 8);
+}
+
+// raw data are little endian 16bit values, returns {max, 0} for empty data
+std::pair<uint16_t, uint16_t> findRaw14MinMax(std::span<const uint8_t> rawData);
+
+// final packed pixel for every raw 14bit value
+static constexpr size_t RAW14_LUT_SIZE = 1 << 14;
+using Raw14Lut = std::array<uint32_t, RAW14_LUT_SIZE>;
+
+// palette index for every raw 14bit value (e.g. from histogram equalization)
+using Raw14PaletteIndicesLut = std::array<uint8_t, RAW14_LUT_SIZE>;
+
+void fillRaw14Lut(const Raw14Window& window, const PackedPalette& packedPalette, Raw14Lut& lut);
+void fillRaw14Lut(const Raw14PaletteIndicesLut& paletteIndicesLut, const PackedPalette& packedPalette, Raw14Lut& lut);
+
+// output size must be (input pixels count) * PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL
+template<PixelFormat FORMAT>
+void colorizePaletteIndices(std::span<const uint8_t> indices, const PackedPalette& packedPalette, std::span<uint8_t> output);
+
+// raw data are little endian 16bit values
+template<PixelFormat FORMAT>
+void colorizeRaw14(std::span<const uint8_t> rawData, const Raw14Window& window, const PackedPalette& packedPalette, std::span<uint8_t> output);
+
+// values above 14 bits are clamped to the last lut entry
+template<PixelFormat FORMAT>
+void colorizeRaw14WithLut(std::span<const uint8_t> rawData, const Raw14Lut& lut, std::span<uint8_t> output);
+
+// single pass over frame - colorizes with given lut and returns min/max of the frame (e.g. for lut of next frame)
+template<PixelFormat FORMAT>
+std::pair<uint16_t, uint16_t> colorizeRaw14WithLutAndFindMinMax(std::span<const uint8_t> rawData, const Raw14Lut& lut, std::span<uint8_t> output);
+
+// data are pairs of pixels y0 u y1 v
+template<PixelFormat FORMAT>
+void convertYuyv422(std::span<const uint8_t> data, uint8_t alpha, std::span<uint8_t> output);
+
+} // namespace colorization
+
+} // namespace core
+
+#endif // CORE_COLORIZATIONKERNELS_H
@@ -0,0 +1,126 @@
+#ifndef CORE_FRAMESTATISTICS_H
+#define CORE_FRAMESTATISTICS_H
+
+#include "core/stream/imagedata.h"
+#include "core/misc/result.h"
+#include "core/device.h"
+
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+// statistics of raw 14bit frames - whole frame and any number of rois in one pass over frame
+// frame pass (parallel over row bands, one fused simd kernel per row) => min/max, sums, histogram and summed area tables => rois (parallel)
+class FrameStatistics final
+{
+public:
+    struct Settings
+    {
+        // percentiles 0 - 100, nearest rank
+        std::vector<float> percentiles {1.0f, 50.0f, 99.0f};
+        // min/max with locations and percentiles of rois need their pixels
+        // false => rectangle rois cost O(1) each from summed area tables (only pixelsCount, mean and stddev are valid)
+        bool detailedRoiStatistics {true};
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    struct Roi
+    {
+        unsigned column {0};
+        unsigned row {0};
+        unsigned width {0};
+        unsigned height {0};
+        // empty = whole rectangle, otherwise width * height values row by row (nonzero = pixel belongs to roi)
+        std::vector<uint8_t> mask;
+
+        bool operator==(const Roi&) const = default;
+    };
+
+    struct Location
+    {
+        unsigned row {0};
+        unsigned column {0};
+
+        bool operator==(const Location&) const = default;
+    };
+
+    struct Statistics
+    {
+        uint64_t pixelsCount {0};
+        uint16_t min {0};
+        uint16_t max {0};
+        // first occurrence in row by row order
+        Location minLocation;
+        Location maxLocation;
+        double mean {0.0};
+        double stddev {0.0};
+        // same order as Settings::percentiles
+        std::vector<uint16_t> percentiles;
+    };
+
+    FrameStatistics();
+    explicit FrameStatistics(const Settings& settings);
+
+    const Settings& getSettings() const;
+    void setSettings(const Settings& settings);
+
+    const std::vector<Roi>& getRois() const;
+    void setRois(const std::vector<Roi>& rois);
+
+    // raw data are little endian 16bit values, all rois must lie inside of frame
+    [[nodiscard]] VoidResult compute(std::span<const uint8_t> rawData, const core::Size& size);
+    [[nodiscard]] VoidResult compute(const ImageData& rawImageData, const core::Size& size);
+
+    const Statistics& getGlobalStatistics() const;
+    const std::vector<Statistics>& getRoiStatistics() const;
+
+    // histogram of whole frame, values above 14 bits are counted in last bin
+    const std::vector<uint32_t>& getHistogram() const;
+
+private:
+    struct Band
+    {
+        uint16_t min {0};
+        uint16_t max {0};
+        Location minLocation;
+        Location maxLocation;
+        uint64_t sum {0};
+        uint64_t squaresSum {0};
+    };
+
+    [[nodiscard]] VoidResult validateRois(const core::Size& size) const;
+
+    bool needsSummedAreaTables() const;
+
+    void computeBand(std::span<const uint8_t> rawData, size_t band, size_t bandsCount, bool withTables);
+    void fixSummedAreaTables(size_t bandsCount);
+    void computeGlobalStatistics(size_t pixelsCount);
+    // values - scratch buffer for detailed statistics (nullptr => sums only)
+    Statistics computeRoiStatistics(std::span<const uint8_t> rawData, const Roi& roi, std::vector<uint16_t>* values) const;
+
+    Settings m_settings;
+    std::vector<Roi> m_rois;
+
+    core::Size m_size {0, 0};
+
+    std::vector<Band> m_bands;
+    std::vector<std::vector<uint32_t>> m_partialHistograms;
+    std::vector<uint32_t> m_histogram;
+
+    // (height + 1) x (width + 1), first row and column are zeros
+    std::vector<uint64_t> m_sumTable;
+    std::vector<uint64_t> m_squaresSumTable;
+
+    Statistics m_globalStatistics;
+    std::vector<Statistics> m_roiStatistics;
+    // per roi pixels for detailed statistics, reused by next frames
+    std::vector<std::vector<uint16_t>> m_roiValues;
+};
+
+} // namespace core
+
+#endif // CORE_FRAMESTATISTICS_H
@@ -5,12 +5,16 @@
 #include "core/execution.h"
 
 #include "core/misc/palette.h"
+#include "core/misc/colorizationkernels.h"
 
 #include <cassert>
 #include <future>
+#include <memory>
+#include <span>
 #include <vector>
 #include <array>
 #include <optional>
+#include <type_traits>
 
 
 namespace wtilib
@@ -27,16 +31,58 @@ class ImageColorization final
 public:
     using PixelFormatConversionFunction = std::function<uint32_t(int, int, int, int)>;
 
+    template<colorization::PixelFormat FORMAT>
+    using ColorData = std::conditional_t<FORMAT == colorization::PixelFormat::RGB24, std::vector<uint8_t>, std::vector<uint32_t>>;
+
     /*!
      * @brief getColorData is used to get colorured data out of the stream, regardless of the settings it serves as a top-level call
      * @param palette - what color to colourize the stream with, if none is given and you need it for colorizing MONO14/MONO8 default grey palette will be used
      * @param imageData - ImageData to colourize
      * @param pixelFormat - either ARGB or GBRA from this file, or provide your own pixel format to give, the input is in order Red-Green-Blue-Alpha
+     *                      ARGB_PIXEL_FORMAT and BGRA_PIXEL_FORMAT are processed by vectorized kernels, custom functions are applied to palette colors
+     *                      (YUYV422: called per pixel with colors converted by vectorized kernel)
      * @param alpha - alpha part of the pixelFormat
      * @return std::vector<uint32_t>, uint32_t is in the format given
      */
     static std::future<std::vector<uint32_t>> getColorData(std::optional<core::Palette> palette, ImageData imageData, PixelFormatConversionFunction pixelFormat, int alpha);
 
+    /*!
+     * @brief getColorData with pixel format selected at compile time, colorization runs in vectorized kernels (AVX2/SSE4.1 if supported by cpu)
+     * @param palette - what color to colourize the stream with, default grey palette is used if none is given
+     * @param imageData - ImageData to colourize
+     * @param alpha - alpha part of the pixel, ignored for RGB24
+     * @return std::vector<uint32_t> for ARGB and BGRA, std::vector<uint8_t> with 3 bytes per pixel for RGB24
+     */
+    template<colorization::PixelFormat FORMAT>
+    static std::future<ColorData<FORMAT>> getColorData(std::optional<core::Palette> palette, ImageData imageData, uint8_t alpha);
+
+    /*!
+     * @brief getColorDataSize returns size in bytes of colorized data
+     * @param type - type of ImageData to colourize
+     * @param dataSize - size of ImageData::data
+     */
+    template<colorization::PixelFormat FORMAT>
+    static size_t getColorDataSize(ImageData::Type type, size_t dataSize);
+
+    /*!
+     * @brief colorize colourizes data into caller owned buffer (e.g. mapped texture or image memory) in calling thread, no allocation of result
+     * @param palette - what color to colourize the stream with, default grey palette is used if none is given
+     * @param type - type of data
+     * @param data - data of ImageData or Frame
+     * @param alpha - alpha part of the pixel, ignored for RGB24
+     * @param output - buffer of at least getColorDataSize bytes
+     */
+    template<colorization::PixelFormat FORMAT>
+    static void colorize(const std::optional<core::Palette>& palette, ImageData::Type type, std::span<const uint8_t> data, uint8_t alpha, std::span<uint8_t> output);
+
+    /*!
+     * @brief colorizeAsync same as colorize, but runs on persistent worker pool - no thread is created per frame
+     * @param imageData - shared frame data, kept alive until colorization is done
+     * @param output - buffer of at least getColorDataSize bytes, must stay valid until returned future is ready
+     */
+    template<colorization::PixelFormat FORMAT>
+    static std::future<void> colorizeAsync(const std::optional<core::Palette>& palette, std::shared_ptr<const ImageData> imageData, uint8_t alpha, std::span<uint8_t> output);
+
     static constexpr uint32_t ARGB_PIXEL_FORMAT(int r, int g, int b, int a)
     {
         return (a << 24) | ((r & 0xffu) << 16) | ((g & 0xffu) << 8) | (b & 0xffu);
@@ -0,0 +1,29 @@
+#ifndef CORE_INSTRUCTIONSET_H
+#define CORE_INSTRUCTIONSET_H
+
+
+namespace core
+{
+
+namespace simd
+{
+
+enum class InstructionSet
+{
+    SCALAR,
+    SSE41,
+    AVX2,
+};
+
+// best instruction set supported by cpu (and os)
+InstructionSet getSupportedInstructionSet();
+
+// instruction set used by all vectorized kernels - supported one by default, can be lowered (e.g. for comparison of implementations)
+InstructionSet getInstructionSet();
+void setInstructionSet(InstructionSet instructionSet);
+
+} // namespace simd
+
+} // namespace core
+
+#endif // CORE_INSTRUCTIONSET_H
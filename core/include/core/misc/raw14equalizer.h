@@ -0,0 +1,76 @@
+#ifndef CORE_RAW14EQUALIZER_H
+#define CORE_RAW14EQUALIZER_H
+
+#include "core/misc/colorizationkernels.h"
+#include "core/stream/imagedata.h"
+
+#include <vector>
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+// host side tone mapping of raw 14bit frames to palette indices (counterpart of on-board AGC)
+// histogram => tail rejection => plateau equalization blended with linear stretch => temporal smoothing of mapping
+class Raw14Equalizer final
+{
+public:
+    struct Settings
+    {
+        // histogram bins are clipped to (mean count of occupied bins) * clipLimit / 10, 1 - 100
+        unsigned clipLimit {20};
+        // percent of pixels ignored on each side of histogram, 0 - 49
+        unsigned tailRejection {1};
+        // 0 = pure plateau equalization, 1 = pure linear stretch between rejected tails
+        float linearWeight {0.2f};
+        // weight of previous mapping, 0 = no smoothing, < 1
+        float temporalSmoothing {0.8f};
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    Raw14Equalizer();
+    explicit Raw14Equalizer(const Settings& settings);
+
+    const Settings& getSettings() const;
+    void setSettings(const Settings& settings);
+
+    // next frame starts without temporal smoothing
+    void reset();
+
+    // mapping is recomputed from histogram of frame
+    void update(std::span<const uint8_t> rawData);
+
+    // raw data => palette indices using current mapping, output size is rawData.size() / 2
+    void mapToPaletteIndices(std::span<const uint8_t> rawData, std::span<uint8_t> output) const;
+
+    // update + mapToPaletteIndices
+    ImageData equalize(const ImageData& rawImageData);
+
+    // can be combined with palette by fillRaw14Lut => equalized colorization with single lookup per pixel
+    const Raw14PaletteIndicesLut& getPaletteIndicesLut() const;
+
+private:
+    void computeHistogram(std::span<const uint8_t> rawData);
+    void computeMapping(size_t pixelsCount);
+
+    Settings m_settings;
+
+    std::vector<std::vector<uint32_t>> m_partialHistograms;
+    std::vector<uint32_t> m_histogram;
+
+    std::vector<float> m_targetMapping;
+    std::vector<float> m_mapping;
+    bool m_hasMapping {false};
+
+    Raw14PaletteIndicesLut m_paletteIndicesLut {};
+};
+
+} // namespace colorization
+
+} // namespace core
+
+#endif // CORE_RAW14EQUALIZER_H
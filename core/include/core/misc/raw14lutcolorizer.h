@@ -0,0 +1,60 @@
+#ifndef CORE_RAW14LUTCOLORIZER_H
+#define CORE_RAW14LUTCOLORIZER_H
+
+#include "core/misc/colorizationkernels.h"
+
+#include <memory>
+#include <optional>
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+// raw 14bit frames => final packed pixels with single lookup per pixel
+// lut is rebuilt only when palette or alpha changes or normalization window moves more than threshold
+template<PixelFormat FORMAT>
+class Raw14LutColorizer final
+{
+public:
+    static constexpr uint16_t DEFAULT_WINDOW_THRESHOLD = 4;
+
+    explicit Raw14LutColorizer(const Palette& palette, uint8_t alpha = 255, uint16_t windowThreshold = DEFAULT_WINDOW_THRESHOLD);
+
+    void setPalette(const Palette& palette, uint8_t alpha);
+
+    uint16_t getWindowThreshold() const;
+    void setWindowThreshold(uint16_t windowThreshold);
+
+    // window from min/max of frame
+    void colorize(std::span<const uint8_t> rawData, std::span<uint8_t> output);
+    // window given by caller (e.g. from previous frame or user settings)
+    void colorize(std::span<const uint8_t> rawData, uint16_t min, uint16_t max, std::span<uint8_t> output);
+    // temporal agc - single pass, frame is colorized with window of previous frame while its own min/max is found for the next one
+    // first frame (or frame after palette change) is scanned for min/max first
+    void colorizeWithPreviousWindow(std::span<const uint8_t> rawData, std::span<uint8_t> output);
+
+    // window the current lut was built for
+    const Raw14Window& getWindow() const;
+    size_t getLutRebuildsCount() const;
+
+private:
+    void updateLut(uint16_t min, uint16_t max);
+
+    uint8_t m_alpha {255};
+    uint16_t m_windowThreshold {DEFAULT_WINDOW_THRESHOLD};
+    PackedPalette m_packedPalette;
+
+    std::unique_ptr<Raw14Lut> m_lut;
+    std::optional<std::pair<uint16_t, uint16_t>> m_lutMinMax;
+    Raw14Window m_window;
+    size_t m_lutRebuildsCount {0};
+};
+
+} // namespace colorization
+
+} // namespace core
+
+#endif // CORE_RAW14LUTCOLORIZER_H
@@ -0,0 +1,51 @@
+#ifndef CORE_SIMDTARGET_H
+#define CORE_SIMDTARGET_H
+
+// internal - included only by sources of vectorized kernels, not by public headers
+// kernels are compiled for SSE4.1/AVX2 regardless of compiler flags, implementation is selected at runtime by simd::getInstructionSet()
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CORE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// msvc allows intrinsics in any function, gcc and clang need target attribute
+#if defined(__GNUC__) || defined(__clang__)
+#define CORE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CORE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CORE_TARGET_SSE41
+#define CORE_TARGET_AVX2
+#endif
+
+#if defined(CORE_SIMD_X86)
+
+#include <cstddef>
+#include <cstdint>
+
+namespace core
+{
+
+namespace simd
+{
+
+// 8 little endian 16bit raw pixels widened to 32bit lanes
+CORE_TARGET_AVX2 inline __m256i loadRaw16x8(const uint8_t* rawData)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rawData)));
+}
+
+// 32bit lanes saturated to 8 16bit raw pixels - pack works within 128bit lanes, both halves are moved to low lane
+CORE_TARGET_AVX2 inline void storeRaw16x8(uint8_t* rawData, __m256i values)
+{
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(values, values), 0b1000);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rawData), _mm256_castsi256_si128(packed));
+}
+
+} // namespace simd
+
+} // namespace core
+
+#endif // CORE_SIMD_X86
+
+#endif // CORE_SIMDTARGET_H
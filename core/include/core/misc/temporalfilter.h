@@ -0,0 +1,91 @@
+#ifndef CORE_TEMPORALFILTER_H
+#define CORE_TEMPORALFILTER_H
+
+#include "core/misc/alignedallocator.h"
+#include "core/misc/result.h"
+#include "core/stream/frame.h"
+#include "core/stream/imagedata.h"
+
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+// host side temporal averaging of raw 16bit frames (counterpart of on-board time domain average)
+// frames are added one by one (StreamHub::Subscriber::readFiltered, captureFrames callback ...), average can be read any time
+// buffers are allocated by first frame after reset and reused
+class TemporalFilter final
+{
+public:
+    enum class Mode
+    {
+        // mean of last windowSize frames (of all frames since reset until window is full)
+        RUNNING_MEAN,
+        // average += (frame - average) / 2^smoothingShift
+        EXPONENTIAL,
+        // exponential, pixel differing from its average by more than motionThreshold restarts from current value
+        MOTION_GATED,
+    };
+
+    struct Settings
+    {
+        Mode mode {Mode::RUNNING_MEAN};
+        // 1 - MAX_WINDOW_SIZE
+        unsigned windowSize {8};
+        // 1 - MAX_SMOOTHING_SHIFT
+        unsigned smoothingShift {3};
+        uint16_t motionThreshold {100};
+
+        bool operator==(const Settings&) const = default;
+    };
+
+    // window of raw frames is kept in memory - 64 frames of 640x480 take 37.5 MiB
+    static constexpr unsigned MAX_WINDOW_SIZE = 64;
+    static constexpr unsigned MAX_SMOOTHING_SHIFT = 8;
+
+    TemporalFilter();
+    explicit TemporalFilter(const Settings& settings);
+
+    const Settings& getSettings() const;
+    // resets filter when settings change, settings out of range are refused
+    [[nodiscard]] VoidResult setSettings(const Settings& settings);
+
+    void reset();
+
+    // frames in current average (running mean) or frames since reset
+    size_t getFramesCount() const;
+
+    // raw data are little endian 16bit values, frame size must not change until reset
+    [[nodiscard]] VoidResult addFrame(std::span<const uint8_t> rawData);
+    [[nodiscard]] VoidResult addFrame(std::span<const uint16_t> frame);
+
+    // average rounded to nearest, output size must be size of added frames
+    [[nodiscard]] VoidResult getAverage(std::span<uint8_t> rawOutput) const;
+    [[nodiscard]] VoidResult getAverage(std::span<uint16_t> output) const;
+
+    // addFrame + getAverage into output with metadata of added frame, capacity of output is reused
+    [[nodiscard]] VoidResult filter(const ImageData& rawImageData, ImageData& output);
+    [[nodiscard]] VoidResult filter(const Frame& rawFrame, ImageData& output);
+
+private:
+    [[nodiscard]] VoidResult filter(ImageData::Type type, std::span<const uint8_t> rawData, const FrameMetadata& metadata, ImageData& output);
+
+    Settings m_settings;
+
+    size_t m_pixelsCount {0};
+    size_t m_framesCount {0};
+
+    // RUNNING_MEAN - sums of window and ring of raw frames in window
+    AlignedVector<uint32_t> m_sums;
+    std::vector<uint8_t> m_window;
+    size_t m_windowPosition {0};
+
+    // EXPONENTIAL, MOTION_GATED - averages in 17.15 fixed point
+    AlignedVector<int32_t> m_averages;
+};
+
+} // namespace core
+
+#endif // CORE_TEMPORALFILTER_H
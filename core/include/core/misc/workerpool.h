@@ -0,0 +1,37 @@
+#ifndef CORE_WORKERPOOL_H
+#define CORE_WORKERPOOL_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+
+namespace core
+{
+
+namespace workerpool
+{
+
+// few persistent threads shared by background work (colorization, decoding, processing of captured frames) => no thread created per task
+// task may wait for another worker pool task only if it is the only waiting task at the time (pool has 2 threads)
+void post(std::function<void ()> function);
+
+// replaces std::async
+template<typename Function>
+auto run(Function&& function)
+{
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Function>()>>(std::forward<Function>(function));
+    auto future = task->get_future();
+    post([task]()
+    {
+        (*task)();
+    });
+    return future;
+}
+
+} // namespace workerpool
+
+} // namespace core
+
+#endif // CORE_WORKERPOOL_H
@@ -2,6 +2,8 @@
 #define CORE_PROPERTIES_H
 
 #include "core/properties/propertyid.h"
+#include "core/properties/propertiessnapshot.h"
+#include "core/properties/propertiescache.h"
 #include "core/properties/propertyadapterbase.h"
 #include "core/properties/transactionsummary.h"
 #include "core/properties/itaskmanager.h"
@@ -22,6 +24,8 @@ namespace connection
 {
 class IDataLinkInterface;
 class IDeviceInterface;
+class DeviceInterfacePrefetched;
+class DeviceInterfaceWriteCombining;
 }
 class ProgressNotifier;
 class ProgressController;
@@ -86,6 +90,13 @@ public:
 
     const std::optional<DeviceType>& getCurrentDeviceType(const PropertiesTransaction& transaction) const;
 
+    // lock-free access to values published after last finished transaction - does not need (and does not wait for) any transaction
+    std::shared_ptr<const PropertiesSnapshot> getSnapshot() const;
+
+    // raw data of cacheable (non-volatile) properties, used (once) instead of device reads on next connect to device with same cache key
+    [[nodiscard]] ValueResult<PropertiesCache> createPropertiesCache(const ConnectionExclusiveTransaction& transaction);
+    void setPropertiesCache(const std::shared_ptr<const PropertiesCache>& propertiesCache, const PropertiesTransaction& transaction);
+
     const std::vector<PropertyId>& getPropertiesToTouchAfterConnect(const PropertiesTransaction& transaction);
     void setPropertiesToTouchAfterConnect(const std::vector<PropertyId>& propertiesToTouchAfterConnect, const PropertiesTransaction& transaction);
 
@@ -102,6 +113,11 @@ protected:
     virtual void onCurrentDeviceTypeChanged();
     virtual void onTransactionFinished(const TransactionSummary& transactionSummary);
 
+    // properties cache is disabled by default
+    virtual bool isPropertyCacheable(PropertyId propertyId) const;
+    // identification of connected device and state of cached ranges (serial number, firmware version, checksum of cached data...) - cache is used only for device with same key
+    [[nodiscard]] virtual ValueResult<std::string> readPropertiesCacheDeviceKey(connection::IDeviceInterface* device, const connection::AddressRanges& cachedRanges);
+
     const std::optional<DeviceType>& getDeviceType() const;
 
     const std::shared_ptr<PropertyValues>& getPropertyValues() const;
@@ -131,6 +147,19 @@ private:
     void unmapAdapterAddressRanges(const std::shared_ptr<PropertyAdapterBase>& adapter);
     void setCurrentDeviceType(const std::optional<DeviceType>& deviceType, const PropertyValues::Transaction& transaction);
     void invalidateProperties(const connection::AddressRanges& addressRanges);
+    void publishSnapshot(const PropertyValues::Transaction& valuesTransaction, const std::set<PropertyId>& propertiesChanged);
+
+    // SYNC_DIRECT only - reads ranges of touched readable properties without value in maximal contiguous blocks, then touches properties (their read tasks are served from prefetched data)
+    // data of matching propertiesCache are used instead of reading cacheable ranges
+    template<class PropertyIdContainer>
+    void touchPropertiesWithPrefetch(const PropertyIdContainer& properties, const PropertiesTransaction& transaction,
+                                     const std::shared_ptr<const PropertiesCache>& propertiesCache);
+    template<class PropertyIdContainer>
+    std::vector<connection::AddressRange> getPrefetchAddressRanges(const PropertyIdContainer& properties, const PropertyValues::Transaction& valuesTransaction,
+                                                                   const std::function<bool (PropertyId)>& filter) const;
+    connection::AddressRanges getPacketSavingBlocks(const std::vector<connection::AddressRange>& ranges) const;
+    [[nodiscard]] ValueResult<std::string> readPropertiesCacheKey(const connection::AddressRanges& cachedRanges);
+    connection::IDeviceInterface* getTaskDevice();
 
     Mode getMode(const ITaskManager* taskManager) const;
     [[nodiscard]] VoidResult setNonexclusiveMode(Mode mode);
@@ -159,6 +188,16 @@ private:
     std::vector<PropertyId> m_propertiesToTouchAfterConnect;
 
     std::map<DeviceType, connection::AddressRangeMap<PropertyId>> m_adapterAddressRangeMaps;
+
+    // larger ranges (flash data, palettes...) are left to their own tasks
+    static constexpr uint32_t MAX_PREFETCHED_RANGE_SIZE = 1024;
+    std::shared_ptr<connection::DeviceInterfacePrefetched> m_prefetchedDeviceInterface;
+    std::shared_ptr<connection::DeviceInterfaceWriteCombining> m_writeCombiningDeviceInterface;
+    std::vector<std::pair<PropertyId, VoidResult>> m_writesFinishedBeforeFlush;
+    std::shared_ptr<const PropertiesCache> m_propertiesCache;
+
+    // accessed only by std::atomic_load / std::atomic_store
+    std::shared_ptr<const PropertiesSnapshot> m_snapshot;
 };
 
 
@@ -227,6 +266,11 @@ public:
     template<class ValueType>
     [[nodiscard]] VoidResult setValue(PropertyId propertyId, const ValueType& newValue) const;
 
+    // writes set of values (std::any must hold value of getPropertyTypeInfo()) - nothing is written unless whole set passes validation
+    // dependency validators are evaluated once against all new values, writes are issued in address order and dependent properties touched once at the end
+    // SYNC_DIRECT: adjacent writes are coalesced into contiguous blocks - properties whose write failed are reset
+    [[nodiscard]] VoidResult applyValues(const std::map<PropertyId, std::any>& values) const;
+
     [[nodiscard]] VoidResult getLastWriteResult(PropertyId propertyId) const;
 
     template<class T>
@@ -241,6 +285,11 @@ public:
     [[nodiscard]] std::future<ValueResult<std::vector<T>>> readDataWithProgress(uint32_t address, size_t dataCount,
                                                                                 ProgressTask progressTask) const;
 
+    // reads directly into caller's buffer - it must stay valid until returned future is ready
+    template<class T>
+    [[nodiscard]] std::future<VoidResult> readDataToBufferWithProgress(std::span<T> data, uint32_t address,
+                                                                       ProgressTask progressTask) const;
+
     template<class T>
     [[nodiscard]] std::future<VoidResult> writeDataWithProgress(std::span<const T> data, uint32_t address,
                                                                 const std::string& taskName, const std::string& errorMessage) const;
@@ -280,6 +329,10 @@ public:
     template<class T>
     [[nodiscard]] ValueResult<std::vector<T>> readDataWithProgress(uint32_t address, size_t dataCount, ProgressTask progressTask) const;
 
+    // reads into caller buffer, no allocation
+    template<class T>
+    [[nodiscard]] VoidResult readDataToBufferWithProgress(std::span<T> data, uint32_t address, ProgressTask progressTask) const;
+
     template<class T>
     [[nodiscard]] VoidResult writeDataWithProgress(std::span<const T> data, uint32_t address, ProgressTask progressTask) const;
 
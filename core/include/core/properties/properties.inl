@@ -64,6 +64,21 @@ template<class T>
     }
 }
 
+template<class T>
+[[nodiscard]] VoidResult Properties::ConnectionExclusiveTransaction::readDataToBufferWithProgress(std::span<T> data, uint32_t address, ProgressTask progressTask) const
+{
+    auto resultFuture = getPropertiesTransaction().readDataToBufferWithProgress<T>(data, address, progressTask);
+
+    try
+    {
+        return resultFuture.get();
+    }
+    catch (...)
+    {
+        return VoidResult::createError("Reading interrupted", "task terminated");
+    }
+}
+
 template<class T>
 [[nodiscard]] VoidResult Properties::ConnectionExclusiveTransaction::writeDataWithProgress(std::span<const T> data, uint32_t address, ProgressTask progressTask) const
 {
@@ -264,6 +279,25 @@ std::future<ValueResult<std::vector<T>>> Properties::PropertiesTransaction::read
     return result;
 }
 
+template<class T>
+std::future<VoidResult> Properties::PropertiesTransaction::readDataToBufferWithProgress(std::span<T> data, uint32_t address,
+                                                                                        ProgressTask progressTask) const
+{
+    auto promise = std::make_shared<std::promise<VoidResult>>();
+    auto result = promise->get_future();
+
+    const auto addressRange = connection::AddressRange::firstAndSize(address, data.size() * sizeof(T));
+    getProperties()->getTaskManager()->addTaskWithProgress(addressRange, ITaskManager::TaskType::READ_WILD, [=, properties = getProperties()](ProgressController progressController) // capture properties shared_ptr to keep properties alive till task ends
+    {
+        const auto result = properties->getTaskManager()->getDevice()->readTypedData<T>(data, address, progressTask);
+        promise->set_value(result);
+
+        return result;
+    });
+
+    return result;
+}
+
 template<class T>
 std::future<VoidResult> Properties::PropertiesTransaction::writeDataWithProgress(std::span<const T> data, uint32_t address,
                                                                                  const std::string& taskName, const std::string& errorMessage) const
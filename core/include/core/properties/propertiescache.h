@@ -0,0 +1,39 @@
+#ifndef CORE_PROPERTIESCACHE_H
+#define CORE_PROPERTIESCACHE_H
+
+#include "core/connection/addressrange.h"
+#include "core/misc/result.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace core
+{
+
+// raw device data of non-volatile properties - restored on connect instead of reading from device, if key (device identification and checksum of cached data) matches
+class PropertiesCache final
+{
+public:
+    using Blocks = std::map<connection::AddressRange, std::vector<uint8_t>>;
+
+    explicit PropertiesCache(const std::string& key, const Blocks& blocks);
+
+    const std::string& getKey() const;
+    const Blocks& getBlocks() const;
+
+    [[nodiscard]] VoidResult saveToFile(const std::string& filename) const;
+    [[nodiscard]] static ValueResult<PropertiesCache> loadFromFile(const std::string& filename);
+
+private:
+    static constexpr uint32_t FILE_MAGIC = 0x43505757; // "WWPC"
+    static constexpr uint32_t FILE_FORMAT_VERSION = 1;
+
+    std::string m_key;
+    Blocks m_blocks;
+};
+
+} // namespace core
+
+#endif // CORE_PROPERTIESCACHE_H
@@ -0,0 +1,75 @@
+#ifndef CORE_PROPERTIESSNAPSHOT_H
+#define CORE_PROPERTIESSNAPSHOT_H
+
+#include "core/properties/propertyid.h"
+#include "core/misc/result.h"
+
+#include <any>
+#include <map>
+#include <memory>
+#include <set>
+
+
+namespace core
+{
+
+class PropertyValueBase;
+
+// immutable copy of property values, published by Properties after each finished transaction - may be read from any thread without transaction
+class PropertiesSnapshot
+{
+public:
+    explicit PropertiesSnapshot();
+
+    struct Entry
+    {
+        std::any value;
+        std::string valueAsString;
+        bool hasValueResult {false};
+    };
+
+    // creates new version - entries of propertiesChanged (and of properties missing in previous snapshot) are taken from values
+    [[nodiscard]] static std::shared_ptr<const PropertiesSnapshot> createNextVersion(const std::shared_ptr<const PropertiesSnapshot>& previous,
+                                                                                     const std::map<PropertyId, const PropertyValueBase*>& values,
+                                                                                     const std::set<PropertyId>& propertiesChanged);
+
+    uint64_t getVersion() const;
+
+    std::set<PropertyId> getPropertyIds() const;
+
+    [[nodiscard]] bool hasProperty(PropertyId propertyId) const;
+    [[nodiscard]] bool hasValueResult(PropertyId propertyId) const;
+    [[nodiscard]] std::string getValueAsString(PropertyId propertyId) const;
+
+    template<class ValueType>
+    [[nodiscard]] OptionalResult<ValueType> getValue(PropertyId propertyId) const;
+
+private:
+    const Entry* getEntry(PropertyId propertyId) const;
+
+    uint64_t m_version {0};
+
+    std::map<PropertyId, std::shared_ptr<const Entry>> m_entries;
+};
+
+// Impl
+
+template<class ValueType>
+OptionalResult<ValueType> PropertiesSnapshot::getValue(PropertyId propertyId) const
+{
+    if (const auto* entry = getEntry(propertyId))
+    {
+        if (const auto* value = std::any_cast<OptionalResult<ValueType>>(&entry->value))
+        {
+            return *value;
+        }
+
+        assert(false && "PropertyValue for different data type!");
+    }
+
+    return std::nullopt;
+}
+
+} // namespace core
+
+#endif // CORE_PROPERTIESSNAPSHOT_H
@@ -49,6 +49,7 @@ public:
 
     void addDependencyValidator(const std::shared_ptr<PropertyDependencyValidator>& validator);
     std::vector<RankedValidationResult> getValueDependencyValidationResults() const;
+    const std::vector<std::shared_ptr<PropertyDependencyValidator>>& getDependencyValidators() const;
     const std::set<PropertyId>& getValidationDependencyPropertyIds() const;
 
     virtual void touch(const PropertyValues::Transaction& transaction) = 0;
@@ -57,6 +58,16 @@ public:
     virtual VoidResult setValueAccording(PropertyAdapterBase* sourceAdapter, const PropertyValues::Transaction& transaction) = 0;
     virtual RankedValidationResult validateSourcePropertyValueForWrite(PropertyId sourcePropertyId, const PropertyValues::Transaction& transaction) const = 0;
     virtual VoidResult getLastWriteResult() const = 0;
+    // write combining - write reported as successful by adapter failed later, when combined data were flushed
+    virtual void setLastWriteResult(const VoidResult& writeResult);
+
+    // type erased write - value must be of type getTypeInfo()
+    virtual RankedValidationResult validateAnyValueForWrite(const std::any& value, const PropertyValues::Transaction& transaction) const = 0;
+    virtual VoidResult setAnyValue(const std::any& value, const PropertyValues::Transaction& transaction) = 0;
+
+    // used by bulk write - dependency validators are evaluated once for whole set of values and dependent properties touched afterwards
+    void setDependencyValidationSuppressed(bool suppressed);
+    bool isDependencyValidationSuppressed() const;
 
     virtual connection::AddressRanges getAddressRanges() const;
     virtual std::set<PropertyId> getSourcePropertyIds() const;
@@ -72,9 +83,6 @@ public:
     boost::signals2::signal<void(size_t, const std::string&, const std::string&)> valueWriteFinished;
     boost::signals2::signal<void(size_t)> touchDependentProperty;
 
-protected:
-    const std::vector<std::shared_ptr<PropertyDependencyValidator>>& getDependencyValidators() const;
-
 private:
     virtual void setStatus(Status status, const PropertyValues::Transaction& transaction);
 
@@ -89,6 +97,7 @@ private:
     std::vector<std::shared_ptr<PropertyDependencyValidator>> m_dependencyValidators;
     std::set<PropertyId> m_validationDependencyPropertyIds;
     std::set<PropertyId> m_subsidiaryAdaptersPropertyIds;
+    bool m_dependencyValidationSuppressed {false};
     boost::signals2::scoped_connection m_valueChangedConnection;
 };
 
@@ -27,6 +27,8 @@ public:
     virtual void invalidateValue(const PropertyValues::Transaction& transaction) override;
     virtual VoidResult setValueAccording(PropertyAdapterBase* sourceAdapter, const PropertyValues::Transaction& transaction) override;
     virtual RankedValidationResult validateSourcePropertyValueForWrite(PropertyId sourcePropertyId, const PropertyValues::Transaction& transaction) const override;
+    virtual RankedValidationResult validateAnyValueForWrite(const std::any& value, const PropertyValues::Transaction& transaction) const override;
+    virtual VoidResult setAnyValue(const std::any& value, const PropertyValues::Transaction& transaction) override;
 
     static bool isRecoverableError(const OptionalResult<ValueType>& result);
 
@@ -62,6 +64,11 @@ RankedValidationResult PropertyAdapterValue<ValueType>::validateValueForWrite(co
         return RankedValidationResult::createError(result);
     }
 
+    if (this->isDependencyValidationSuppressed())
+    {
+        return RankedValidationResult::createOk();
+    }
+
     this->touchDependentProperties(transaction);
 
     std::optional<RankedValidationResult> warning;
@@ -104,6 +111,28 @@ RankedValidationResult PropertyAdapterValue<ValueType>::validateSourcePropertyVa
     return validateValueForWrite(value.getValue(), transaction);
 }
 
+template<class ValueType>
+RankedValidationResult PropertyAdapterValue<ValueType>::validateAnyValueForWrite(const std::any& value, const PropertyValues::Transaction& transaction) const
+{
+    if (const auto* typedValue = std::any_cast<ValueType>(&value))
+    {
+        return validateValueForWrite(*typedValue, transaction);
+    }
+
+    return RankedValidationResult::createError("Invalid value!", utils::format("property: {} invalid value type", getPropertyId().getIdString()));
+}
+
+template<class ValueType>
+VoidResult PropertyAdapterValue<ValueType>::setAnyValue(const std::any& value, const PropertyValues::Transaction& transaction)
+{
+    if (const auto* typedValue = std::any_cast<ValueType>(&value))
+    {
+        return setValue(*typedValue, transaction);
+    }
+
+    return VoidResult::createError("Unable to set value!", utils::format("property: {} invalid value type", getPropertyId().getIdString()));
+}
+
 template<class ValueType>
 void PropertyAdapterValue<ValueType>::touch(const PropertyValues::Transaction& transaction)
 {
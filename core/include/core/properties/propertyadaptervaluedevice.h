@@ -26,8 +26,12 @@ public:
     virtual void refreshValue(const PropertyValues::Transaction& transaction) override;
     virtual VoidResult setValue(const ValueType& newValue, const PropertyValues::Transaction& transaction) override;
     virtual VoidResult getLastWriteResult() const override;
+    virtual void setLastWriteResult(const VoidResult& writeResult) override;
     virtual connection::AddressRanges getAddressRanges() const override;
 
+    // setValue validates transformed value - so does bulk write
+    virtual RankedValidationResult validateAnyValueForWrite(const std::any& value, const PropertyValues::Transaction& transaction) const override;
+
     void setAlwaysRereadValueAfterWrite(bool alwaysRereadValueAfterWrite);
 
 protected:
@@ -127,6 +131,24 @@ VoidResult PropertyAdapterValueDevice<ValueType>::getLastWriteResult() const
     return m_lastWriteResult;
 }
 
+template<class ValueType>
+void PropertyAdapterValueDevice<ValueType>::setLastWriteResult(const VoidResult& writeResult)
+{
+    m_lastWriteResult = writeResult;
+}
+
+template<class ValueType>
+RankedValidationResult PropertyAdapterValueDevice<ValueType>::validateAnyValueForWrite(const std::any& value, const PropertyValues::Transaction& transaction) const
+{
+    const auto* typedValue = std::any_cast<ValueType>(&value);
+    if (typedValue == nullptr || !m_transformFunction)
+    {
+        return BaseClass::validateAnyValueForWrite(value, transaction);
+    }
+
+    return this->validateValueForWrite(m_transformFunction(*typedValue, transaction), transaction);
+}
+
 template<class ValueType>
 void PropertyAdapterValueDevice<ValueType>::setAlwaysRereadValueAfterWrite(bool alwaysRereadValueAfterWrite)
 {
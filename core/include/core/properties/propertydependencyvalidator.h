@@ -6,6 +6,7 @@
 
 
 #include <any>
+#include <map>
 
 
 namespace core
@@ -24,12 +25,15 @@ public:
 
     template<class ValueType>
     RankedValidationResult validateWhatIf(PropertyId propertyId, const ValueType& value, PropertyValues::Transaction transaction);
+    // values not contained in map are taken from transaction
+    RankedValidationResult validateWhatIf(const std::map<PropertyId, std::any>& values, PropertyValues::Transaction transaction);
 
     boost::signals2::signal<void(size_t)> validityChanged;
 
 protected:
     [[nodiscard]] virtual RankedValidationResult validateImpl(PropertyValues::Transaction transaction) = 0;
     [[nodiscard]] virtual RankedValidationResult validateWhatIfImpl(PropertyId propertyId, const std::any& value, PropertyValues::Transaction transaction) = 0;
+    [[nodiscard]] virtual RankedValidationResult validateWhatIfImpl(const std::map<PropertyId, std::any>& values, PropertyValues::Transaction transaction) = 0;
 
 private:
     void setValidationResult(const RankedValidationResult& result);
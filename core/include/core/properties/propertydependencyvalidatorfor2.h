@@ -21,6 +21,7 @@ public:
 protected:
     [[nodiscard]] virtual RankedValidationResult validateImpl(PropertyValues::Transaction transaction) override;
     [[nodiscard]] virtual RankedValidationResult validateWhatIfImpl(PropertyId propertyId, const std::any& value, PropertyValues::Transaction transaction) override;
+    [[nodiscard]] virtual RankedValidationResult validateWhatIfImpl(const std::map<PropertyId, std::any>& values, PropertyValues::Transaction transaction) override;
 
 private:
     PropertyId m_propertyId1;
@@ -86,6 +87,32 @@ RankedValidationResult PropertyDependencyValidatorFor2<ValueType1, ValueType2>::
     return m_dependencyValidationFunction(value1, value2);
 }
 
+template<class ValueType1, class ValueType2>
+RankedValidationResult PropertyDependencyValidatorFor2<ValueType1, ValueType2>::validateWhatIfImpl(const std::map<PropertyId, std::any>& values, PropertyValues::Transaction transaction)
+{
+    auto value1 = transaction.getValue<ValueType1>(m_propertyId1);
+    auto value2 = transaction.getValue<ValueType2>(m_propertyId2);
+
+    try
+    {
+        if (const auto it = values.find(m_propertyId1); it != values.end())
+        {
+            value1 = std::any_cast<ValueType1>(it->second);
+        }
+        if (const auto it = values.find(m_propertyId2); it != values.end())
+        {
+            value2 = std::any_cast<ValueType2>(it->second);
+        }
+    }
+    catch (const std::bad_any_cast& e)
+    {
+        assert(false && "Invalid property type!");
+        return RankedValidationResult::createError("Validation error!", utils::format("invalid property type: {}", e.what()));
+    }
+
+    return m_dependencyValidationFunction(value1, value2);
+}
+
 } // namespace core
 
 #endif // CORE_PROPERTYDEPENDENCYVALIDATORFOR2_H
@@ -5,6 +5,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace core
 {
@@ -24,23 +25,16 @@ public:
     static PropertyId createPropertyId(const std::string& idString, const std::string& info);
 
     static std::optional<PropertyId> getPropertyIdByInternalId(size_t internalId);
-    static std::optional<PropertyId> getPropertyIdByIdString(const std::string& idString);
+    static std::optional<PropertyId> getPropertyIdByIdString(std::string_view idString);
 
     static const std::vector<PropertyId>& getAllPropertyIds();
 
 private:
     size_t m_internalId {0};
 
-    struct PropertyData
-    {
-        std::string idString;
-        std::string info;
-    };
-
-    static std::vector<PropertyId> m_allPropertyIds;
-
-    static std::map<size_t, PropertyData> m_internalIdToData;
-    static std::map<std::string, size_t> m_idStringToInternalId;
+    // internal ids are assigned sequentially => registry is indexed directly by internal id, id strings are in open addressing hash table
+    class Registry;
+    static Registry& getRegistry();
 };
 
 } // namespace core
@@ -23,6 +23,7 @@ public:
     virtual bool hasValueResult() const override;
     virtual VoidResult getValidationResult() const override;
     virtual std::string getValueAsString() const override;
+    virtual std::any getValueAsAny() const override;
     virtual bool valueEquals(const PropertyValueBase* other) const override;
 
     virtual std::string convertToString(const OptionalResult<ValueType>& value) const;
@@ -78,6 +79,12 @@ std::string PropertyValue<ValueType>::getValueAsString() const
     return convertToString(getCurrentValue());
 }
 
+template<class ValueType>
+std::any PropertyValue<ValueType>::getValueAsAny() const
+{
+    return std::any(getCurrentValue());
+}
+
 template<class ValueType>
 bool PropertyValue<ValueType>::valueEquals(const PropertyValueBase* other) const
 {
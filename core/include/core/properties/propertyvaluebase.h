@@ -5,6 +5,7 @@
 #include "core/misc/result.h"
 
 #include <boost/signals2.hpp>
+#include <any>
 
 
 namespace core
@@ -23,6 +24,8 @@ public:
     virtual bool hasValueResult() const = 0;
     virtual VoidResult getValidationResult() const = 0;
     virtual std::string getValueAsString() const = 0;
+    // returns copy of current OptionalResult<ValueType>
+    virtual std::any getValueAsAny() const = 0;
 
     virtual bool valueEquals(const PropertyValueBase* other) const = 0;
 
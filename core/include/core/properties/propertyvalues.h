@@ -80,6 +80,7 @@ public:
     void setValue(PropertyId propertyId, const OptionalResult<ValueType>& newValue) const;
 
     PropertyValueBase* getPropertyValue(PropertyId propertyId) const;
+    std::map<PropertyId, const PropertyValueBase*> getAllPropertyValues() const;
 
 private:
     std::shared_ptr<TransactionData> m_transactionData;
@@ -0,0 +1,61 @@
+#ifndef CORE_FRAME_H
+#define CORE_FRAME_H
+
+#include "core/stream/imagedata.h"
+
+#include <memory>
+#include <span>
+
+
+namespace core
+{
+
+// owner of frame memory (buffer pool, driver pipeline...) - frame gives its handle back on release
+class IFrameBufferOwner
+{
+public:
+    virtual ~IFrameBufferOwner() {}
+
+    virtual void releaseFrameBuffer(void* handle) = 0;
+};
+
+// move only view of image data - memory is either borrowed from driver or recycled from FrameBufferPool, never copied
+// frame should be released promptly - driver has only a few buffers and stops filling them when all are borrowed
+class Frame final
+{
+public:
+    Frame() = default;
+    ~Frame();
+
+    Frame(Frame&& other) noexcept;
+    Frame& operator=(Frame&& other) noexcept;
+
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+
+    ImageData::Type getType() const;
+    std::span<const uint8_t> getData() const;
+    bool isEmpty() const;
+
+    const FrameMetadata& getMetadata() const;
+    void setMetadata(const FrameMetadata& metadata);
+
+    // previous data (and metadata) are released, handle is given back to owner when frame is reset or destroyed
+    void assign(ImageData::Type type, std::span<const uint8_t> data, const std::shared_ptr<IFrameBufferOwner>& owner, void* handle);
+    void reset();
+
+    // reuses capacity of imageData
+    void copyTo(ImageData& imageData) const;
+
+private:
+    ImageData::Type m_type {ImageData::Type::Raw14Bit};
+    std::span<const uint8_t> m_data;
+    FrameMetadata m_metadata;
+
+    std::shared_ptr<IFrameBufferOwner> m_owner;
+    void* m_handle {nullptr};
+};
+
+} // namespace core
+
+#endif // CORE_FRAME_H
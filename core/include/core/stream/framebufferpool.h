@@ -0,0 +1,39 @@
+#ifndef CORE_FRAMEBUFFERPOOL_H
+#define CORE_FRAMEBUFFERPOOL_H
+
+#include "core/stream/frame.h"
+
+#include <mutex>
+#include <vector>
+
+
+namespace core
+{
+
+// preallocated frame buffers recycled after frame release - no allocation in steady state
+class FrameBufferPool final : public IFrameBufferOwner, public std::enable_shared_from_this<FrameBufferPool>
+{
+    explicit FrameBufferPool(size_t buffersCount, size_t bufferSize);
+
+public:
+    static std::shared_ptr<FrameBufferPool> createInstance(size_t buffersCount, size_t bufferSize);
+
+    // previous frame data are released first, pool grows when all buffers are in use
+    std::span<uint8_t> acquire(Frame& frame, ImageData::Type type, size_t size);
+
+    size_t getBuffersCount() const;
+    size_t getFreeBuffersCount() const;
+
+    virtual void releaseFrameBuffer(void* handle) override;
+
+private:
+    size_t m_bufferSize {0};
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<std::vector<uint8_t>>> m_buffers;
+    std::vector<std::vector<uint8_t>*> m_freeBuffers;
+};
+
+} // namespace core
+
+#endif // CORE_FRAMEBUFFERPOOL_H
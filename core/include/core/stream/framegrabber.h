@@ -0,0 +1,166 @@
+#ifndef CORE_FRAMEGRABBER_H
+#define CORE_FRAMEGRABBER_H
+
+#include "core/stream/istream.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace core
+{
+
+// reads stream on its own thread into single producer / multi consumer ring of frames
+// every consumer reads all frames at its own pace, frames are shared (not copied) by consumers
+class FrameGrabber final : public std::enable_shared_from_this<FrameGrabber>
+{
+    struct Slot;
+    struct ConsumerCursor;
+
+public:
+    enum class OverflowPolicy
+    {
+        OVERWRITE_OLDEST, // slow consumer skips oldest frames (it reads at most half of ring behind grabber), grabber never waits - slots pinned by consumers are skipped
+        BACKPRESSURE,     // grabber waits for slowest consumer, frames are dropped by driver meanwhile
+    };
+
+    struct Statistics
+    {
+        uint64_t framesGrabbed {0};
+        uint64_t framesDropped {0}; // OVERWRITE_OLDEST only - all slots held by consumers, new frame thrown away
+        uint64_t readErrors {0};
+    };
+
+    class FrameRef;
+    class Consumer;
+
+private:
+    explicit FrameGrabber(const std::shared_ptr<IStream>& stream, size_t capacity, OverflowPolicy overflowPolicy);
+
+public:
+    ~FrameGrabber();
+
+    // capacity should be lower than driver buffers count - every frame in ring holds one driver buffer
+    static std::shared_ptr<FrameGrabber> createInstance(const std::shared_ptr<IStream>& stream, size_t capacity, OverflowPolicy overflowPolicy);
+
+    // stream must be started already
+    [[nodiscard]] VoidResult start();
+    void stop();
+    bool isRunning() const;
+
+    // consumer receives frames grabbed after its creation
+    std::shared_ptr<Consumer> createConsumer();
+
+    size_t getCapacity() const;
+    OverflowPolicy getOverflowPolicy() const;
+    Statistics getStatistics() const;
+
+private:
+    void grabbingThread();
+    bool publish(Frame& frame);
+    bool waitForConsumers(uint64_t sequence);
+    bool waitForUnpinned(const Slot& slot);
+    size_t getReadableFramesCount() const;
+
+    static constexpr uint64_t INVALID_SEQUENCE = std::numeric_limits<uint64_t>::max();
+    static constexpr uint64_t WRITING_SEQUENCE = INVALID_SEQUENCE - 1;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr auto WAIT_STEP = std::chrono::milliseconds(1);
+    static constexpr auto READ_ERROR_DELAY = std::chrono::milliseconds(10);
+
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        Frame frame;
+        std::atomic<uint64_t> sequence {INVALID_SEQUENCE};
+        std::atomic<uint64_t> skippedSequence {INVALID_SEQUENCE}; // sequence not published in slot because it was pinned - not a dropped frame
+        std::atomic<uint32_t> pins {0};
+    };
+
+    std::shared_ptr<IStream> m_stream;
+    OverflowPolicy m_overflowPolicy;
+
+    size_t m_capacity {0};
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_publishedSequence {0};
+
+    std::atomic<uint64_t> m_framesGrabbed {0};
+    std::atomic<uint64_t> m_framesDropped {0};
+    std::atomic<uint64_t> m_readErrors {0};
+
+    // cursors do not own grabber - grabbing thread never holds last reference of it
+    struct ConsumerCursor
+    {
+        std::atomic<uint64_t> nextSequence {0};
+        std::atomic<uint64_t> droppedFrames {0};
+        std::atomic<bool> active {true};
+    };
+
+    // consumers list changes rarely - grabbing thread refreshes its copy only when changed
+    std::mutex m_consumersMutex;
+    std::vector<std::shared_ptr<ConsumerCursor>> m_consumerCursors;
+    std::atomic<bool> m_consumersChanged {false};
+    std::vector<std::shared_ptr<ConsumerCursor>> m_grabbingThreadCursors;
+
+    // only for blocking Consumer::read(), ring itself is lock free
+    std::mutex m_frameMutex;
+    std::condition_variable m_frameCondition;
+
+    std::atomic<bool> m_keepRunning {false};
+    std::thread m_thread;
+};
+
+
+// pins frame in ring slot - must be released promptly, otherwise grabber drops (or waits for) frames
+class FrameGrabber::FrameRef final
+{
+public:
+    FrameRef() = default;
+    ~FrameRef();
+
+    FrameRef(FrameRef&& other) noexcept;
+    FrameRef& operator=(FrameRef&& other) noexcept;
+
+    FrameRef(const FrameRef&) = delete;
+    FrameRef& operator=(const FrameRef&) = delete;
+
+    bool isValid() const;
+    const Frame& getFrame() const;
+    uint64_t getSequence() const;
+
+    void reset();
+
+private:
+    friend class FrameGrabber::Consumer;
+
+    std::shared_ptr<FrameGrabber> m_grabber;
+    Slot* m_slot {nullptr};
+    uint64_t m_sequence {INVALID_SEQUENCE};
+};
+
+
+class FrameGrabber::Consumer final
+{
+public:
+    explicit Consumer(const std::shared_ptr<FrameGrabber>& grabber, const std::shared_ptr<ConsumerCursor>& cursor);
+    ~Consumer();
+
+    // returns false if there is no new frame - frameRef is left untouched
+    bool tryRead(FrameRef& frameRef);
+    bool read(FrameRef& frameRef, std::chrono::steady_clock::duration timeout);
+
+    // frames overwritten before this consumer read them
+    uint64_t getDroppedFramesCount() const;
+
+private:
+    std::shared_ptr<FrameGrabber> m_grabber;
+    std::shared_ptr<ConsumerCursor> m_cursor;
+};
+
+} // namespace core
+
+#endif // CORE_FRAMEGRABBER_H
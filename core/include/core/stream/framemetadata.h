@@ -0,0 +1,48 @@
+#ifndef CORE_FRAMEMETADATA_H
+#define CORE_FRAMEMETADATA_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+
+namespace core
+{
+
+struct FrameMetadata
+{
+    // time when frame was received by host
+    std::chrono::steady_clock::time_point hostTimestamp;
+    // device / driver time base - comparable only between frames of one stream
+    std::optional<std::chrono::nanoseconds> deviceTimestamp;
+    // increments by one for every frame sent by device (dropped frames included)
+    uint64_t sequenceNumber {0};
+    // driver block id (eBUS)
+    std::optional<uint64_t> blockId;
+    // frames lost since stream start (before this frame)
+    uint64_t droppedFramesCount {0};
+
+    bool operator==(const FrameMetadata&) const = default;
+};
+
+// assigns sequence numbers and detects dropped frames from block id gaps or from device timestamp gaps
+class FrameMetadataTracker final
+{
+public:
+    void reset();
+
+    FrameMetadata createFromBlockId(uint64_t blockId, std::optional<std::chrono::nanoseconds> deviceTimestamp);
+    FrameMetadata createFromDeviceTimestamp(std::optional<std::chrono::nanoseconds> deviceTimestamp, std::chrono::nanoseconds expectedFrameInterval);
+
+private:
+    FrameMetadata createNext(uint64_t droppedFrames, std::optional<std::chrono::nanoseconds> deviceTimestamp);
+
+    std::optional<uint64_t> m_lastSequenceNumber;
+    std::optional<uint64_t> m_lastBlockId;
+    std::optional<std::chrono::nanoseconds> m_lastDeviceTimestamp;
+    uint64_t m_droppedFramesCount {0};
+};
+
+} // namespace core
+
+#endif // CORE_FRAMEMETADATA_H
@@ -1,6 +1,8 @@
 #ifndef CORE_IMAGEDATA_H
 #define CORE_IMAGEDATA_H
 
+#include "core/stream/framemetadata.h"
+
 #include <vector>
 #include <cstdint>
 
@@ -26,6 +28,7 @@ public:
 public:
     Type type;
     std::vector<uint8_t> data;
+    FrameMetadata metadata;
 };
 } // namespace core
 
@@ -2,6 +2,7 @@
 #define CORE_ISTREAM_H
 
 #include "core/stream/imagedata.h"
+#include "core/stream/frame.h"
 #include "core/misc/result.h"
 
 namespace core
@@ -30,7 +31,21 @@ public:
 
     [[nodiscard]] virtual bool isRunning() const = 0;
 
-    [[nodiscard]] virtual VoidResult readImageData(ImageData& imageData) = 0;
+    // zero copy - frame borrows driver buffer or pooled buffer, previous content of frame is released
+    [[nodiscard]] virtual VoidResult readFrame(Frame& frame) = 0;
+
+    // copy of readFrame() data, capacity of imageData is reused
+    [[nodiscard]] virtual VoidResult readImageData(ImageData& imageData)
+    {
+        Frame frame;
+        if (auto result = readFrame(frame); !result.isOk())
+        {
+            return result;
+        }
+
+        frame.copyTo(imageData);
+        return VoidResult::createOk();
+    }
 
     static constexpr uint16_t WIDTH_INPUT_STREAM = 640;
     static constexpr uint16_t HEIGHT_INPUT_STREAM = 480;
@@ -0,0 +1,63 @@
+#ifndef CORE_RAWVIDEOFILE_H
+#define CORE_RAWVIDEOFILE_H
+
+#include "core/stream/imagedata.h"
+
+#include <optional>
+#include <span>
+
+
+namespace core
+{
+
+// append only container of raw frames - all values little endian
+// file header | frame record (header + data, aligned) ... | index (offsets of frame records) | footer
+// file without footer (interrupted recording) can be indexed by scanning frame records
+class RawVideoFile final
+{
+public:
+    static constexpr uint32_t FILE_MAGIC = 0x56525757;   // "WWRV"
+    static constexpr uint32_t FRAME_MAGIC = 0x4d415246;  // "FRAM"
+    static constexpr uint32_t FOOTER_MAGIC = 0x58444e49; // "INDX"
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    static constexpr size_t FILE_HEADER_SIZE = 64;
+    static constexpr size_t FRAME_HEADER_SIZE = 64;
+    static constexpr size_t FOOTER_SIZE = 24;
+    static constexpr size_t RECORD_ALIGNMENT = 8;
+
+    struct FileHeader
+    {
+        uint32_t width {0};
+        uint32_t height {0};
+    };
+
+    struct FrameHeader
+    {
+        ImageData::Type type {ImageData::Type::Raw14Bit};
+        uint32_t dataSize {0};
+        FrameMetadata metadata;
+    };
+
+    struct Footer
+    {
+        uint64_t indexOffset {0};
+        uint64_t framesCount {0};
+    };
+
+    // frame header + data + padding
+    static size_t getRecordSize(uint32_t dataSize);
+
+    static void writeFileHeader(const FileHeader& header, std::span<uint8_t> buffer);
+    static std::optional<FileHeader> readFileHeader(std::span<const uint8_t> buffer);
+
+    static void writeFrameHeader(const FrameHeader& header, std::span<uint8_t> buffer);
+    static std::optional<FrameHeader> readFrameHeader(std::span<const uint8_t> buffer);
+
+    static void writeFooter(const Footer& footer, std::span<uint8_t> buffer);
+    static std::optional<Footer> readFooter(std::span<const uint8_t> buffer);
+};
+
+} // namespace core
+
+#endif // CORE_RAWVIDEOFILE_H
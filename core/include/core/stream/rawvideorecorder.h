@@ -0,0 +1,95 @@
+#ifndef CORE_RAWVIDEORECORDER_H
+#define CORE_RAWVIDEORECORDER_H
+
+#include "core/stream/frame.h"
+#include "core/stream/rawvideofile.h"
+#include "core/misc/result.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace core
+{
+
+// records frames into RawVideoFile
+// frames are copied into preallocated chunks on caller thread, full chunks are written by writer thread
+// => memory is bounded by chunkSize * chunksCount, frame is dropped (never blocks caller) when writer does not keep up
+class RawVideoRecorder final
+{
+    explicit RawVideoRecorder(size_t chunkSize, size_t chunksCount);
+
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t DEFAULT_CHUNKS_COUNT = 4;
+
+    struct Statistics
+    {
+        uint64_t framesRecorded {0};
+        uint64_t framesDropped {0};
+        uint64_t bytesWritten {0};
+    };
+
+    ~RawVideoRecorder();
+
+    // chunk must hold at least one frame record
+    static std::shared_ptr<RawVideoRecorder> createInstance(size_t chunkSize = DEFAULT_CHUNK_SIZE, size_t chunksCount = DEFAULT_CHUNKS_COUNT);
+
+    [[nodiscard]] VoidResult open(const std::string& filename, uint32_t width, uint32_t height);
+    // writes remaining chunks and index, returns first write error of recording
+    // after write error index contains only frames written before the error
+    [[nodiscard]] VoidResult close();
+    bool isOpen() const;
+
+    // returns false if frame was dropped (writer does not keep up, write error occurred)
+    bool addFrame(const Frame& frame);
+    bool addFrame(ImageData::Type type, std::span<const uint8_t> data, const FrameMetadata& metadata);
+
+    Statistics getStatistics() const;
+
+private:
+    struct Chunk
+    {
+        std::vector<uint8_t> data;
+        size_t size {0};
+    };
+
+    bool acquireChunk();
+    void submitChunk();
+    void writingThread();
+    void writeChunk(const Chunk& chunk);
+
+    const size_t m_chunkSize;
+
+    std::ofstream m_file;
+    std::thread m_thread;
+    bool m_isOpen {false};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<std::unique_ptr<Chunk>> m_freeChunks;
+    std::deque<std::unique_ptr<Chunk>> m_fullChunks;
+    bool m_stopRequested {false};
+    std::optional<VoidResult> m_writeError;
+    // m_writeError without lock for caller thread
+    std::atomic<bool> m_writeFailed {false};
+
+    // caller thread only
+    std::unique_ptr<Chunk> m_currentChunk;
+    uint64_t m_fileOffset {0};
+    std::vector<uint64_t> m_index;
+
+    std::atomic<uint64_t> m_framesRecorded {0};
+    std::atomic<uint64_t> m_framesDropped {0};
+    std::atomic<uint64_t> m_bytesWritten {0};
+};
+
+} // namespace core
+
+#endif // CORE_RAWVIDEORECORDER_H
@@ -0,0 +1,76 @@
+#ifndef CORE_RAWVIDEOREPLAYSTREAM_H
+#define CORE_RAWVIDEOREPLAYSTREAM_H
+
+#include "core/stream/istream.h"
+#include "core/stream/rawvideofile.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace core
+{
+
+// replays RawVideoFile recorded by RawVideoRecorder - file is memory mapped, frames point directly into mapping (zero copy)
+// frames of requested type only are replayed, metadata are kept except host timestamp (time of replay)
+class RawVideoReplayStream final : public IStream
+{
+    class MappedFile;
+
+public:
+    enum class Pacing
+    {
+        RECORDED, // original cadence of recording
+        MAXIMUM,  // as fast as possible
+    };
+
+private:
+    explicit RawVideoReplayStream(const std::shared_ptr<MappedFile>& file, const RawVideoFile::FileHeader& fileHeader, std::vector<uint64_t>&& index, Pacing pacing, bool loop);
+
+public:
+    virtual ~RawVideoReplayStream() override;
+
+    [[nodiscard]] static ValueResult<std::shared_ptr<RawVideoReplayStream>> createStream(const std::string& filename, Pacing pacing = Pacing::RECORDED, bool loop = true);
+
+    [[nodiscard]] virtual VoidResult startStream(ImageData::Type type) override;
+    [[nodiscard]] virtual VoidResult stopStream() override;
+    [[nodiscard]] virtual bool isRunning() const override;
+    [[nodiscard]] virtual VoidResult readFrame(Frame& frame) override;
+
+    const RawVideoFile::FileHeader& getFileHeader() const;
+    // all frames of recording (any type)
+    size_t getFramesCount() const;
+
+    // random access - next read returns given frame of replayed type
+    [[nodiscard]] VoidResult seek(size_t position);
+
+private:
+    std::optional<RawVideoFile::FrameHeader> readFrameHeader(uint64_t offset) const;
+    static std::chrono::nanoseconds getRecordedTime(const FrameMetadata& metadata);
+
+    std::shared_ptr<MappedFile> m_file;
+    const RawVideoFile::FileHeader m_fileHeader;
+    const std::vector<uint64_t> m_index;
+    const Pacing m_pacing;
+    const bool m_loop;
+
+    std::mutex m_mutex;
+    std::atomic<bool> m_running {false};
+    ImageData::Type m_type {ImageData::Type::Raw14Bit};
+
+    // offsets of frames of replayed type
+    std::vector<uint64_t> m_playlist;
+    size_t m_position {0};
+
+    // replay time of first frame of playlist, shifted every loop
+    std::chrono::steady_clock::time_point m_replayStart;
+    std::chrono::nanoseconds m_recordedStart {0};
+    std::chrono::nanoseconds m_loopDuration {0};
+    uint64_t m_loopSequenceLength {0};
+    uint64_t m_loopsCount {0};
+};
+
+} // namespace core
+
+#endif // CORE_RAWVIDEOREPLAYSTREAM_H
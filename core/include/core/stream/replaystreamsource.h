@@ -0,0 +1,38 @@
+#ifndef CORE_REPLAYSTREAMSOURCE_H
+#define CORE_REPLAYSTREAMSOURCE_H
+
+#include "core/stream/istreamsource.h"
+#include "core/stream/rawvideoreplaystream.h"
+#include "core/stream/syntheticstream.h"
+
+#include <functional>
+#include <mutex>
+
+
+namespace core
+{
+
+// stream source without device - recording replay or synthetic pattern, used instead of data link stream source
+class ReplayStreamSource final : public IStreamSource
+{
+    using StreamFactory = std::function<ValueResult<std::shared_ptr<IStream>>()>;
+
+    explicit ReplayStreamSource(const StreamFactory& streamFactory);
+
+public:
+    static std::shared_ptr<ReplayStreamSource> createFromRecording(const std::string& filename, RawVideoReplayStream::Pacing pacing = RawVideoReplayStream::Pacing::RECORDED, bool loop = true);
+    static std::shared_ptr<ReplayStreamSource> createSynthetic(std::chrono::nanoseconds frameInterval = SyntheticStream::DEFAULT_FRAME_INTERVAL);
+
+    [[nodiscard]] virtual ValueResult<std::shared_ptr<IStream>> getOrCreateStream() override;
+    [[nodiscard]] virtual ValueResult<std::shared_ptr<IStream>> getStream() override;
+
+private:
+    StreamFactory m_streamFactory;
+
+    std::mutex m_mutex;
+    std::weak_ptr<IStream> m_stream;
+};
+
+} // namespace core
+
+#endif // CORE_REPLAYSTREAMSOURCE_H
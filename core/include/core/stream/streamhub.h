@@ -0,0 +1,110 @@
+#ifndef CORE_STREAMHUB_H
+#define CORE_STREAMHUB_H
+
+#include "core/stream/framegrabber.h"
+#include "core/misc/palette.h"
+#include "core/misc/temporalfilter.h"
+
+#include <deque>
+#include <future>
+
+
+namespace core
+{
+
+// single acquisition (in richest format) published to multiple subscribers, each in its own format
+// conversions are computed lazily by first subscriber asking for given frame and format, other subscribers share the result
+// Raw14Bit => PaletteIndices => RGB, YUYV422 => RGB
+class StreamHub final : public std::enable_shared_from_this<StreamHub>
+{
+    explicit StreamHub(const std::shared_ptr<IStream>& stream, size_t capacity);
+
+public:
+    class Subscriber;
+
+    static constexpr size_t DEFAULT_CAPACITY = 4;
+
+    ~StreamHub();
+
+    static std::shared_ptr<StreamHub> createInstance(const std::shared_ptr<IStream>& stream, size_t capacity = DEFAULT_CAPACITY);
+
+    // starts stream in given type and acquisition thread, fails if existing subscriber type cannot be converted from acquisition type
+    [[nodiscard]] VoidResult start(ImageData::Type acquisitionType = ImageData::Type::Raw14Bit);
+    void stop();
+    bool isRunning() const;
+
+    ImageData::Type getAcquisitionType() const;
+
+    // palette used for RGB conversion of Raw14Bit and PaletteIndices frames
+    Palette getPalette() const;
+    void setPalette(const Palette& palette);
+
+    static bool isConversionSupported(ImageData::Type from, ImageData::Type to);
+
+    // subscriber receives frames acquired after its creation, type must be convertible from acquisition type
+    [[nodiscard]] ValueResult<std::shared_ptr<Subscriber>> subscribe(ImageData::Type type);
+
+    // computed conversions (i.e. cache misses)
+    uint64_t getConversionsCount() const;
+    FrameGrabber::Statistics getStatistics() const;
+
+private:
+    using ConvertedData = std::shared_ptr<const ImageData>;
+
+    ConvertedData getConverted(const FrameGrabber::FrameRef& frameRef, ImageData::Type type);
+    ConvertedData convert(const FrameGrabber::FrameRef& frameRef, ImageData::Type type);
+
+    struct CacheEntry
+    {
+        uint64_t sequence {0};
+        ImageData::Type type {ImageData::Type::Raw14Bit};
+        std::shared_future<ConvertedData> data;
+    };
+
+    std::shared_ptr<IStream> m_stream;
+    std::shared_ptr<FrameGrabber> m_grabber;
+    std::atomic<ImageData::Type> m_acquisitionType {ImageData::Type::Raw14Bit};
+
+    // types of subscribers are checked by start
+    std::mutex m_subscribersMutex;
+    std::vector<std::weak_ptr<Subscriber>> m_subscribers;
+
+    mutable std::mutex m_paletteMutex;
+    Palette m_palette;
+
+    // few recent frames in every format - subscribers read at most capacity frames behind
+    size_t m_cacheCapacity {0};
+    std::mutex m_cacheMutex;
+    std::deque<CacheEntry> m_cache;
+    std::atomic<uint64_t> m_conversionsCount {0};
+};
+
+
+class StreamHub::Subscriber final
+{
+public:
+    explicit Subscriber(const std::shared_ptr<StreamHub>& hub, const std::shared_ptr<FrameGrabber::Consumer>& consumer, ImageData::Type type);
+
+    ImageData::Type getType() const;
+
+    // returns nullptr if there is no frame within timeout, exception thrown by conversion is rethrown to all readers of the frame
+    std::shared_ptr<const ImageData> read(std::chrono::steady_clock::duration timeout);
+
+    // zero copy access to acquired frame (acquisition type), no conversion
+    bool readFrame(FrameGrabber::FrameRef& frameRef, std::chrono::steady_clock::duration timeout);
+
+    // acquired frame (Raw14Bit acquisition) passed through filter into output, filter reads pinned frame without copy and output capacity is reused
+    // filter sees only frames read by this subscriber - dropped frames are missing in average, false if there is no frame within timeout
+    [[nodiscard]] ValueResult<bool> readFiltered(TemporalFilter& filter, ImageData& output, std::chrono::steady_clock::duration timeout);
+
+    uint64_t getDroppedFramesCount() const;
+
+private:
+    std::shared_ptr<StreamHub> m_hub;
+    std::shared_ptr<FrameGrabber::Consumer> m_consumer;
+    ImageData::Type m_type;
+};
+
+} // namespace core
+
+#endif // CORE_STREAMHUB_H
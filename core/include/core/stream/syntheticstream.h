@@ -0,0 +1,55 @@
+#ifndef CORE_SYNTHETICSTREAM_H
+#define CORE_SYNTHETICSTREAM_H
+
+#include "core/stream/istream.h"
+#include "core/stream/framebufferpool.h"
+#include "core/stream/framemetadata.h"
+
+#include <atomic>
+#include <mutex>
+
+
+namespace core
+{
+
+// deterministic moving test pattern (gradient with hot spot) - reproducible input without device
+// Raw14Bit and YUYV422 only, frame N is always the same
+class SyntheticStream final : public IStream
+{
+    explicit SyntheticStream(std::chrono::nanoseconds frameInterval);
+
+public:
+    static constexpr uint16_t WIDTH_INPUT_STREAM = 640;
+    static constexpr uint16_t HEIGHT_INPUT_STREAM = 480;
+    static constexpr auto DEFAULT_FRAME_INTERVAL = std::chrono::nanoseconds(std::chrono::seconds(1)) / 60;
+
+    virtual ~SyntheticStream() override;
+
+    // zero frame interval => as fast as possible
+    static std::shared_ptr<SyntheticStream> createStream(std::chrono::nanoseconds frameInterval = DEFAULT_FRAME_INTERVAL);
+
+    [[nodiscard]] virtual VoidResult startStream(ImageData::Type type) override;
+    [[nodiscard]] virtual VoidResult stopStream() override;
+    [[nodiscard]] virtual bool isRunning() const override;
+    [[nodiscard]] virtual VoidResult readFrame(Frame& frame) override;
+
+    static void generateRaw14(uint64_t frameNumber, std::span<uint8_t> data);
+    static void generateYuyv422(uint64_t frameNumber, std::span<uint8_t> data);
+
+private:
+    static constexpr size_t BUFFERS_COUNT = 8;
+
+    const std::chrono::nanoseconds m_frameInterval;
+
+    std::mutex m_mutex;
+    std::atomic<bool> m_running {false};
+    ImageData::Type m_type {ImageData::Type::Raw14Bit};
+    std::shared_ptr<FrameBufferPool> m_bufferPool;
+
+    std::chrono::steady_clock::time_point m_startTime;
+    uint64_t m_frameNumber {0};
+};
+
+} // namespace core
+
+#endif // CORE_SYNTHETICSTREAM_H
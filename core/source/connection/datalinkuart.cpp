@@ -9,6 +9,7 @@
 #include "core/logging.h"
 #include "core/utils.h"
 
+#include <boost/scope_exit.hpp>
 #include <boost/system/windows_error.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 
@@ -140,6 +141,17 @@ VoidResult DataLinkUart::UartStream::startStream(ImageData::Type dataType)
             return VoidResult::createError("Unknown video format!");
     }
 
+    m_metadataTracker.reset();
+
+    if (m_packetPool == nullptr)
+    {
+        m_packetPool = std::make_shared<PacketPool>();
+    }
+    if (m_dataType == ImageData::Type::RGB && m_rgbBufferPool == nullptr)
+    {
+        m_rgbBufferPool = FrameBufferPool::createInstance(RGB_BUFFERS_COUNT, WIDTH_INPUT_STREAM * HEIGHT_INPUT_STREAM * 3);
+    }
+
     avdevice_register_all();
 
     AVDictionary *avDictionaryOptions = nullptr;
@@ -147,7 +159,7 @@ VoidResult DataLinkUart::UartStream::startStream(ImageData::Type dataType)
     av_log_set_level(AV_LOG_QUIET);
     av_dict_set(&avDictionaryOptions, "rtbufsize", bufferSize.c_str(), 0); // buffer size is 2 frames
     av_dict_set(&avDictionaryOptions, "pixel_format", pixelFormat, 0);
-    av_dict_set(&avDictionaryOptions, "framerate", "60", 0);
+    av_dict_set(&avDictionaryOptions, "framerate", std::to_string(FRAME_RATE).c_str(), 0);
     av_dict_set(&avDictionaryOptions, "thread_queue_size", "128", 0);
 
     auto* inputFormat = av_find_input_format(m_inputFormat.c_str());
@@ -162,6 +174,8 @@ VoidResult DataLinkUart::UartStream::startStream(ImageData::Type dataType)
     }
     if (m_dataType == ImageData::Type::RGB)
     {
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+
         const auto codec = avcodec_find_decoder(m_inputContext->streams[0]->codecpar->codec_id);
         m_codecContext = avcodec_alloc_context3(codec);
         if(const auto result = avcodec_parameters_to_context(m_codecContext, m_inputContext->streams[0]->codecpar); result != 0)
@@ -172,17 +186,32 @@ VoidResult DataLinkUart::UartStream::startStream(ImageData::Type dataType)
         {
             return VoidResult::createError("Failed to open codec", utils::format("avcodec_open2 return is {}", result));
         }
+
+        if (m_decodedFrame == nullptr)
+        {
+            m_decodedFrame = av_frame_alloc();
+        }
+        m_rgbFrameSize = av_image_get_buffer_size(AV_PIX_FMT_RGB24, m_codecContext->width, m_codecContext->height, 1);
+        if (m_decodedFrame == nullptr || m_rgbFrameSize <= 0)
+        {
+            return VoidResult::createError("Failed to open codec", utils::format("invalid frame size {}x{}", m_codecContext->width, m_codecContext->height));
+        }
     }
     return VoidResult::createOk();
 }
 
 VoidResult DataLinkUart::UartStream::stopStream()
 {
-    std::lock_guard<std::mutex> lock(m_streamMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+        avformat_close_input(&m_inputContext);
+    }
 
-    avformat_close_input(&m_inputContext);
+    // waits only for frame being decoded right now
+    std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
     avcodec_free_context(&m_codecContext);
-    m_codecContext = nullptr;
+    av_frame_free(&m_decodedFrame);
+    sws_freeContext(m_convertContext);
     m_convertContext = nullptr;
 
     return VoidResult::createOk();
@@ -193,15 +222,14 @@ bool DataLinkUart::UartStream::isRunning() const
     return m_inputContext;
 }
 
-VoidResult DataLinkUart::UartStream::readImageData(ImageData& imageData)
+VoidResult DataLinkUart::UartStream::readFrame(Frame& frame)
 {
-    imageData.type = m_dataType;
     switch(m_dataType)
     {
     case ImageData::Type::Raw14Bit:
     case ImageData::Type::YUYV422:
     {
-        auto result = getFrameData(imageData.data);
+        auto result = getFrameData(frame);
         if(!result.isOk())
         {
             return result;
@@ -211,7 +239,7 @@ VoidResult DataLinkUart::UartStream::readImageData(ImageData& imageData)
 
     case ImageData::Type::RGB:
     {
-        auto result = getRgbFrameData(imageData.data);
+        auto result = getRgbFrameData(frame);
         if(!result.isOk())
         {
             return result;
@@ -226,63 +254,64 @@ VoidResult DataLinkUart::UartStream::readImageData(ImageData& imageData)
     }
     }
 
-    if (imageData.data.empty())
+    if (frame.isEmpty())
     {
         return VoidResult::createError("Image data is empty!");
     }
     return VoidResult::createOk();
 }
 
-ValueResult<std::shared_ptr<DataLinkUart::UartStream>> DataLinkUart::UartStream::createStream(const std::string& deviceName, const std::string inputFormat)
-{
-    using ReturnType = ValueResult<std::shared_ptr<DataLinkUart::UartStream>>;
-
-    return std::make_shared<DataLinkUart::UartStream>(deviceName, inputFormat);
-}
-
-namespace
-{
-template<typename T>
-class RaiiObject final
+class DataLinkUart::UartStream::PacketPool final : public IFrameBufferOwner
 {
 public:
-    using DtorType = void (*)(T*);
-
-    RaiiObject(DtorType dtor) : _dtor(dtor) {}
-    RaiiObject(T&& value, DtorType dtor) : _value(std::forward<T>(value)), _dtor(dtor) {}
-
-    ~RaiiObject()
+    ~PacketPool()
     {
-        _dtor(&_value);
+        for (auto* packet : m_freePackets)
+        {
+            av_packet_free(&packet);
+        }
     }
 
-    T* ptr()
+    AVPacket* acquire()
     {
-        return &_value;
-    }
+        std::lock_guard lock(m_mutex);
+        if (m_freePackets.empty())
+        {
+            return av_packet_alloc();
+        }
 
-    T& get()
-    {
-        return _value;
+        auto* packet = m_freePackets.back();
+        m_freePackets.pop_back();
+        return packet;
     }
 
-    auto operator->()
+    virtual void releaseFrameBuffer(void* handle) override
     {
-        if constexpr(std::is_pointer_v<T>)
-            return _value;
-        else
-            return &_value;
+        auto* packet = static_cast<AVPacket*>(handle);
+        av_packet_unref(packet);
+
+        std::lock_guard lock(m_mutex);
+        m_freePackets.push_back(packet);
     }
 
 private:
-    T _value;
-    DtorType _dtor;
+    std::mutex m_mutex;
+    std::vector<AVPacket*> m_freePackets;
 };
-} // namespace
 
-VoidResult DataLinkUart::UartStream::getFrameData(std::vector<uint8_t>& data)
+ValueResult<std::shared_ptr<DataLinkUart::UartStream>> DataLinkUart::UartStream::createStream(const std::string& deviceName, const std::string inputFormat)
+{
+    using ReturnType = ValueResult<std::shared_ptr<DataLinkUart::UartStream>>;
+
+    return std::make_shared<DataLinkUart::UartStream>(deviceName, inputFormat);
+}
+
+VoidResult DataLinkUart::UartStream::getFrameData(Frame& frame)
 {
-    AVPacket packet;
+    frame.reset();
+
+    AVPacket* packet = nullptr;
+    FrameMetadata metadata;
     {
         std::lock_guard<std::mutex> lock(m_streamMutex);
         if (!isRunning())
@@ -290,61 +319,111 @@ VoidResult DataLinkUart::UartStream::getFrameData(std::vector<uint8_t>& data)
             return VoidResult::createError("Stream is not running!");
         }
 
-        if (int result = av_read_frame(m_inputContext, &packet); result < 0)
+        packet = m_packetPool->acquire();
+        if (packet == nullptr)
         {
+            return VoidResult::createError("Failed frame acquisition!", "av_packet_alloc failed");
+        }
+
+        if (int result = av_read_frame(m_inputContext, packet); result < 0)
+        {
+            m_packetPool->releaseFrameBuffer(packet);
             return VoidResult::createError("Failed frame acquisition!", utils::format("av_read_frame return is {}", result));
         }
+
+        metadata = createFrameMetadata(packet);
     }
-    data.resize(packet.size);
-    memcpy(data.data(), packet.data, packet.size);
-    av_packet_unref(&packet);
+
+    // packet is returned to pool (and its data unreferenced) when frame is released
+    frame.assign(m_dataType, std::span<const uint8_t>(packet->data, packet->size), m_packetPool, packet);
+    frame.setMetadata(metadata);
     return VoidResult::createOk();
 }
 
-VoidResult DataLinkUart::UartStream::getRgbFrameData(std::vector<uint8_t>& data)
+VoidResult DataLinkUart::UartStream::getRgbFrameData(Frame& frame)
 {
-    std::lock_guard<std::mutex> lock(m_streamMutex);
-    if (!isRunning())
-    {
-        return VoidResult::createError("Stream is not running!");
-    }
-
-    assert(m_codecContext != nullptr);
+    frame.reset();
 
-    auto frame = RaiiObject{av_frame_alloc(), av_frame_free};
-    auto frameRGB =  RaiiObject{av_frame_alloc(), av_frame_free};
-
-    frameRGB->width = m_codecContext->width;
-    frameRGB->height = m_codecContext->height;
-    frameRGB->format = AV_PIX_FMT_RGB24;
+    AVPacket* packet = nullptr;
+    FrameMetadata metadata;
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+        if (!isRunning())
+        {
+            return VoidResult::createError("Stream is not running!");
+        }
 
-    auto numBytes = av_image_get_buffer_size(AV_PIX_FMT_RGB24, frameRGB->width, frameRGB->height, 1);
-    data.resize(numBytes);
+        packet = m_packetPool->acquire();
+        if (packet == nullptr)
+        {
+            return VoidResult::createError("Failed frame acquisition!", "av_packet_alloc failed");
+        }
 
-    av_image_fill_arrays(frameRGB->data, frameRGB->linesize, data.data(), AV_PIX_FMT_RGB24, frameRGB->width, frameRGB->height, 1);
+        if (int result = av_read_frame(m_inputContext, packet); result != 0)
+        {
+            m_packetPool->releaseFrameBuffer(packet);
+            return VoidResult::createError("Failed frame acquisition!", utils::format("av_read_frame return is {}", result));
+        }
+        metadata = createFrameMetadata(packet);
+        ticket = m_nextReadTicket++;
+    }
 
-    auto packet = RaiiObject{av_packet_unref};
-    if (int result = av_read_frame(m_inputContext, packet.ptr()); result != 0)
+    // decode and conversion do not block reading of next packet nor stopStream, concurrent readers wait for their turn => frames are not reordered
+    std::unique_lock<std::mutex> decodeLock(m_decodeMutex);
+    m_decodeTurnChanged.wait(decodeLock, [this, ticket]() { return m_decodeTurn == ticket; });
+    BOOST_SCOPE_EXIT(this_)
     {
-        return VoidResult::createError("Failed frame acquisition!", utils::format("av_read_frame return is {}", result));
+        ++this_->m_decodeTurn;
+        this_->m_decodeTurnChanged.notify_all();
+    } BOOST_SCOPE_EXIT_END
+    if (m_codecContext == nullptr)
+    {
+        m_packetPool->releaseFrameBuffer(packet);
+        return VoidResult::createError("Stream is not running!");
     }
 
-    if (auto result = avcodec_send_packet(m_codecContext, packet.ptr()); result != 0)
+    const auto sendResult = avcodec_send_packet(m_codecContext, packet);
+    m_packetPool->releaseFrameBuffer(packet);
+    if (sendResult != 0)
     {
-        return VoidResult::createError("Failed frame acquisition!", utils::format("avcodec_send_packet return is {}", result));
+        return VoidResult::createError("Failed frame acquisition!", utils::format("avcodec_send_packet return is {}", sendResult));
     }
 
-    if (auto result = avcodec_receive_frame(m_codecContext, frame.get()); result != 0)
+    if (auto result = avcodec_receive_frame(m_codecContext, m_decodedFrame); result != 0)
     {
         return VoidResult::createError("Failed frame acquisition!", utils::format("avcodec_receive_frame return is {}", result));
     }
 
-    m_convertContext = sws_getCachedContext(m_convertContext, frameRGB->width, frameRGB->height, m_codecContext->pix_fmt, frameRGB->width, frameRGB->height, AV_PIX_FMT_RGB24, SWS_BICUBIC, NULL, NULL, NULL);
-    sws_scale(m_convertContext, frame->data, frame->linesize, 0, frameRGB->height, frameRGB->data, frameRGB->linesize);
+    const auto data = m_rgbBufferPool->acquire(frame, ImageData::Type::RGB, m_rgbFrameSize);
+
+    uint8_t* rgbData[4] = {};
+    int rgbLinesize[4] = {};
+    av_image_fill_arrays(rgbData, rgbLinesize, data.data(), AV_PIX_FMT_RGB24, m_codecContext->width, m_codecContext->height, 1);
+
+    // only pixel format is converted, size is the same => nearest neighbour is exact and cheapest
+    m_convertContext = sws_getCachedContext(m_convertContext, m_codecContext->width, m_codecContext->height, m_codecContext->pix_fmt,
+                                            m_codecContext->width, m_codecContext->height, AV_PIX_FMT_RGB24, SWS_POINT, NULL, NULL, NULL);
+    sws_scale(m_convertContext, m_decodedFrame->data, m_decodedFrame->linesize, 0, m_codecContext->height, rgbData, rgbLinesize);
+    av_frame_unref(m_decodedFrame);
+
+    frame.setMetadata(metadata);
 
     return  VoidResult::createOk();
 }
 
+FrameMetadata DataLinkUart::UartStream::createFrameMetadata(const AVPacket* packet)
+{
+    std::optional<std::chrono::nanoseconds> deviceTimestamp;
+    if (packet->pts != AV_NOPTS_VALUE && packet->stream_index >= 0 && static_cast<unsigned>(packet->stream_index) < m_inputContext->nb_streams)
+    {
+        // capture time of driver
+        deviceTimestamp = std::chrono::nanoseconds(av_rescale_q(packet->pts, m_inputContext->streams[packet->stream_index]->time_base, AVRational{1, 1000000000}));
+    }
+
+    return m_metadataTracker.createFromDeviceTimestamp(deviceTimestamp, std::chrono::nanoseconds(std::chrono::seconds(1)) / FRAME_RATE);
+}
+
 ValueResult<Baudrate::Item> DataLinkUart::getBaudrate() const
 {
     using ResultType = ValueResult<Baudrate::Item>;
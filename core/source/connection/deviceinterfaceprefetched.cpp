@@ -0,0 +1,122 @@
+#include "core/connection/deviceinterfaceprefetched.h"
+
+#include "core/logging.h"
+#include "core/utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace core
+{
+
+namespace connection
+{
+
+DeviceInterfacePrefetched::DeviceInterfacePrefetched(IDeviceInterface* device) :
+    BaseClass(device->getDeviceEndianity()),
+    m_device(device)
+{
+}
+
+void DeviceInterfacePrefetched::prefetch(const AddressRanges& addressRanges, ProgressTask progress)
+{
+    for (const auto& addressRange : addressRanges.getRanges())
+    {
+        if (findBlockContaining(addressRange) != nullptr)
+        {
+            continue;
+        }
+
+        auto result = m_device->readAddressRange(addressRange, progress);
+        if (!result.isOk())
+        {
+            WW_LOG_CONNECTION_DEBUG << utils::format("prefetch of {} skipped: {}", addressRange.toHexString(), result.toString());
+            continue;
+        }
+
+        removeOverlappingBlocks(addressRange);
+        m_blocks.emplace(addressRange, std::move(result).releaseValue());
+    }
+}
+
+void DeviceInterfacePrefetched::addBlock(const AddressRange& addressRange, const std::vector<uint8_t>& data)
+{
+    assert(addressRange.getSize() == data.size());
+
+    removeOverlappingBlocks(addressRange);
+    m_blocks.emplace(addressRange, data);
+}
+
+void DeviceInterfacePrefetched::clear()
+{
+    m_blocks.clear();
+}
+
+size_t DeviceInterfacePrefetched::getPrefetchedBlocksCount() const
+{
+    return m_blocks.size();
+}
+
+const std::map<AddressRange, std::vector<uint8_t>>& DeviceInterfacePrefetched::getBlocks() const
+{
+    return m_blocks;
+}
+
+VoidResult DeviceInterfacePrefetched::readData(std::span<uint8_t> data, uint32_t address, ProgressTask progress)
+{
+    if (!data.empty())
+    {
+        if (const auto* block = findBlockContaining(AddressRange::firstAndSize(address, data.size())))
+        {
+            std::memcpy(data.data(), block->second.data() + (address - block->first.getFirstAddress()), data.size());
+            return VoidResult::createOk();
+        }
+    }
+
+    return m_device->readData(data, address, progress);
+}
+
+VoidResult DeviceInterfacePrefetched::writeData(std::span<const uint8_t> data, uint32_t address, ProgressTask progress)
+{
+    if (!data.empty())
+    {
+        removeOverlappingBlocks(AddressRange::firstAndSize(address, data.size()));
+    }
+
+    return m_device->writeData(data, address, progress);
+}
+
+ValueResult<std::vector<uint8_t>> DeviceInterfacePrefetched::readSomeData(uint32_t address, ProgressTask progress)
+{
+    return m_device->readSomeData(address, progress);
+}
+
+std::optional<uint32_t> DeviceInterfacePrefetched::getReadPacketSize(uint32_t address) const
+{
+    return m_device->getReadPacketSize(address);
+}
+
+const std::pair<const AddressRange, std::vector<uint8_t>>* DeviceInterfacePrefetched::findBlockContaining(const AddressRange& addressRange) const
+{
+    // last block starting at or before address
+    auto it = m_blocks.upper_bound(AddressRange::firstToLast(addressRange.getFirstAddress(), std::numeric_limits<uint32_t>::max()));
+    if (it != m_blocks.begin() && std::prev(it)->first.contains(addressRange))
+    {
+        return &(*std::prev(it));
+    }
+
+    return nullptr;
+}
+
+void DeviceInterfacePrefetched::removeOverlappingBlocks(const AddressRange& addressRange)
+{
+    std::erase_if(m_blocks, [&addressRange](const auto& block)
+    {
+        return block.first.overlaps(addressRange);
+    });
+}
+
+} // namespace connection
+
+} // namespace core
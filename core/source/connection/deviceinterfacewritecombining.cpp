@@ -0,0 +1,161 @@
+#include "core/connection/deviceinterfacewritecombining.h"
+
+#include "core/logging.h"
+#include "core/utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace core
+{
+
+namespace connection
+{
+
+DeviceInterfaceWriteCombining::DeviceInterfaceWriteCombining(IDeviceInterface* device) :
+    BaseClass(device->getDeviceEndianity()),
+    m_device(device)
+{
+}
+
+VoidResult DeviceInterfaceWriteCombining::flush(ProgressTask progress)
+{
+    VoidResult flushResult = VoidResult::createOk();
+
+    for (const auto& [blockRange, blockData] : m_pendingBlocks)
+    {
+        const auto result = m_device->writeData(blockData, blockRange.getFirstAddress(), progress);
+        if (result.isOk())
+        {
+            continue;
+        }
+
+        WW_LOG_CONNECTION_DEBUG << utils::format("combined write of {} failed, writing separately: {}", blockRange.toHexString(), result.toString());
+
+        // original order - later write of same address wins
+        for (const auto& [writeRange, writeData] : m_pendingWrites)
+        {
+            if (!blockRange.contains(writeRange))
+            {
+                continue;
+            }
+
+            const auto writeResult = m_device->writeData(writeData, writeRange.getFirstAddress(), progress);
+            if (!writeResult.isOk())
+            {
+                m_failedRanges.push_back(writeRange);
+                if (flushResult.isOk())
+                {
+                    flushResult = writeResult;
+                }
+                if (m_firstFailedWriteResult.isOk())
+                {
+                    m_firstFailedWriteResult = writeResult;
+                }
+            }
+        }
+    }
+
+    m_pendingBlocks.clear();
+    m_pendingWrites.clear();
+
+    return flushResult;
+}
+
+bool DeviceInterfaceWriteCombining::hasPendingWrites() const
+{
+    return !m_pendingWrites.empty();
+}
+
+const std::vector<AddressRange>& DeviceInterfaceWriteCombining::getFailedRanges() const
+{
+    return m_failedRanges;
+}
+
+const VoidResult& DeviceInterfaceWriteCombining::getFirstFailedWriteResult() const
+{
+    return m_firstFailedWriteResult;
+}
+
+VoidResult DeviceInterfaceWriteCombining::readData(std::span<uint8_t> data, uint32_t address, ProgressTask progress)
+{
+    if (!data.empty() && overlapsPendingBlock(AddressRange::firstAndSize(address, data.size())))
+    {
+        if (const auto result = flush(progress); !result.isOk())
+        {
+            return result;
+        }
+    }
+
+    return m_device->readData(data, address, progress);
+}
+
+VoidResult DeviceInterfaceWriteCombining::writeData(std::span<const uint8_t> data, uint32_t address, ProgressTask)
+{
+    if (data.empty())
+    {
+        return VoidResult::createOk();
+    }
+
+    const auto writeRange = AddressRange::firstAndSize(address, data.size());
+    m_pendingWrites.emplace_back(writeRange, std::vector<uint8_t>(data.begin(), data.end()));
+
+    // union of write with all overlapping or adjacent blocks
+    uint64_t firstAddress = writeRange.getFirstAddress();
+    uint64_t lastAddress = writeRange.getLastAddress();
+    std::vector<std::map<AddressRange, std::vector<uint8_t>>::iterator> mergedBlocks;
+    for (auto it = m_pendingBlocks.begin(); it != m_pendingBlocks.end(); ++it)
+    {
+        if (static_cast<uint64_t>(it->first.getFirstAddress()) <= static_cast<uint64_t>(writeRange.getLastAddress()) + 1 &&
+            static_cast<uint64_t>(it->first.getLastAddress()) + 1 >= writeRange.getFirstAddress())
+        {
+            firstAddress = std::min<uint64_t>(firstAddress, it->first.getFirstAddress());
+            lastAddress = std::max<uint64_t>(lastAddress, it->first.getLastAddress());
+            mergedBlocks.push_back(it);
+        }
+    }
+
+    const auto blockRange = AddressRange::firstToLast(static_cast<uint32_t>(firstAddress), static_cast<uint32_t>(lastAddress));
+    std::vector<uint8_t> blockData(blockRange.getSize(), 0);
+    for (const auto& it : mergedBlocks)
+    {
+        std::memcpy(blockData.data() + (it->first.getFirstAddress() - blockRange.getFirstAddress()), it->second.data(), it->second.size());
+        m_pendingBlocks.erase(it);
+    }
+    std::memcpy(blockData.data() + (writeRange.getFirstAddress() - blockRange.getFirstAddress()), data.data(), data.size());
+
+    m_pendingBlocks.emplace(blockRange, std::move(blockData));
+
+    return VoidResult::createOk();
+}
+
+ValueResult<std::vector<uint8_t>> DeviceInterfaceWriteCombining::readSomeData(uint32_t address, ProgressTask progress)
+{
+    using ResultType = ValueResult<std::vector<uint8_t>>;
+
+    // read size is unknown in advance
+    if (hasPendingWrites())
+    {
+        TRY_RESULT(flush(progress));
+    }
+
+    return m_device->readSomeData(address, progress);
+}
+
+std::optional<uint32_t> DeviceInterfaceWriteCombining::getReadPacketSize(uint32_t address) const
+{
+    return m_device->getReadPacketSize(address);
+}
+
+bool DeviceInterfaceWriteCombining::overlapsPendingBlock(const AddressRange& addressRange) const
+{
+    return std::any_of(m_pendingBlocks.begin(), m_pendingBlocks.end(), [&addressRange](const auto& block)
+    {
+        return block.first.overlaps(addressRange);
+    });
+}
+
+} // namespace connection
+
+} // namespace core
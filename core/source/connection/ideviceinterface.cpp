@@ -16,6 +16,16 @@ IDeviceInterface::~IDeviceInterface()
 {
 }
 
+IDeviceInterface::DeviceEndianity IDeviceInterface::getDeviceEndianity() const
+{
+    return m_deviceEndianity;
+}
+
+std::optional<uint32_t> IDeviceInterface::getReadPacketSize(uint32_t) const
+{
+    return std::nullopt;
+}
+
 ValueResult<std::vector<uint8_t>> IDeviceInterface::readAddressRange(const AddressRange& addressRange, ProgressTask progress)
 {
     using ResultType = ValueResult<std::vector<uint8_t>>;
@@ -0,0 +1,694 @@
+#include "core/misc/colorizationkernels.h"
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+namespace
+{
+
+template<PixelFormat FORMAT>
+constexpr size_t BYTES_PER_PIXEL = PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL;
+
+template<PixelFormat FORMAT>
+inline void storePixel(uint8_t* output, size_t index, uint32_t pixel)
+{
+    if constexpr (BYTES_PER_PIXEL<FORMAT> == 4)
+    {
+        std::memcpy(output + index * 4, &pixel, sizeof(pixel));
+    }
+    else
+    {
+        output[index * 3] = static_cast<uint8_t>(pixel);
+        output[index * 3 + 1] = static_cast<uint8_t>(pixel >> 8);
+        output[index * 3 + 2] = static_cast<uint8_t>(pixel >> 16);
+    }
+}
+
+inline uint8_t clampToUint8(int value)
+{
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+template<PixelFormat FORMAT>
+inline uint32_t convertYuvToPixel(int y, int u, int v, uint8_t alpha)
+{
+    const int c = y - 16;
+    const int d = u - 128;
+    const int e = v - 128;
+
+    const uint8_t r = clampToUint8((298 * c + 409 * e + 128) >> 8);
+    const uint8_t g = clampToUint8((298 * c - 100 * d - 208 * e + 128) >> 8);
+    const uint8_t b = clampToUint8((298 * c + 516 * d + 128) >> 8);
+
+    return PixelFormatTraits<FORMAT>::pack(r, g, b, alpha);
+}
+
+template<PixelFormat FORMAT>
+void colorizePaletteIndicesScalar(const uint8_t* indices, size_t count, const uint32_t* packedPalette, uint8_t* output)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        storePixel<FORMAT>(output, i, packedPalette[indices[i]]);
+    }
+}
+
+template<PixelFormat FORMAT>
+void colorizeRaw14Scalar(const uint8_t* rawData, size_t count, const Raw14Window& window, const uint32_t* packedPalette, uint8_t* output)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        storePixel<FORMAT>(output, i, packedPalette[window.getPaletteIndex(readRaw14(rawData, i))]);
+    }
+}
+
+template<PixelFormat FORMAT>
+void colorizeRaw14WithLutScalar(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        storePixel<FORMAT>(output, i, lut[std::min<size_t>(readRaw14(rawData, i), RAW14_LUT_SIZE - 1)]);
+    }
+}
+
+void findRaw14MinMaxScalar(const uint8_t* rawData, size_t count, uint16_t& min, uint16_t& max)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint16_t value = readRaw14(rawData, i);
+        if (value < min) min = value;
+        if (value > max) max = value;
+    }
+}
+
+template<PixelFormat FORMAT>
+void colorizeRaw14WithLutAndFindMinMaxScalar(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output, uint16_t& min, uint16_t& max)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint16_t value = readRaw14(rawData, i);
+        if (value < min) min = value;
+        if (value > max) max = value;
+        storePixel<FORMAT>(output, i, lut[std::min<size_t>(value, RAW14_LUT_SIZE - 1)]);
+    }
+}
+
+// pixels count is even
+template<PixelFormat FORMAT>
+void convertYuyv422Scalar(const uint8_t* data, size_t pixelsCount, uint8_t alpha, uint8_t* output)
+{
+    for (size_t i = 0; i + 1 < pixelsCount; i += 2)
+    {
+        const uint8_t* pair = data + i * 2;
+        storePixel<FORMAT>(output, i, convertYuvToPixel<FORMAT>(pair[0], pair[1], pair[3], alpha));
+        storePixel<FORMAT>(output, i + 1, convertYuvToPixel<FORMAT>(pair[2], pair[1], pair[3], alpha));
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 inline __m128i packPixels(__m128i r, __m128i g, __m128i b, __m128i alpha)
+{
+    if constexpr (FORMAT == PixelFormat::ARGB)
+    {
+        return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(alpha, 24), _mm_slli_epi32(r, 16)), _mm_or_si128(_mm_slli_epi32(g, 8), b));
+    }
+    else if constexpr (FORMAT == PixelFormat::BGRA)
+    {
+        return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(b, 24), _mm_slli_epi32(g, 16)), _mm_or_si128(_mm_slli_epi32(r, 8), alpha));
+    }
+    else
+    {
+        return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_slli_epi32(b, 16));
+    }
+}
+
+// 4 packed pixels
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 inline void storePixels(uint8_t* output, __m128i pixels)
+{
+    if constexpr (BYTES_PER_PIXEL<FORMAT> == 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), pixels);
+    }
+    else
+    {
+        // drop every 4th byte => 12 bytes r g b r g b ...
+        const __m128i compacted = _mm_shuffle_epi8(pixels, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output), compacted);
+        const uint32_t last = static_cast<uint32_t>(_mm_extract_epi32(compacted, 2));
+        std::memcpy(output + 8, &last, sizeof(last));
+    }
+}
+
+// sse has no gather - indices are computed in vector, palette is read per lane
+CORE_TARGET_SSE41 inline __m128i lookupPackedPalette(__m128i indices, const uint32_t* packedPalette)
+{
+    return _mm_setr_epi32(static_cast<int>(packedPalette[_mm_extract_epi32(indices, 0)]),
+                          static_cast<int>(packedPalette[_mm_extract_epi32(indices, 1)]),
+                          static_cast<int>(packedPalette[_mm_extract_epi32(indices, 2)]),
+                          static_cast<int>(packedPalette[_mm_extract_epi32(indices, 3)]));
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 void colorizePaletteIndicesSse41(const uint8_t* indices, size_t count, const uint32_t* packedPalette, uint8_t* output)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        int fourIndices = 0;
+        std::memcpy(&fourIndices, indices + i, sizeof(fourIndices));
+
+        const __m128i indexVector = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(fourIndices));
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, lookupPackedPalette(indexVector, packedPalette));
+    }
+
+    colorizePaletteIndicesScalar<FORMAT>(indices + i, count - i, packedPalette, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 void colorizeRaw14Sse41(const uint8_t* rawData, size_t count, const Raw14Window& window, const uint32_t* packedPalette, uint8_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i min = _mm_set1_epi32(window.getMin());
+    const __m128i range = _mm_set1_epi32(static_cast<int>(window.getRange()));
+    const __m128i scale = _mm_set1_epi32(static_cast<int>(window.getScale()));
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i values = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rawData + i * 2)));
+        const __m128i offsets = _mm_min_epi32(_mm_max_epi32(_mm_sub_epi32(values, min), zero), range);
+        const __m128i indices = _mm_srli_epi32(_mm_mullo_epi32(offsets, scale), 16);
+
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, lookupPackedPalette(indices, packedPalette));
+    }
+
+    colorizeRaw14Scalar<FORMAT>(rawData + i * 2, count - i, window, packedPalette, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+CORE_TARGET_SSE41 inline __m128i shiftAndClampToUint8(__m128i value)
+{
+    return _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(value, 8), _mm_setzero_si128()), _mm_set1_epi32(255));
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 void colorizeRaw14WithLutSse41(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output)
+{
+    const __m128i lastIndex = _mm_set1_epi32(RAW14_LUT_SIZE - 1);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i values = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rawData + i * 2)));
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, lookupPackedPalette(_mm_min_epi32(values, lastIndex), lut));
+    }
+
+    colorizeRaw14WithLutScalar<FORMAT>(rawData + i * 2, count - i, lut, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+CORE_TARGET_SSE41 inline uint16_t reduceMin(__m128i values)
+{
+    return static_cast<uint16_t>(_mm_extract_epi16(_mm_minpos_epu16(values), 0));
+}
+
+CORE_TARGET_SSE41 inline uint16_t reduceMax(__m128i values)
+{
+    // max(x) = ~min(~x)
+    return static_cast<uint16_t>(0xffff - _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(values, _mm_set1_epi16(-1))), 0));
+}
+
+CORE_TARGET_SSE41 void findRaw14MinMaxSse41(const uint8_t* rawData, size_t count, uint16_t& min, uint16_t& max)
+{
+    __m128i minVector = _mm_set1_epi16(-1);
+    __m128i maxVector = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rawData + i * 2));
+        minVector = _mm_min_epu16(minVector, values);
+        maxVector = _mm_max_epu16(maxVector, values);
+    }
+
+    min = std::min(min, reduceMin(minVector));
+    max = std::max(max, reduceMax(maxVector));
+    findRaw14MinMaxScalar(rawData + i * 2, count - i, min, max);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 void colorizeRaw14WithLutAndFindMinMaxSse41(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output, uint16_t& min, uint16_t& max)
+{
+    const __m128i lastIndex = _mm_set1_epi32(RAW14_LUT_SIZE - 1);
+    __m128i minVector = _mm_set1_epi16(-1);
+    __m128i maxVector = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rawData + i * 2));
+        minVector = _mm_min_epu16(minVector, values);
+        maxVector = _mm_max_epu16(maxVector, values);
+
+        const __m128i lowValues = _mm_min_epi32(_mm_cvtepu16_epi32(values), lastIndex);
+        const __m128i highValues = _mm_min_epi32(_mm_cvtepu16_epi32(_mm_srli_si128(values, 8)), lastIndex);
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, lookupPackedPalette(lowValues, lut));
+        storePixels<FORMAT>(output + (i + 4) * BYTES_PER_PIXEL<FORMAT>, lookupPackedPalette(highValues, lut));
+    }
+
+    min = std::min(min, reduceMin(minVector));
+    max = std::max(max, reduceMax(maxVector));
+    colorizeRaw14WithLutAndFindMinMaxScalar<FORMAT>(rawData + i * 2, count - i, lut, output + i * BYTES_PER_PIXEL<FORMAT>, min, max);
+}
+
+// 32bit lanes y, u, v => packed pixels, same arithmetic as convertYuvToPixel
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 inline __m128i convertYuvToPixels(__m128i y, __m128i u, __m128i v, __m128i alpha)
+{
+    const __m128i rounding = _mm_set1_epi32(128);
+
+    const __m128i c = _mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(298)), rounding);
+    const __m128i d = _mm_sub_epi32(u, rounding);
+    const __m128i e = _mm_sub_epi32(v, rounding);
+
+    const __m128i r = shiftAndClampToUint8(_mm_add_epi32(c, _mm_mullo_epi32(e, _mm_set1_epi32(409))));
+    const __m128i g = shiftAndClampToUint8(_mm_sub_epi32(c, _mm_add_epi32(_mm_mullo_epi32(d, _mm_set1_epi32(100)), _mm_mullo_epi32(e, _mm_set1_epi32(208)))));
+    const __m128i b = shiftAndClampToUint8(_mm_add_epi32(c, _mm_mullo_epi32(d, _mm_set1_epi32(516))));
+
+    return packPixels<FORMAT>(r, g, b, alpha);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_SSE41 void convertYuyv422Sse41(const uint8_t* data, size_t pixelsCount, uint8_t alpha, uint8_t* output)
+{
+    const __m128i alphaVector = _mm_set1_epi32(alpha);
+    const __m128i yShuffle = _mm_setr_epi8(0, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i uShuffle = _mm_setr_epi8(1, 1, 5, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i vShuffle = _mm_setr_epi8(3, 3, 7, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    size_t i = 0;
+    for (; i + 4 <= pixelsCount; i += 4)
+    {
+        const __m128i input = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data + i * 2));
+        const __m128i y = _mm_cvtepu8_epi32(_mm_shuffle_epi8(input, yShuffle));
+        const __m128i u = _mm_cvtepu8_epi32(_mm_shuffle_epi8(input, uShuffle));
+        const __m128i v = _mm_cvtepu8_epi32(_mm_shuffle_epi8(input, vShuffle));
+
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, convertYuvToPixels<FORMAT>(y, u, v, alphaVector));
+    }
+
+    convertYuyv422Scalar<FORMAT>(data + i * 2, pixelsCount - i, alpha, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 inline __m256i packPixels(__m256i r, __m256i g, __m256i b, __m256i alpha)
+{
+    if constexpr (FORMAT == PixelFormat::ARGB)
+    {
+        return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(alpha, 24), _mm256_slli_epi32(r, 16)), _mm256_or_si256(_mm256_slli_epi32(g, 8), b));
+    }
+    else if constexpr (FORMAT == PixelFormat::BGRA)
+    {
+        return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(b, 24), _mm256_slli_epi32(g, 16)), _mm256_or_si256(_mm256_slli_epi32(r, 8), alpha));
+    }
+    else
+    {
+        return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)), _mm256_slli_epi32(b, 16));
+    }
+}
+
+// 8 packed pixels
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 inline void storePixels(uint8_t* output, __m256i pixels)
+{
+    if constexpr (BYTES_PER_PIXEL<FORMAT> == 4)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), pixels);
+    }
+    else
+    {
+        storePixels<FORMAT>(output, _mm256_castsi256_si128(pixels));
+        storePixels<FORMAT>(output + 4 * BYTES_PER_PIXEL<FORMAT>, _mm256_extracti128_si256(pixels, 1));
+    }
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 void colorizePaletteIndicesAvx2(const uint8_t* indices, size_t count, const uint32_t* packedPalette, uint8_t* output)
+{
+    const int* palette = reinterpret_cast<const int*>(packedPalette);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indexVector = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, _mm256_i32gather_epi32(palette, indexVector, 4));
+    }
+
+    colorizePaletteIndicesScalar<FORMAT>(indices + i, count - i, packedPalette, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 void colorizeRaw14Avx2(const uint8_t* rawData, size_t count, const Raw14Window& window, const uint32_t* packedPalette, uint8_t* output)
+{
+    const int* palette = reinterpret_cast<const int*>(packedPalette);
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i min = _mm256_set1_epi32(window.getMin());
+    const __m256i range = _mm256_set1_epi32(static_cast<int>(window.getRange()));
+    const __m256i scale = _mm256_set1_epi32(static_cast<int>(window.getScale()));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i values = simd::loadRaw16x8(rawData + i * 2);
+        const __m256i offsets = _mm256_min_epi32(_mm256_max_epi32(_mm256_sub_epi32(values, min), zero), range);
+        const __m256i indices = _mm256_srli_epi32(_mm256_mullo_epi32(offsets, scale), 16);
+
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, _mm256_i32gather_epi32(palette, indices, 4));
+    }
+
+    colorizeRaw14Scalar<FORMAT>(rawData + i * 2, count - i, window, packedPalette, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+CORE_TARGET_AVX2 inline __m256i shiftAndClampToUint8(__m256i value)
+{
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(value, 8), _mm256_setzero_si256()), _mm256_set1_epi32(255));
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 void colorizeRaw14WithLutAvx2(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output)
+{
+    const int* lutData = reinterpret_cast<const int*>(lut);
+    const __m256i lastIndex = _mm256_set1_epi32(RAW14_LUT_SIZE - 1);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i values = simd::loadRaw16x8(rawData + i * 2);
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, _mm256_i32gather_epi32(lutData, _mm256_min_epi32(values, lastIndex), 4));
+    }
+
+    colorizeRaw14WithLutScalar<FORMAT>(rawData + i * 2, count - i, lut, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+CORE_TARGET_AVX2 void findRaw14MinMaxAvx2(const uint8_t* rawData, size_t count, uint16_t& min, uint16_t& max)
+{
+    __m256i minVector = _mm256_set1_epi16(-1);
+    __m256i maxVector = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rawData + i * 2));
+        minVector = _mm256_min_epu16(minVector, values);
+        maxVector = _mm256_max_epu16(maxVector, values);
+    }
+
+    min = std::min(min, reduceMin(_mm_min_epu16(_mm256_castsi256_si128(minVector), _mm256_extracti128_si256(minVector, 1))));
+    max = std::max(max, reduceMax(_mm_max_epu16(_mm256_castsi256_si128(maxVector), _mm256_extracti128_si256(maxVector, 1))));
+    findRaw14MinMaxScalar(rawData + i * 2, count - i, min, max);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 void colorizeRaw14WithLutAndFindMinMaxAvx2(const uint8_t* rawData, size_t count, const uint32_t* lut, uint8_t* output, uint16_t& min, uint16_t& max)
+{
+    const int* lutData = reinterpret_cast<const int*>(lut);
+    const __m256i lastIndex = _mm256_set1_epi32(RAW14_LUT_SIZE - 1);
+    __m128i minVector = _mm_set1_epi16(-1);
+    __m128i maxVector = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rawData + i * 2));
+        minVector = _mm_min_epu16(minVector, values);
+        maxVector = _mm_max_epu16(maxVector, values);
+
+        const __m256i indices = _mm256_min_epi32(_mm256_cvtepu16_epi32(values), lastIndex);
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, _mm256_i32gather_epi32(lutData, indices, 4));
+    }
+
+    min = std::min(min, reduceMin(minVector));
+    max = std::max(max, reduceMax(maxVector));
+    colorizeRaw14WithLutAndFindMinMaxScalar<FORMAT>(rawData + i * 2, count - i, lut, output + i * BYTES_PER_PIXEL<FORMAT>, min, max);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 inline __m256i convertYuvToPixels(__m256i y, __m256i u, __m256i v, __m256i alpha)
+{
+    const __m256i rounding = _mm256_set1_epi32(128);
+
+    const __m256i c = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(16)), _mm256_set1_epi32(298)), rounding);
+    const __m256i d = _mm256_sub_epi32(u, rounding);
+    const __m256i e = _mm256_sub_epi32(v, rounding);
+
+    const __m256i r = shiftAndClampToUint8(_mm256_add_epi32(c, _mm256_mullo_epi32(e, _mm256_set1_epi32(409))));
+    const __m256i g = shiftAndClampToUint8(_mm256_sub_epi32(c, _mm256_add_epi32(_mm256_mullo_epi32(d, _mm256_set1_epi32(100)), _mm256_mullo_epi32(e, _mm256_set1_epi32(208)))));
+    const __m256i b = shiftAndClampToUint8(_mm256_add_epi32(c, _mm256_mullo_epi32(d, _mm256_set1_epi32(516))));
+
+    return packPixels<FORMAT>(r, g, b, alpha);
+}
+
+template<PixelFormat FORMAT>
+CORE_TARGET_AVX2 void convertYuyv422Avx2(const uint8_t* data, size_t pixelsCount, uint8_t alpha, uint8_t* output)
+{
+    const __m256i alphaVector = _mm256_set1_epi32(alpha);
+    const __m128i yShuffle = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i uShuffle = _mm_setr_epi8(1, 1, 5, 5, 9, 9, 13, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i vShuffle = _mm_setr_epi8(3, 3, 7, 7, 11, 11, 15, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    size_t i = 0;
+    for (; i + 8 <= pixelsCount; i += 8)
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 2));
+        const __m256i y = _mm256_cvtepu8_epi32(_mm_shuffle_epi8(input, yShuffle));
+        const __m256i u = _mm256_cvtepu8_epi32(_mm_shuffle_epi8(input, uShuffle));
+        const __m256i v = _mm256_cvtepu8_epi32(_mm_shuffle_epi8(input, vShuffle));
+
+        storePixels<FORMAT>(output + i * BYTES_PER_PIXEL<FORMAT>, convertYuvToPixels<FORMAT>(y, u, v, alphaVector));
+    }
+
+    convertYuyv422Scalar<FORMAT>(data + i * 2, pixelsCount - i, alpha, output + i * BYTES_PER_PIXEL<FORMAT>);
+}
+
+#endif // CORE_SIMD_X86
+
+} // namespace
+
+template<PixelFormat FORMAT>
+PackedPalette createPackedPalette(const Palette& palette, uint8_t alpha)
+{
+    PackedPalette packedPalette;
+    for (size_t i = 0; i < packedPalette.size(); ++i)
+    {
+        const auto& colors = palette.getRgb()[i];
+        packedPalette[i] = PixelFormatTraits<FORMAT>::pack(colors[Palette::INDEX_R], colors[Palette::INDEX_G], colors[Palette::INDEX_B], alpha);
+    }
+    return packedPalette;
+}
+
+Raw14Window Raw14Window::create(uint16_t min, uint16_t max)
+{
+    Raw14Window window;
+    window.m_min = min;
+    window.m_range = max > min ? max - min : 0;
+    // rounded up => range maps exactly to 255, product fits into 32 bits because offset <= range
+    window.m_scale = window.m_range == 0 ? 0 : ((255u << 16) + window.m_range - 1) / window.m_range;
+    return window;
+}
+
+uint16_t Raw14Window::getMin() const
+{
+    return m_min;
+}
+
+uint32_t Raw14Window::getRange() const
+{
+    return m_range;
+}
+
+uint32_t Raw14Window::getScale() const
+{
+    return m_scale;
+}
+
+template<PixelFormat FORMAT>
+void colorizePaletteIndices(std::span<const uint8_t> indices, const PackedPalette& packedPalette, std::span<uint8_t> output)
+{
+    assert(output.size() >= indices.size() * BYTES_PER_PIXEL<FORMAT>);
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        return colorizePaletteIndicesAvx2<FORMAT>(indices.data(), indices.size(), packedPalette.data(), output.data());
+    case simd::InstructionSet::SSE41:
+        return colorizePaletteIndicesSse41<FORMAT>(indices.data(), indices.size(), packedPalette.data(), output.data());
+#endif
+    default:
+        return colorizePaletteIndicesScalar<FORMAT>(indices.data(), indices.size(), packedPalette.data(), output.data());
+    }
+}
+
+template<PixelFormat FORMAT>
+void colorizeRaw14(std::span<const uint8_t> rawData, const Raw14Window& window, const PackedPalette& packedPalette, std::span<uint8_t> output)
+{
+    const size_t count = rawData.size() / 2;
+    assert(output.size() >= count * BYTES_PER_PIXEL<FORMAT>);
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        return colorizeRaw14Avx2<FORMAT>(rawData.data(), count, window, packedPalette.data(), output.data());
+    case simd::InstructionSet::SSE41:
+        return colorizeRaw14Sse41<FORMAT>(rawData.data(), count, window, packedPalette.data(), output.data());
+#endif
+    default:
+        return colorizeRaw14Scalar<FORMAT>(rawData.data(), count, window, packedPalette.data(), output.data());
+    }
+}
+
+std::pair<uint16_t, uint16_t> findRaw14MinMax(std::span<const uint8_t> rawData)
+{
+    uint16_t min = std::numeric_limits<uint16_t>::max();
+    uint16_t max = 0;
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        findRaw14MinMaxAvx2(rawData.data(), rawData.size() / 2, min, max);
+        break;
+    case simd::InstructionSet::SSE41:
+        findRaw14MinMaxSse41(rawData.data(), rawData.size() / 2, min, max);
+        break;
+#endif
+    default:
+        findRaw14MinMaxScalar(rawData.data(), rawData.size() / 2, min, max);
+        break;
+    }
+
+    return {min, max};
+}
+
+void fillRaw14Lut(const Raw14Window& window, const PackedPalette& packedPalette, Raw14Lut& lut)
+{
+    for (size_t value = 0; value < lut.size(); ++value)
+    {
+        lut[value] = packedPalette[window.getPaletteIndex(static_cast<uint16_t>(value))];
+    }
+}
+
+void fillRaw14Lut(const Raw14PaletteIndicesLut& paletteIndicesLut, const PackedPalette& packedPalette, Raw14Lut& lut)
+{
+    for (size_t value = 0; value < lut.size(); ++value)
+    {
+        lut[value] = packedPalette[paletteIndicesLut[value]];
+    }
+}
+
+template<PixelFormat FORMAT>
+void colorizeRaw14WithLut(std::span<const uint8_t> rawData, const Raw14Lut& lut, std::span<uint8_t> output)
+{
+    const size_t count = rawData.size() / 2;
+    assert(output.size() >= count * BYTES_PER_PIXEL<FORMAT>);
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        return colorizeRaw14WithLutAvx2<FORMAT>(rawData.data(), count, lut.data(), output.data());
+    case simd::InstructionSet::SSE41:
+        return colorizeRaw14WithLutSse41<FORMAT>(rawData.data(), count, lut.data(), output.data());
+#endif
+    default:
+        return colorizeRaw14WithLutScalar<FORMAT>(rawData.data(), count, lut.data(), output.data());
+    }
+}
+
+template<PixelFormat FORMAT>
+std::pair<uint16_t, uint16_t> colorizeRaw14WithLutAndFindMinMax(std::span<const uint8_t> rawData, const Raw14Lut& lut, std::span<uint8_t> output)
+{
+    const size_t count = rawData.size() / 2;
+    assert(output.size() >= count * BYTES_PER_PIXEL<FORMAT>);
+
+    uint16_t min = std::numeric_limits<uint16_t>::max();
+    uint16_t max = 0;
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        colorizeRaw14WithLutAndFindMinMaxAvx2<FORMAT>(rawData.data(), count, lut.data(), output.data(), min, max);
+        break;
+    case simd::InstructionSet::SSE41:
+        colorizeRaw14WithLutAndFindMinMaxSse41<FORMAT>(rawData.data(), count, lut.data(), output.data(), min, max);
+        break;
+#endif
+    default:
+        colorizeRaw14WithLutAndFindMinMaxScalar<FORMAT>(rawData.data(), count, lut.data(), output.data(), min, max);
+        break;
+    }
+
+    return {min, max};
+}
+
+template<PixelFormat FORMAT>
+void convertYuyv422(std::span<const uint8_t> data, uint8_t alpha, std::span<uint8_t> output)
+{
+    // incomplete pair at the end is ignored
+    const size_t pixelsCount = data.size() / 4 * 2;
+    assert(output.size() >= pixelsCount * BYTES_PER_PIXEL<FORMAT>);
+
+    switch (simd::getInstructionSet())
+    {
+#if defined(CORE_SIMD_X86)
+    case simd::InstructionSet::AVX2:
+        return convertYuyv422Avx2<FORMAT>(data.data(), pixelsCount, alpha, output.data());
+    case simd::InstructionSet::SSE41:
+        return convertYuyv422Sse41<FORMAT>(data.data(), pixelsCount, alpha, output.data());
+#endif
+    default:
+        return convertYuyv422Scalar<FORMAT>(data.data(), pixelsCount, alpha, output.data());
+    }
+}
+
+template PackedPalette createPackedPalette<PixelFormat::ARGB>(const Palette&, uint8_t);
+template PackedPalette createPackedPalette<PixelFormat::BGRA>(const Palette&, uint8_t);
+template PackedPalette createPackedPalette<PixelFormat::RGB24>(const Palette&, uint8_t);
+
+template void colorizePaletteIndices<PixelFormat::ARGB>(std::span<const uint8_t>, const PackedPalette&, std::span<uint8_t>);
+template void colorizePaletteIndices<PixelFormat::BGRA>(std::span<const uint8_t>, const PackedPalette&, std::span<uint8_t>);
+template void colorizePaletteIndices<PixelFormat::RGB24>(std::span<const uint8_t>, const PackedPalette&, std::span<uint8_t>);
+
+template void colorizeRaw14<PixelFormat::ARGB>(std::span<const uint8_t>, const Raw14Window&, const PackedPalette&, std::span<uint8_t>);
+template void colorizeRaw14<PixelFormat::BGRA>(std::span<const uint8_t>, const Raw14Window&, const PackedPalette&, std::span<uint8_t>);
+template void colorizeRaw14<PixelFormat::RGB24>(std::span<const uint8_t>, const Raw14Window&, const PackedPalette&, std::span<uint8_t>);
+
+template void colorizeRaw14WithLut<PixelFormat::ARGB>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+template void colorizeRaw14WithLut<PixelFormat::BGRA>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+template void colorizeRaw14WithLut<PixelFormat::RGB24>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+
+template std::pair<uint16_t, uint16_t> colorizeRaw14WithLutAndFindMinMax<PixelFormat::ARGB>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+template std::pair<uint16_t, uint16_t> colorizeRaw14WithLutAndFindMinMax<PixelFormat::BGRA>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+template std::pair<uint16_t, uint16_t> colorizeRaw14WithLutAndFindMinMax<PixelFormat::RGB24>(std::span<const uint8_t>, const Raw14Lut&, std::span<uint8_t>);
+
+template void convertYuyv422<PixelFormat::ARGB>(std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+template void convertYuyv422<PixelFormat::BGRA>(std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+template void convertYuyv422<PixelFormat::RGB24>(std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+
+} // namespace colorization
+
+} // namespace core
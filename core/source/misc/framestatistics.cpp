@@ -0,0 +1,600 @@
+#include "core/misc/framestatistics.h"
+
+#include "core/misc/colorizationkernels.h"
+#include "core/misc/instructionset.h"
+#include "core/misc/resultmacros.h"
+#include "core/misc/simdtarget.h"
+#include "core/execution.h"
+#include "core/utils.h"
+
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr size_t MIN_PIXELS_PER_BAND = 64 * 1024;
+
+constexpr size_t HISTOGRAM_SIZE = colorization::RAW14_LUT_SIZE;
+
+// row results of fused kernel, sums are prefix sums of row (continued by scalar tail)
+struct RowStatistics
+{
+    uint16_t min {0};
+    uint16_t max {0};
+    unsigned minColumn {0};
+    unsigned maxColumn {0};
+    uint64_t sum {0};
+    uint64_t squaresSum {0};
+};
+
+// summed area table rows (nullptr without tables)
+struct RowTables
+{
+    const uint64_t* previousSums {nullptr};
+    const uint64_t* previousSquaresSums {nullptr};
+    uint64_t* sums {nullptr};
+    uint64_t* squaresSums {nullptr};
+};
+
+inline void addToRowSums(uint32_t value, size_t column, RowStatistics& row, const RowTables& tables, uint32_t* histogram)
+{
+    ++histogram[std::min<uint32_t>(value, HISTOGRAM_SIZE - 1)];
+    row.sum += value;
+    row.squaresSum += value * value;
+    if (tables.sums != nullptr)
+    {
+        tables.sums[column + 1] = tables.previousSums[column + 1] + row.sum;
+        tables.squaresSums[column + 1] = tables.previousSquaresSums[column + 1] + row.squaresSum;
+    }
+}
+
+// columns from firstColumn to end of row, strict comparison keeps first occurrence
+void processRowScalar(std::span<const uint8_t> rowData, size_t firstColumn, RowStatistics& row, const RowTables& tables, uint32_t* histogram)
+{
+    const size_t width = rowData.size() / 2;
+    if (firstColumn == 0 && width > 0)
+    {
+        row.min = colorization::readRaw14(rowData.data(), 0);
+        row.max = row.min;
+    }
+
+    for (size_t column = firstColumn; column < width; ++column)
+    {
+        const uint16_t value = colorization::readRaw14(rowData.data(), column);
+        if (value < row.min)
+        {
+            row.min = value;
+            row.minColumn = static_cast<unsigned>(column);
+        }
+        if (value > row.max)
+        {
+            row.max = value;
+            row.maxColumn = static_cast<unsigned>(column);
+        }
+        addToRowSums(value, column, row, tables, histogram);
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+constexpr size_t AVX2_PIXELS = 16;
+// lane locations are chunk indices in 16bit lanes
+constexpr size_t AVX2_MAX_CHUNKS = std::numeric_limits<uint16_t>::max() + 1;
+
+// min/max with locations in lanes, sums in lanes (without tables) or prefix sums over stored chunk (with tables) and histogram in one pass over row
+// returns number of processed columns, rest is left to scalar
+CORE_TARGET_AVX2 size_t processRowAvx2(std::span<const uint8_t> rowData, RowStatistics& row, const RowTables& tables, uint32_t* histogram)
+{
+    const size_t chunksCount = rowData.size() / 2 / AVX2_PIXELS;
+    if (chunksCount == 0 || chunksCount > AVX2_MAX_CHUNKS)
+    {
+        return 0;
+    }
+
+    const auto* input = reinterpret_cast<const __m256i*>(rowData.data());
+    __m256i mins = _mm256_loadu_si256(input);
+    __m256i maxs = mins;
+    __m256i minChunks = _mm256_setzero_si256();
+    __m256i maxChunks = _mm256_setzero_si256();
+    __m256i sums = _mm256_setzero_si256();
+    __m256i squaresSums = _mm256_setzero_si256();
+
+    alignas(32) uint16_t values[AVX2_PIXELS];
+    for (size_t chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        const __m256i chunkValues = _mm256_loadu_si256(input + chunk);
+        const __m256i chunkIndex = _mm256_set1_epi16(static_cast<short>(chunk));
+
+        // lane keeps its chunk unless value is strictly better => first occurrence
+        const __m256i newMins = _mm256_min_epu16(mins, chunkValues);
+        minChunks = _mm256_blendv_epi8(chunkIndex, minChunks, _mm256_cmpeq_epi16(newMins, mins));
+        mins = newMins;
+        const __m256i newMaxs = _mm256_max_epu16(maxs, chunkValues);
+        maxChunks = _mm256_blendv_epi8(chunkIndex, maxChunks, _mm256_cmpeq_epi16(newMaxs, maxs));
+        maxs = newMaxs;
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values), chunkValues);
+        if (tables.sums != nullptr)
+        {
+            // table needs running prefix - serial dependency, sums come with it
+            for (size_t i = 0; i < AVX2_PIXELS; ++i)
+            {
+                addToRowSums(values[i], chunk * AVX2_PIXELS + i, row, tables, histogram);
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < AVX2_PIXELS; ++i)
+        {
+            ++histogram[std::min<uint32_t>(values[i], HISTOGRAM_SIZE - 1)];
+        }
+
+        // squares of 16bit values fit unsigned 32bit, accumulated in 64bit lanes
+        const __m256i low = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(chunkValues));
+        const __m256i high = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(chunkValues, 1));
+        const __m256i pairSums = _mm256_add_epi32(low, high);
+        sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(pairSums)));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(pairSums, 1)));
+        const __m256i lowSquares = _mm256_mullo_epi32(low, low);
+        const __m256i highSquares = _mm256_mullo_epi32(high, high);
+        squaresSums = _mm256_add_epi64(squaresSums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(lowSquares)));
+        squaresSums = _mm256_add_epi64(squaresSums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(lowSquares, 1)));
+        squaresSums = _mm256_add_epi64(squaresSums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(highSquares)));
+        squaresSums = _mm256_add_epi64(squaresSums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(highSquares, 1)));
+    }
+
+    if (tables.sums == nullptr)
+    {
+        alignas(32) uint64_t laneSums[4];
+        alignas(32) uint64_t laneSquaresSums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneSums), sums);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneSquaresSums), squaresSums);
+        row.sum = std::accumulate(std::begin(laneSums), std::end(laneSums), uint64_t(0));
+        row.squaresSum = std::accumulate(std::begin(laneSquaresSums), std::end(laneSquaresSums), uint64_t(0));
+    }
+
+    // lane with best value, lowest column among equal ones
+    alignas(32) uint16_t laneMins[AVX2_PIXELS];
+    alignas(32) uint16_t laneMaxs[AVX2_PIXELS];
+    alignas(32) uint16_t laneMinChunks[AVX2_PIXELS];
+    alignas(32) uint16_t laneMaxChunks[AVX2_PIXELS];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneMins), mins);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneMaxs), maxs);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneMinChunks), minChunks);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneMaxChunks), maxChunks);
+
+    row.min = laneMins[0];
+    row.max = laneMaxs[0];
+    row.minColumn = static_cast<unsigned>(laneMinChunks[0] * AVX2_PIXELS);
+    row.maxColumn = static_cast<unsigned>(laneMaxChunks[0] * AVX2_PIXELS);
+    for (size_t lane = 1; lane < AVX2_PIXELS; ++lane)
+    {
+        const auto minColumn = static_cast<unsigned>(laneMinChunks[lane] * AVX2_PIXELS + lane);
+        if (laneMins[lane] < row.min || (laneMins[lane] == row.min && minColumn < row.minColumn))
+        {
+            row.min = laneMins[lane];
+            row.minColumn = minColumn;
+        }
+        const auto maxColumn = static_cast<unsigned>(laneMaxChunks[lane] * AVX2_PIXELS + lane);
+        if (laneMaxs[lane] > row.max || (laneMaxs[lane] == row.max && maxColumn < row.maxColumn))
+        {
+            row.max = laneMaxs[lane];
+            row.maxColumn = maxColumn;
+        }
+    }
+
+    return chunksCount * AVX2_PIXELS;
+}
+
+#endif // CORE_SIMD_X86
+
+RowStatistics processRow(std::span<const uint8_t> rowData, const RowTables& tables, uint32_t* histogram)
+{
+    RowStatistics row;
+    size_t processedColumns = 0;
+#if defined(CORE_SIMD_X86)
+    if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+    {
+        processedColumns = processRowAvx2(rowData, row, tables, histogram);
+    }
+#endif
+
+    processRowScalar(rowData, processedColumns, row, tables, histogram);
+    return row;
+}
+
+// nearest rank, 0 based
+size_t getPercentileIndex(float percentile, uint64_t count)
+{
+    assert(count > 0);
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0f, 100.0f) / 100.0 * count));
+    return static_cast<size_t>(std::clamp<uint64_t>(rank, 1, count) - 1);
+}
+
+void setMeanAndStddev(FrameStatistics::Statistics& statistics, uint64_t sum, uint64_t squaresSum)
+{
+    if (statistics.pixelsCount == 0)
+    {
+        return;
+    }
+
+    const double count = static_cast<double>(statistics.pixelsCount);
+    statistics.mean = sum / count;
+    statistics.stddev = std::sqrt(std::max(0.0, squaresSum / count - statistics.mean * statistics.mean));
+}
+
+} // namespace
+
+FrameStatistics::FrameStatistics() :
+    FrameStatistics(Settings())
+{
+}
+
+FrameStatistics::FrameStatistics(const Settings& settings) :
+    m_settings(settings),
+    m_histogram(HISTOGRAM_SIZE, 0)
+{
+}
+
+const FrameStatistics::Settings& FrameStatistics::getSettings() const
+{
+    return m_settings;
+}
+
+void FrameStatistics::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+}
+
+const std::vector<FrameStatistics::Roi>& FrameStatistics::getRois() const
+{
+    return m_rois;
+}
+
+void FrameStatistics::setRois(const std::vector<Roi>& rois)
+{
+    m_rois = rois;
+}
+
+VoidResult FrameStatistics::compute(std::span<const uint8_t> rawData, const core::Size& size)
+{
+    const size_t width = size.isValid() ? size.width : 0;
+    const size_t height = size.isValid() ? size.height : 0;
+    if (width == 0 || rawData.size() != width * height * 2)
+    {
+        return VoidResult::createError("Unable to compute frame statistics!", utils::format("invalid frame - size: {}x{} data size: {}", size.width, size.height, rawData.size()));
+    }
+
+    if (const auto result = validateRois(size); !result.isOk())
+    {
+        return result;
+    }
+
+    m_size = size;
+
+    const size_t bandsCount = std::clamp<size_t>(width * height / MIN_PIXELS_PER_BAND, 1, std::min<size_t>(height, std::max(1u, std::thread::hardware_concurrency())));
+    const bool withTables = needsSummedAreaTables();
+    if (withTables)
+    {
+        const size_t tableSize = (width + 1) * (height + 1);
+        m_sumTable.resize(tableSize);
+        m_squaresSumTable.resize(tableSize);
+        std::fill_n(m_sumTable.begin(), width + 1, 0);
+        std::fill_n(m_squaresSumTable.begin(), width + 1, 0);
+    }
+
+    m_bands.resize(bandsCount);
+    m_partialHistograms.resize(bandsCount);
+    const auto bandRange = boost::irange(std::size_t(0), bandsCount);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ bandRange.begin(), bandRange.end(), [&](const std::size_t band)
+    {
+        computeBand(rawData, band, bandsCount, withTables);
+    });
+
+    if (withTables)
+    {
+        fixSummedAreaTables(bandsCount);
+    }
+
+    computeGlobalStatistics(width * height);
+
+    m_roiStatistics.resize(m_rois.size());
+    // pixels of detailed rois, capacity is kept between frames
+    m_roiValues.resize(m_settings.detailedRoiStatistics ? m_rois.size() : 0);
+    const auto roiRange = boost::irange(std::size_t(0), m_rois.size());
+    std::for_each(STD_EXECUTION_PAR_UNSEQ roiRange.begin(), roiRange.end(), [&](const std::size_t roi)
+    {
+        m_roiStatistics[roi] = computeRoiStatistics(rawData, m_rois[roi], m_settings.detailedRoiStatistics ? &m_roiValues[roi] : nullptr);
+    });
+
+    return VoidResult::createOk();
+}
+
+VoidResult FrameStatistics::compute(const ImageData& rawImageData, const core::Size& size)
+{
+    if (rawImageData.type != ImageData::Type::Raw14Bit)
+    {
+        return VoidResult::createError("Unable to compute frame statistics!", "raw 14bit frame expected");
+    }
+
+    return compute(rawImageData.data, size);
+}
+
+const FrameStatistics::Statistics& FrameStatistics::getGlobalStatistics() const
+{
+    return m_globalStatistics;
+}
+
+const std::vector<FrameStatistics::Statistics>& FrameStatistics::getRoiStatistics() const
+{
+    return m_roiStatistics;
+}
+
+const std::vector<uint32_t>& FrameStatistics::getHistogram() const
+{
+    return m_histogram;
+}
+
+VoidResult FrameStatistics::validateRois(const core::Size& size) const
+{
+    for (size_t i = 0; i < m_rois.size(); ++i)
+    {
+        const auto& roi = m_rois[i];
+        if (roi.width == 0 || roi.height == 0 || roi.column + roi.width > static_cast<unsigned>(size.width) || roi.row + roi.height > static_cast<unsigned>(size.height))
+        {
+            return VoidResult::createError("Invalid roi!", utils::format("roi {}: [r:{}, c:{}] {}x{} frame: {}x{}", i + 1, roi.row, roi.column, roi.width, roi.height, size.width, size.height));
+        }
+
+        if (!roi.mask.empty() && roi.mask.size() != static_cast<size_t>(roi.width) * roi.height)
+        {
+            return VoidResult::createError("Invalid roi!", utils::format("roi {}: mask size: {} expected: {}", i + 1, roi.mask.size(), static_cast<size_t>(roi.width) * roi.height));
+        }
+    }
+
+    return VoidResult::createOk();
+}
+
+bool FrameStatistics::needsSummedAreaTables() const
+{
+    return std::any_of(m_rois.begin(), m_rois.end(), [](const Roi& roi)
+    {
+        return roi.mask.empty();
+    });
+}
+
+void FrameStatistics::computeBand(std::span<const uint8_t> rawData, size_t band, size_t bandsCount, bool withTables)
+{
+    const size_t width = m_size.width;
+    const size_t height = m_size.height;
+    const size_t tableWidth = width + 1;
+    const size_t firstRow = band * height / bandsCount;
+    const size_t endRow = (band + 1) * height / bandsCount;
+
+    auto& histogram = m_partialHistograms[band];
+    histogram.assign(HISTOGRAM_SIZE, 0);
+
+    Band result;
+    for (size_t row = firstRow; row < endRow; ++row)
+    {
+        const auto rowData = rawData.subspan(row * width * 2, width * 2);
+
+        RowTables tables;
+        if (withTables)
+        {
+            // first row of band is relative to zero row, bands are made continuous afterwards
+            const size_t previousRow = row == firstRow ? 0 : row;
+            tables.previousSums = m_sumTable.data() + previousRow * tableWidth;
+            tables.previousSquaresSums = m_squaresSumTable.data() + previousRow * tableWidth;
+            tables.sums = m_sumTable.data() + (row + 1) * tableWidth;
+            tables.squaresSums = m_squaresSumTable.data() + (row + 1) * tableWidth;
+            tables.sums[0] = 0;
+            tables.squaresSums[0] = 0;
+        }
+
+        const auto rowStatistics = processRow(rowData, tables, histogram.data());
+        if (row == firstRow || rowStatistics.min < result.min)
+        {
+            result.min = rowStatistics.min;
+            result.minLocation = Location{static_cast<unsigned>(row), rowStatistics.minColumn};
+        }
+        if (row == firstRow || rowStatistics.max > result.max)
+        {
+            result.max = rowStatistics.max;
+            result.maxLocation = Location{static_cast<unsigned>(row), rowStatistics.maxColumn};
+        }
+
+        result.sum += rowStatistics.sum;
+        result.squaresSum += rowStatistics.squaresSum;
+    }
+
+    m_bands[band] = result;
+}
+
+void FrameStatistics::fixSummedAreaTables(size_t bandsCount)
+{
+    const size_t height = m_size.height;
+    const size_t tableWidth = m_size.width + 1;
+
+    // carry of band = sum of last rows of previous bands (last table row of band b - 1 is first row of band b)
+    std::vector<std::vector<uint64_t>> sumCarries(bandsCount, std::vector<uint64_t>(tableWidth, 0));
+    std::vector<std::vector<uint64_t>> squaresSumCarries(bandsCount, std::vector<uint64_t>(tableWidth, 0));
+    for (size_t band = 1; band < bandsCount; ++band)
+    {
+        const size_t lastRow = band * height / bandsCount;
+        std::transform(sumCarries[band - 1].begin(), sumCarries[band - 1].end(), m_sumTable.begin() + lastRow * tableWidth, sumCarries[band].begin(), std::plus<>());
+        std::transform(squaresSumCarries[band - 1].begin(), squaresSumCarries[band - 1].end(), m_squaresSumTable.begin() + lastRow * tableWidth, squaresSumCarries[band].begin(), std::plus<>());
+    }
+
+    const auto bandRange = boost::irange(std::size_t(1), bandsCount);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ bandRange.begin(), bandRange.end(), [&](const std::size_t band)
+    {
+        for (size_t row = band * height / bandsCount + 1; row <= (band + 1) * height / bandsCount; ++row)
+        {
+            std::transform(sumCarries[band].begin(), sumCarries[band].end(), m_sumTable.begin() + row * tableWidth, m_sumTable.begin() + row * tableWidth, std::plus<>());
+            std::transform(squaresSumCarries[band].begin(), squaresSumCarries[band].end(), m_squaresSumTable.begin() + row * tableWidth, m_squaresSumTable.begin() + row * tableWidth, std::plus<>());
+        }
+    });
+}
+
+void FrameStatistics::computeGlobalStatistics(size_t pixelsCount)
+{
+    m_histogram = m_partialHistograms.front();
+    for (size_t band = 1; band < m_partialHistograms.size(); ++band)
+    {
+        std::transform(m_histogram.begin(), m_histogram.end(), m_partialHistograms[band].begin(), m_histogram.begin(), std::plus<>());
+    }
+
+    Statistics statistics;
+    statistics.pixelsCount = pixelsCount;
+
+    uint64_t sum = 0;
+    uint64_t squaresSum = 0;
+    for (size_t band = 0; band < m_bands.size(); ++band)
+    {
+        const auto& bandResult = m_bands[band];
+        if (band == 0 || bandResult.min < statistics.min)
+        {
+            statistics.min = bandResult.min;
+            statistics.minLocation = bandResult.minLocation;
+        }
+        if (band == 0 || bandResult.max > statistics.max)
+        {
+            statistics.max = bandResult.max;
+            statistics.maxLocation = bandResult.maxLocation;
+        }
+        sum += bandResult.sum;
+        squaresSum += bandResult.squaresSum;
+    }
+    setMeanAndStddev(statistics, sum, squaresSum);
+
+    statistics.percentiles.reserve(m_settings.percentiles.size());
+    for (const auto percentile : m_settings.percentiles)
+    {
+        const size_t index = getPercentileIndex(percentile, pixelsCount);
+
+        size_t cumulative = 0;
+        size_t value = 0;
+        for (; value < m_histogram.size() - 1; ++value)
+        {
+            cumulative += m_histogram[value];
+            if (cumulative > index)
+            {
+                break;
+            }
+        }
+        statistics.percentiles.push_back(static_cast<uint16_t>(value));
+    }
+
+    m_globalStatistics = std::move(statistics);
+}
+
+FrameStatistics::Statistics FrameStatistics::computeRoiStatistics(std::span<const uint8_t> rawData, const Roi& roi, std::vector<uint16_t>* values) const
+{
+    const size_t width = m_size.width;
+    const size_t tableWidth = width + 1;
+
+    Statistics statistics;
+    uint64_t sum = 0;
+    uint64_t squaresSum = 0;
+
+    if (roi.mask.empty())
+    {
+        statistics.pixelsCount = static_cast<uint64_t>(roi.width) * roi.height;
+
+        const size_t topLeft = roi.row * tableWidth + roi.column;
+        const size_t topRight = topLeft + roi.width;
+        const size_t bottomLeft = topLeft + roi.height * tableWidth;
+        const size_t bottomRight = bottomLeft + roi.width;
+        sum = m_sumTable[bottomRight] - m_sumTable[topRight] - m_sumTable[bottomLeft] + m_sumTable[topLeft];
+        squaresSum = m_squaresSumTable[bottomRight] - m_squaresSumTable[topRight] - m_squaresSumTable[bottomLeft] + m_squaresSumTable[topLeft];
+
+        if (!m_settings.detailedRoiStatistics)
+        {
+            setMeanAndStddev(statistics, sum, squaresSum);
+            return statistics;
+        }
+    }
+
+    if (values != nullptr)
+    {
+        values->clear();
+        values->reserve(static_cast<size_t>(roi.width) * roi.height);
+    }
+
+    uint64_t maskedPixelsCount = 0;
+    for (unsigned row = 0; row < roi.height; ++row)
+    {
+        for (unsigned column = 0; column < roi.width; ++column)
+        {
+            if (!roi.mask.empty() && roi.mask[row * roi.width + column] == 0)
+            {
+                continue;
+            }
+
+            const uint32_t value = colorization::readRaw14(rawData.data(), (roi.row + row) * width + roi.column + column);
+            if (!roi.mask.empty())
+            {
+                ++maskedPixelsCount;
+                sum += value;
+                squaresSum += value * value;
+            }
+
+            if (values != nullptr)
+            {
+                if (values->empty() || value < statistics.min)
+                {
+                    statistics.min = static_cast<uint16_t>(value);
+                    statistics.minLocation = Location{roi.row + row, roi.column + column};
+                }
+                if (values->empty() || value > statistics.max)
+                {
+                    statistics.max = static_cast<uint16_t>(value);
+                    statistics.maxLocation = Location{roi.row + row, roi.column + column};
+                }
+                values->push_back(static_cast<uint16_t>(value));
+            }
+        }
+    }
+
+    if (!roi.mask.empty())
+    {
+        statistics.pixelsCount = maskedPixelsCount;
+    }
+    setMeanAndStddev(statistics, sum, squaresSum);
+
+    if (values != nullptr && !values->empty())
+    {
+        // ascending ranks => every nth_element works only on values above previous one
+        std::vector<size_t> order(m_settings.percentiles.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b)
+        {
+            return m_settings.percentiles[a] < m_settings.percentiles[b];
+        });
+
+        statistics.percentiles.resize(m_settings.percentiles.size());
+        auto first = values->begin();
+        for (const auto i : order)
+        {
+            const auto nth = values->begin() + getPercentileIndex(m_settings.percentiles[i], values->size());
+            std::nth_element(first, nth, values->end());
+            statistics.percentiles[i] = *nth;
+            first = nth;
+        }
+    }
+
+    return statistics;
+}
+
+} // namespace core
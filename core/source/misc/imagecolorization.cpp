@@ -1,91 +1,161 @@
 #include "core/misc/imagecolorization.h"
 
 #include "core/misc/palette.h"
+#include "core/misc/workerpool.h"
 #include "core/stream/imagedata.h"
 #include "core/execution.h"
 
 #include <boost/range/irange.hpp>
 
+#include <algorithm>
 #include <future>
+#include <memory>
+#include <span>
 
 namespace core
 {
 namespace
 {
-template<typename SetResultFunction>
-void mono8ColorizationWithPaletteImpl(const core::Palette& palette, const std::vector<uint8_t>& data, SetResultFunction&& setFn)
+// kernels run on chunks in parallel, chunk size is multiple of vector width and even (YUYV pairs)
+constexpr size_t CHUNK_PIXELS_COUNT = 32 * 1024;
+
+template<typename ChunkFunction>
+void forEachChunk(size_t pixelsCount, ChunkFunction&& chunkFunction)
 {
-    const auto idxRange = boost::irange(std::size_t(0), data.size());
-    std::for_each(STD_EXECUTION_PAR_UNSEQ idxRange.begin(), idxRange.end(), [&](const std::size_t idx)
+    const auto chunkRange = boost::irange(std::size_t(0), (pixelsCount + CHUNK_PIXELS_COUNT - 1) / CHUNK_PIXELS_COUNT);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ chunkRange.begin(), chunkRange.end(), [&](const std::size_t chunk)
     {
-        const auto& colors = palette.getRgb()[data[idx]];
-        setFn(idx, colors[core::Palette::INDEX_R], colors[core::Palette::INDEX_G], colors[core::Palette::INDEX_B]);
+        const size_t firstPixel = chunk * CHUNK_PIXELS_COUNT;
+        chunkFunction(firstPixel, std::min(CHUNK_PIXELS_COUNT, pixelsCount - firstPixel));
     });
 }
-} // namespace
 
-ImageData ImageColorization::mono8ColorizationWithPalette(const core::Palette& palette, const std::vector<uint8_t>& data)
+std::pair<uint16_t, uint16_t> findRaw14MinMaxParallel(std::span<const uint8_t> data)
 {
-    ImageData result{ImageData::Type::RGB};
-    result.data.resize(data.size() * core::Palette::COLOR_COMPONENT_COUNT);
-    mono8ColorizationWithPaletteImpl(palette, data, [&](const std::size_t idx, const int r, const int g, const int b)
+    const size_t pixelsCount = data.size() / 2;
+    std::vector<std::pair<uint16_t, uint16_t>> chunkMinMax((pixelsCount + CHUNK_PIXELS_COUNT - 1) / CHUNK_PIXELS_COUNT);
+    forEachChunk(pixelsCount, [&](size_t firstPixel, size_t count)
     {
-        const auto i = core::Palette::COLOR_COMPONENT_COUNT * idx;
-        result.data[i] = r;
-        result.data[i + 1] = g;
-        result.data[i + 2] = b;
+        chunkMinMax[firstPixel / CHUNK_PIXELS_COUNT] = colorization::findRaw14MinMax(data.subspan(firstPixel * 2, count * 2));
     });
-    return result;
+
+    uint16_t min = std::numeric_limits<uint16_t>::max();
+    uint16_t max = 0;
+    for (const auto& [chunkMin, chunkMax] : chunkMinMax)
+    {
+        min = std::min(min, chunkMin);
+        max = std::max(max, chunkMax);
+    }
+    return {min, max};
 }
 
-namespace
+size_t getPixelsCount(ImageData::Type type, size_t dataSize)
 {
-template<typename SetResultFunction>
-void mono14ColorizationWithPaletteImpl(const core::Palette& palette, const std::vector<uint8_t>& data, SetResultFunction&& setFn)
+    switch (type)
+    {
+    case ImageData::Type::Raw14Bit:
+        return dataSize / 2;
+    case ImageData::Type::PaletteIndices:
+        return dataSize;
+    case ImageData::Type::YUYV422:
+        return dataSize / 4 * 2;
+    case ImageData::Type::RGB:
+        break;
+    }
+    return 0;
+}
+
+template<colorization::PixelFormat FORMAT>
+void colorizeImageData(const colorization::PackedPalette& packedPalette, ImageData::Type type, std::span<const uint8_t> input, uint8_t alpha, std::span<uint8_t> output)
 {
-    const auto idxRange = boost::irange(std::size_t(0), data.size() / 2);
+    using namespace colorization;
 
-    uint16_t min = std::numeric_limits<uint16_t>::max();
-    uint16_t max = 0;
-    for (const auto idx : idxRange)
+    constexpr size_t BYTES_PER_PIXEL = PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL;
+    const size_t pixelsCount = getPixelsCount(type, input.size());
+    assert(output.size() >= pixelsCount * BYTES_PER_PIXEL);
+
+    switch (type)
+    {
+    case ImageData::Type::Raw14Bit:
     {
-        const uint16_t combined = static_cast<uint16_t>(data[idx * 2]) | (static_cast<uint16_t>(data[idx * 2 + 1]) << 8);
-        if (combined < min) min = combined;
-        if (combined > max) max = combined;
+        // flat frame => whole frame has first palette color
+        const auto [min, max] = findRaw14MinMaxParallel(input);
+        const auto window = Raw14Window::create(min, max);
+        forEachChunk(pixelsCount, [&](size_t firstPixel, size_t count)
+        {
+            colorizeRaw14<FORMAT>(input.subspan(firstPixel * 2, count * 2), window, packedPalette, output.subspan(firstPixel * BYTES_PER_PIXEL, count * BYTES_PER_PIXEL));
+        });
+        break;
     }
+    case ImageData::Type::PaletteIndices:
+    {
+        forEachChunk(pixelsCount, [&](size_t firstPixel, size_t count)
+        {
+            colorizePaletteIndices<FORMAT>(input.subspan(firstPixel, count), packedPalette, output.subspan(firstPixel * BYTES_PER_PIXEL, count * BYTES_PER_PIXEL));
+        });
+        break;
+    }
+    case ImageData::Type::YUYV422:
+        forEachChunk(pixelsCount, [&](size_t firstPixel, size_t count)
+        {
+            convertYuyv422<FORMAT>(input.subspan(firstPixel * 2, count * 2), alpha, output.subspan(firstPixel * BYTES_PER_PIXEL, count * BYTES_PER_PIXEL));
+        });
+        break;
+    case ImageData::Type::RGB:
+        assert(false && "Not implemented!");
+        break;
+    }
+}
 
-    const uint32_t range = max - min;
-    assert(range != 0);
-
-    std::for_each(STD_EXECUTION_PAR_UNSEQ idxRange.begin(), idxRange.end(), [&](const std::size_t idx)
+// custom pixel format is applied to palette colors only - kernels then just copy packed 32bit pixels
+colorization::PackedPalette createCustomPackedPalette(const core::Palette& palette, const ImageColorization::PixelFormatConversionFunction& pixelFormat, int alpha)
+{
+    colorization::PackedPalette packedPalette {};
+    for (size_t i = 0; i < packedPalette.size(); ++i)
     {
-        const uint16_t combined = static_cast<uint16_t>(data[idx * 2]) | (static_cast<uint16_t>(data[idx * 2 + 1]) << 8);
+        const auto& colors = palette.getRgb()[i];
+        packedPalette[i] = pixelFormat(colors[core::Palette::INDEX_R], colors[core::Palette::INDEX_G], colors[core::Palette::INDEX_B], alpha);
+    }
+    return packedPalette;
+}
 
-        float normalized = float(combined - min) / float(range);
-        uint8_t index = static_cast<uint8_t>(std::clamp(normalized * 255.0f, 0.0f, 255.0f));
+} // namespace
 
-        const auto& colors = palette.getRgb()[index];
-        setFn(idx, colors[core::Palette::INDEX_R], colors[core::Palette::INDEX_G], colors[core::Palette::INDEX_B]);
-    });
+ImageData ImageColorization::mono8ColorizationWithPalette(const core::Palette& palette, const std::vector<uint8_t>& data)
+{
+    using namespace colorization;
+
+    ImageData result{ImageData::Type::RGB};
+    result.data.resize(data.size() * PixelFormatTraits<PixelFormat::RGB24>::BYTES_PER_PIXEL);
+    colorizeImageData<PixelFormat::RGB24>(createPackedPalette<PixelFormat::RGB24>(palette, 0), ImageData::Type::PaletteIndices, data, 0, result.data);
+    return result;
 }
-} // namespace
 
 ImageData ImageColorization::mono14ColorizationWithPalette(const core::Palette& palette, const std::vector<uint8_t>& data)
 {
+    using namespace colorization;
+
     ImageData result{ImageData::Type::RGB};
-    result.data.resize(data.size() / 2 * core::Palette::COLOR_COMPONENT_COUNT);
-    mono14ColorizationWithPaletteImpl(palette, data, [&](const std::size_t idx, const int r, const int g, const int b)
-    {
-        const auto i = core::Palette::COLOR_COMPONENT_COUNT * idx;
-        result.data[i] = r;
-        result.data[i + 1] = g;
-        result.data[i + 2] = b;
-    });
+    result.data.resize(data.size() / 2 * PixelFormatTraits<PixelFormat::RGB24>::BYTES_PER_PIXEL);
+    colorizeImageData<PixelFormat::RGB24>(createPackedPalette<PixelFormat::RGB24>(palette, 0), ImageData::Type::Raw14Bit, data, 0, result.data);
     return result;
 }
 
 std::future<std::vector<uint32_t>> ImageColorization::getColorData(std::optional<core::Palette> palette, ImageData imageData, PixelFormatConversionFunction pixelFormat, int alpha)
 {
+    // known formats => vectorized kernels instead of call per pixel
+    if (const auto* function = pixelFormat.target<uint32_t(*)(int, int, int, int)>())
+    {
+        if (*function == &ARGB_PIXEL_FORMAT)
+        {
+            return getColorData<colorization::PixelFormat::ARGB>(std::move(palette), std::move(imageData), static_cast<uint8_t>(alpha));
+        }
+        if (*function == &BGRA_PIXEL_FORMAT)
+        {
+            return getColorData<colorization::PixelFormat::BGRA>(std::move(palette), std::move(imageData), static_cast<uint8_t>(alpha));
+        }
+    }
+
     switch (imageData.type)
     {
     case ImageData::Type::Raw14Bit:
@@ -103,70 +173,112 @@ std::future<std::vector<uint32_t>> ImageColorization::getColorData(std::optional
     return {};
 }
 
-std::future<std::vector<uint32_t>> core::ImageColorization::mono8ColorizationWithPaletteAsync(const core::Palette& palette, const std::vector<uint8_t>& data, PixelFormatConversionFunction pixelFormat, int alpha)
+template<colorization::PixelFormat FORMAT>
+std::future<ImageColorization::ColorData<FORMAT>> ImageColorization::getColorData(std::optional<core::Palette> palette, ImageData imageData, uint8_t alpha)
 {
-    return std::async(std::launch::async, [=]()
+    if (imageData.type == ImageData::Type::RGB)
     {
-        std::vector<uint32_t> result(data.size());
-        mono8ColorizationWithPaletteImpl(palette, data, [&](const std::size_t idx, const int r, const int g, const int b)
-        {
-            result[idx] = pixelFormat(r, g, b, alpha);
-        });
+        assert(false && "Not implemented!");
+        return {};
+    }
+
+    const auto packedPalette = colorization::createPackedPalette<FORMAT>(palette.value_or(core::Palette()), alpha);
+    return workerpool::run([packedPalette, imageData = std::move(imageData), alpha]()
+    {
+        using ValueType = typename ColorData<FORMAT>::value_type;
+
+        ColorData<FORMAT> result(getColorDataSize<FORMAT>(imageData.type, imageData.data.size()) / sizeof(ValueType));
+        colorizeImageData<FORMAT>(packedPalette, imageData.type, imageData.data, alpha, std::span(reinterpret_cast<uint8_t*>(result.data()), result.size() * sizeof(ValueType)));
         return result;
     });
 }
 
-std::future<std::vector<uint32_t>> core::ImageColorization::mono14ColorizationWithPaletteAsync(const core::Palette& palette, const std::vector<uint8_t>& rawData, PixelFormatConversionFunction pixelFormat, int alpha)
+template<colorization::PixelFormat FORMAT>
+size_t ImageColorization::getColorDataSize(ImageData::Type type, size_t dataSize)
 {
-    return std::async(std::launch::async, [=]()
-    {
-        std::vector<uint32_t> result(rawData.size() / 2);
-        mono14ColorizationWithPaletteImpl(palette, rawData, [&](const std::size_t idx, const int r, const int g, const int b)
-        {
-            result[idx] = pixelFormat(r, g, b, alpha);
-        });
-        return result;
-    });
+    return getPixelsCount(type, dataSize) * colorization::PixelFormatTraits<FORMAT>::BYTES_PER_PIXEL;
 }
 
-namespace
+template<colorization::PixelFormat FORMAT>
+void ImageColorization::colorize(const std::optional<core::Palette>& palette, ImageData::Type type, std::span<const uint8_t> data, uint8_t alpha, std::span<uint8_t> output)
 {
-static constexpr std::array<uint8_t, 3> CONVERT_YUV_TO_RGB(uint8_t y, uint8_t u, uint8_t v)
+    assert(type != ImageData::Type::RGB && "Not implemented!");
+
+    colorizeImageData<FORMAT>(colorization::createPackedPalette<FORMAT>(palette.value_or(core::Palette()), alpha), type, data, alpha, output);
+}
+
+template<colorization::PixelFormat FORMAT>
+std::future<void> ImageColorization::colorizeAsync(const std::optional<core::Palette>& palette, std::shared_ptr<const ImageData> imageData, uint8_t alpha, std::span<uint8_t> output)
 {
-    int c = y - 16;
-    int d = u - 128;
-    int e = v - 128;
+    assert(imageData != nullptr);
+    assert(imageData->type != ImageData::Type::RGB && "Not implemented!");
+
+    const auto packedPalette = colorization::createPackedPalette<FORMAT>(palette.value_or(core::Palette()), alpha);
+    return workerpool::run([packedPalette, imageData = std::move(imageData), alpha, output]()
+    {
+        colorizeImageData<FORMAT>(packedPalette, imageData->type, imageData->data, alpha, output);
+    });
+}
+
+template std::future<ImageColorization::ColorData<colorization::PixelFormat::ARGB>> ImageColorization::getColorData<colorization::PixelFormat::ARGB>(std::optional<core::Palette>, ImageData, uint8_t);
+template size_t ImageColorization::getColorDataSize<colorization::PixelFormat::ARGB>(ImageData::Type, size_t);
+template void ImageColorization::colorize<colorization::PixelFormat::ARGB>(const std::optional<core::Palette>&, ImageData::Type, std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+template std::future<void> ImageColorization::colorizeAsync<colorization::PixelFormat::ARGB>(const std::optional<core::Palette>&, std::shared_ptr<const ImageData>, uint8_t, std::span<uint8_t>);
 
-    auto clamp = [](int value) -> uint8_t {
-        return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
-    };
+template std::future<ImageColorization::ColorData<colorization::PixelFormat::BGRA>> ImageColorization::getColorData<colorization::PixelFormat::BGRA>(std::optional<core::Palette>, ImageData, uint8_t);
+template size_t ImageColorization::getColorDataSize<colorization::PixelFormat::BGRA>(ImageData::Type, size_t);
+template void ImageColorization::colorize<colorization::PixelFormat::BGRA>(const std::optional<core::Palette>&, ImageData::Type, std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+template std::future<void> ImageColorization::colorizeAsync<colorization::PixelFormat::BGRA>(const std::optional<core::Palette>&, std::shared_ptr<const ImageData>, uint8_t, std::span<uint8_t>);
 
-    uint8_t r = clamp((298 * c + 409 * e + 128) >> 8);
-    uint8_t g = clamp((298 * c - 100 * d - 208 * e + 128) >> 8);
-    uint8_t b = clamp((298 * c + 516 * d + 128) >> 8);
+template std::future<ImageColorization::ColorData<colorization::PixelFormat::RGB24>> ImageColorization::getColorData<colorization::PixelFormat::RGB24>(std::optional<core::Palette>, ImageData, uint8_t);
+template size_t ImageColorization::getColorDataSize<colorization::PixelFormat::RGB24>(ImageData::Type, size_t);
+template void ImageColorization::colorize<colorization::PixelFormat::RGB24>(const std::optional<core::Palette>&, ImageData::Type, std::span<const uint8_t>, uint8_t, std::span<uint8_t>);
+template std::future<void> ImageColorization::colorizeAsync<colorization::PixelFormat::RGB24>(const std::optional<core::Palette>&, std::shared_ptr<const ImageData>, uint8_t, std::span<uint8_t>);
 
-    return {r, g, b};
+std::future<std::vector<uint32_t>> core::ImageColorization::mono8ColorizationWithPaletteAsync(const core::Palette& palette, const std::vector<uint8_t>& data, PixelFormatConversionFunction pixelFormat, int alpha)
+{
+    const auto packedPalette = createCustomPackedPalette(palette, pixelFormat, alpha);
+    return workerpool::run([packedPalette, data]()
+    {
+        std::vector<uint32_t> result(data.size());
+        colorizeImageData<colorization::PixelFormat::ARGB>(packedPalette, ImageData::Type::PaletteIndices, data, 0, std::span(reinterpret_cast<uint8_t*>(result.data()), result.size() * sizeof(uint32_t)));
+        return result;
+    });
+}
+
+std::future<std::vector<uint32_t>> core::ImageColorization::mono14ColorizationWithPaletteAsync(const core::Palette& palette, const std::vector<uint8_t>& rawData, PixelFormatConversionFunction pixelFormat, int alpha)
+{
+    const auto packedPalette = createCustomPackedPalette(palette, pixelFormat, alpha);
+    return workerpool::run([packedPalette, rawData]()
+    {
+        std::vector<uint32_t> result(rawData.size() / 2);
+        colorizeImageData<colorization::PixelFormat::ARGB>(packedPalette, ImageData::Type::Raw14Bit, rawData, 0, std::span(reinterpret_cast<uint8_t*>(result.data()), result.size() * sizeof(uint32_t)));
+        return result;
+    });
 }
-} // namespace
 
 std::future<std::vector<uint32_t>> core::ImageColorization::YUYV422ColorizationAsync(const std::vector<uint8_t>& byteData, PixelFormatConversionFunction pixelFormat, int alpha)
 {
-    return std::async(std::launch::async, [=]()
+    return workerpool::run([byteData, pixelFormat, alpha]()
     {
-        std::vector<uint32_t> result(byteData.size() / 2);
-        const auto idxRange = boost::irange(std::size_t(0), result.size() / 2);
-        std::for_each(STD_EXECUTION_PAR_UNSEQ idxRange.begin(), idxRange.end(), [&](const std::size_t pairIdx)
-        {
-            uint8_t y = byteData[pairIdx * 4];
-            uint8_t u = byteData[pairIdx * 4 + 1];
-            uint8_t v = byteData[pairIdx * 4 + 3];
+        using namespace colorization;
+
+        constexpr size_t RGB_BYTES_PER_PIXEL = PixelFormatTraits<PixelFormat::RGB24>::BYTES_PER_PIXEL;
+        const size_t pixelsCount = getPixelsCount(ImageData::Type::YUYV422, byteData.size());
 
-            auto rgb = CONVERT_YUV_TO_RGB(y, u, v);
-            result[pairIdx * 2] = pixelFormat(rgb[core::Palette::INDEX_R], rgb[core::Palette::INDEX_G], rgb[core::Palette::INDEX_B], alpha);
+        std::vector<uint32_t> result(pixelsCount);
+        forEachChunk(pixelsCount, [&](size_t firstPixel, size_t count)
+        {
+            // yuv => rgb in vectorized kernel, custom function only packs the color
+            thread_local std::vector<uint8_t> rgbData;
+            rgbData.resize(count * RGB_BYTES_PER_PIXEL);
+            convertYuyv422<PixelFormat::RGB24>(std::span(byteData).subspan(firstPixel * 2, count * 2), 0, rgbData);
 
-            y = byteData[pairIdx * 4 + 2];
-            rgb = CONVERT_YUV_TO_RGB(y, u, v);
-            result[pairIdx * 2 + 1] = pixelFormat(rgb[core::Palette::INDEX_R], rgb[core::Palette::INDEX_G], rgb[core::Palette::INDEX_B], alpha);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint8_t* rgb = rgbData.data() + i * RGB_BYTES_PER_PIXEL;
+                result[firstPixel + i] = pixelFormat(rgb[0], rgb[1], rgb[2], alpha);
+            }
         });
 
         return result;
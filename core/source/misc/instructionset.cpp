@@ -0,0 +1,85 @@
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(CORE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace core
+{
+
+namespace simd
+{
+
+namespace
+{
+
+InstructionSet detectInstructionSet()
+{
+#if !defined(CORE_SIMD_X86)
+    return InstructionSet::SCALAR;
+#elif defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    if (osxsave && avx && maxLeaf >= 7 && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0)
+        {
+            return InstructionSet::AVX2;
+        }
+    }
+
+    return sse41 ? InstructionSet::SSE41 : InstructionSet::SCALAR;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return InstructionSet::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return InstructionSet::SSE41;
+    }
+    return InstructionSet::SCALAR;
+#endif
+}
+
+std::atomic<InstructionSet>& getInstructionSetStorage()
+{
+    static std::atomic<InstructionSet> instructionSet {getSupportedInstructionSet()};
+    return instructionSet;
+}
+
+} // namespace
+
+InstructionSet getSupportedInstructionSet()
+{
+    static const InstructionSet instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+InstructionSet getInstructionSet()
+{
+    return getInstructionSetStorage().load(std::memory_order_relaxed);
+}
+
+void setInstructionSet(InstructionSet instructionSet)
+{
+    getInstructionSetStorage().store(std::min(instructionSet, getSupportedInstructionSet()), std::memory_order_relaxed);
+}
+
+} // namespace simd
+
+} // namespace core
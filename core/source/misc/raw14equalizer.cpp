@@ -0,0 +1,208 @@
+#include "core/misc/raw14equalizer.h"
+
+#include "core/execution.h"
+
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+namespace
+{
+
+// smaller frames are not worth splitting among threads
+constexpr size_t MIN_PIXELS_PER_PART = 64 * 1024;
+
+inline uint16_t readRaw14Clamped(std::span<const uint8_t> rawData, size_t index)
+{
+    return std::min<uint16_t>(readRaw14(rawData.data(), index), RAW14_LUT_SIZE - 1);
+}
+
+} // namespace
+
+Raw14Equalizer::Raw14Equalizer() :
+    Raw14Equalizer(Settings())
+{
+}
+
+Raw14Equalizer::Raw14Equalizer(const Settings& settings) :
+    m_histogram(RAW14_LUT_SIZE, 0),
+    m_targetMapping(RAW14_LUT_SIZE, 0.0f),
+    m_mapping(RAW14_LUT_SIZE, 0.0f)
+{
+    setSettings(settings);
+}
+
+const Raw14Equalizer::Settings& Raw14Equalizer::getSettings() const
+{
+    return m_settings;
+}
+
+void Raw14Equalizer::setSettings(const Settings& settings)
+{
+    assert(settings.clipLimit >= 1 && settings.clipLimit <= 100);
+    assert(settings.tailRejection <= 49);
+
+    m_settings = settings;
+    m_settings.clipLimit = std::clamp(settings.clipLimit, 1u, 100u);
+    m_settings.tailRejection = std::min(settings.tailRejection, 49u);
+    m_settings.linearWeight = std::clamp(settings.linearWeight, 0.0f, 1.0f);
+    m_settings.temporalSmoothing = std::clamp(settings.temporalSmoothing, 0.0f, 0.99f);
+}
+
+void Raw14Equalizer::reset()
+{
+    m_hasMapping = false;
+}
+
+void Raw14Equalizer::update(std::span<const uint8_t> rawData)
+{
+    const size_t pixelsCount = rawData.size() / 2;
+    if (pixelsCount == 0)
+    {
+        return;
+    }
+
+    computeHistogram(rawData);
+    computeMapping(pixelsCount);
+}
+
+void Raw14Equalizer::mapToPaletteIndices(std::span<const uint8_t> rawData, std::span<uint8_t> output) const
+{
+    assert(output.size() >= rawData.size() / 2);
+
+    const auto idxRange = boost::irange(std::size_t(0), rawData.size() / 2);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ idxRange.begin(), idxRange.end(), [&](const std::size_t idx)
+    {
+        output[idx] = m_paletteIndicesLut[readRaw14Clamped(rawData, idx)];
+    });
+}
+
+ImageData Raw14Equalizer::equalize(const ImageData& rawImageData)
+{
+    assert(rawImageData.type == ImageData::Type::Raw14Bit);
+
+    update(rawImageData.data);
+
+    ImageData result{ImageData::Type::PaletteIndices};
+    result.data.resize(rawImageData.data.size() / 2);
+    result.metadata = rawImageData.metadata;
+    mapToPaletteIndices(rawImageData.data, result.data);
+    return result;
+}
+
+const Raw14PaletteIndicesLut& Raw14Equalizer::getPaletteIndicesLut() const
+{
+    return m_paletteIndicesLut;
+}
+
+void Raw14Equalizer::computeHistogram(std::span<const uint8_t> rawData)
+{
+    const size_t pixelsCount = rawData.size() / 2;
+    const size_t partsCount = std::clamp<size_t>(pixelsCount / MIN_PIXELS_PER_PART, 1, std::max(1u, std::thread::hardware_concurrency()));
+
+    // per part histograms => no atomics, merged afterwards
+    m_partialHistograms.resize(partsCount);
+    const auto partRange = boost::irange(std::size_t(0), partsCount);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ partRange.begin(), partRange.end(), [&](const std::size_t part)
+    {
+        auto& histogram = m_partialHistograms[part];
+        histogram.assign(RAW14_LUT_SIZE, 0);
+
+        const size_t end = (part + 1) * pixelsCount / partsCount;
+        for (size_t idx = part * pixelsCount / partsCount; idx < end; ++idx)
+        {
+            ++histogram[readRaw14Clamped(rawData, idx)];
+        }
+    });
+
+    m_histogram = m_partialHistograms.front();
+    for (size_t part = 1; part < partsCount; ++part)
+    {
+        std::transform(m_histogram.begin(), m_histogram.end(), m_partialHistograms[part].begin(), m_histogram.begin(), std::plus<>());
+    }
+}
+
+void Raw14Equalizer::computeMapping(size_t pixelsCount)
+{
+    // tails
+    const size_t rejectedCount = pixelsCount * m_settings.tailRejection / 100;
+
+    size_t low = 0;
+    for (size_t count = 0; low < RAW14_LUT_SIZE - 1; ++low)
+    {
+        count += m_histogram[low];
+        if (count > rejectedCount)
+        {
+            break;
+        }
+    }
+
+    size_t high = RAW14_LUT_SIZE - 1;
+    for (size_t count = 0; high > 0; --high)
+    {
+        count += m_histogram[high];
+        if (count > rejectedCount)
+        {
+            break;
+        }
+    }
+
+    auto& target = m_targetMapping;
+    std::fill(target.begin(), target.end(), 0.0f);
+    if (high <= low)
+    {
+        // flat frame => first palette color, same as linear colorization
+        std::fill(target.begin() + low + 1, target.end(), 255.0f);
+    }
+    else
+    {
+        // plateau
+        size_t occupiedBins = 0;
+        size_t windowCount = 0;
+        for (size_t value = low; value <= high; ++value)
+        {
+            occupiedBins += m_histogram[value] != 0 ? 1 : 0;
+            windowCount += m_histogram[value];
+        }
+        const float plateau = std::max(1.0f, float(windowCount) / float(occupiedBins) * float(m_settings.clipLimit) / 10.0f);
+
+        float clippedTotal = 0.0f;
+        for (size_t value = low; value <= high; ++value)
+        {
+            clippedTotal += std::min(float(m_histogram[value]), plateau);
+        }
+
+        float cumulative = 0.0f;
+        for (size_t value = low; value <= high; ++value)
+        {
+            cumulative += std::min(float(m_histogram[value]), plateau);
+
+            const float equalized = 255.0f * cumulative / clippedTotal;
+            const float linear = 255.0f * float(value - low) / float(high - low);
+            target[value] = m_settings.linearWeight * linear + (1.0f - m_settings.linearWeight) * equalized;
+        }
+        std::fill(target.begin() + high + 1, target.end(), 255.0f);
+    }
+
+    // temporal smoothing of mapping, not of image => no ghosting of moving objects
+    const float smoothing = m_hasMapping ? m_settings.temporalSmoothing : 0.0f;
+    for (size_t value = 0; value < RAW14_LUT_SIZE; ++value)
+    {
+        m_mapping[value] = smoothing * m_mapping[value] + (1.0f - smoothing) * target[value];
+        m_paletteIndicesLut[value] = static_cast<uint8_t>(std::clamp(m_mapping[value] + 0.5f, 0.0f, 255.0f));
+    }
+    m_hasMapping = true;
+}
+
+} // namespace colorization
+
+} // namespace core
@@ -0,0 +1,105 @@
+#include "core/misc/raw14lutcolorizer.h"
+
+#include <cstdlib>
+
+
+namespace core
+{
+
+namespace colorization
+{
+
+template<PixelFormat FORMAT>
+Raw14LutColorizer<FORMAT>::Raw14LutColorizer(const Palette& palette, uint8_t alpha, uint16_t windowThreshold) :
+    m_alpha(alpha),
+    m_windowThreshold(windowThreshold),
+    m_packedPalette(createPackedPalette<FORMAT>(palette, alpha)),
+    m_lut(std::make_unique<Raw14Lut>())
+{
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::setPalette(const Palette& palette, uint8_t alpha)
+{
+    const auto packedPalette = createPackedPalette<FORMAT>(palette, alpha);
+    if (packedPalette != m_packedPalette)
+    {
+        m_alpha = alpha;
+        m_packedPalette = packedPalette;
+        m_lutMinMax.reset();
+    }
+}
+
+template<PixelFormat FORMAT>
+uint16_t Raw14LutColorizer<FORMAT>::getWindowThreshold() const
+{
+    return m_windowThreshold;
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::setWindowThreshold(uint16_t windowThreshold)
+{
+    m_windowThreshold = windowThreshold;
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::colorize(std::span<const uint8_t> rawData, std::span<uint8_t> output)
+{
+    const auto [min, max] = findRaw14MinMax(rawData);
+    colorize(rawData, min, max, output);
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::colorize(std::span<const uint8_t> rawData, uint16_t min, uint16_t max, std::span<uint8_t> output)
+{
+    updateLut(min, max);
+    colorizeRaw14WithLut<FORMAT>(rawData, *m_lut, output);
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::colorizeWithPreviousWindow(std::span<const uint8_t> rawData, std::span<uint8_t> output)
+{
+    if (!m_lutMinMax.has_value())
+    {
+        return colorize(rawData, output);
+    }
+
+    const auto [min, max] = colorizeRaw14WithLutAndFindMinMax<FORMAT>(rawData, *m_lut, output);
+    updateLut(min, max);
+}
+
+template<PixelFormat FORMAT>
+const Raw14Window& Raw14LutColorizer<FORMAT>::getWindow() const
+{
+    return m_window;
+}
+
+template<PixelFormat FORMAT>
+size_t Raw14LutColorizer<FORMAT>::getLutRebuildsCount() const
+{
+    return m_lutRebuildsCount;
+}
+
+template<PixelFormat FORMAT>
+void Raw14LutColorizer<FORMAT>::updateLut(uint16_t min, uint16_t max)
+{
+    if (m_lutMinMax.has_value() &&
+        std::abs(int(min) - int(m_lutMinMax->first)) <= m_windowThreshold &&
+        std::abs(int(max) - int(m_lutMinMax->second)) <= m_windowThreshold)
+    {
+        return;
+    }
+
+    m_lutMinMax = std::make_pair(min, max);
+    m_window = Raw14Window::create(min, max);
+    fillRaw14Lut(m_window, m_packedPalette, *m_lut);
+    ++m_lutRebuildsCount;
+}
+
+template class Raw14LutColorizer<PixelFormat::ARGB>;
+template class Raw14LutColorizer<PixelFormat::BGRA>;
+template class Raw14LutColorizer<PixelFormat::RGB24>;
+
+} // namespace colorization
+
+} // namespace core
@@ -0,0 +1,392 @@
+#include "core/misc/temporalfilter.h"
+
+#include "core/misc/colorizationkernels.h"
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+#include "core/utils.h"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdlib>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr unsigned FRACTION_BITS = 15;
+constexpr int32_t FIXED_HALF = 1 << (FRACTION_BITS - 1);
+
+inline void storePixel(uint8_t* rawData, size_t index, uint32_t value)
+{
+    boost::endian::store_little_u16(rawData + index * 2, static_cast<uint16_t>(value));
+}
+
+inline int32_t toFixed(uint16_t value)
+{
+    return static_cast<int32_t>(value) << FRACTION_BITS;
+}
+
+void addToSumsScalar(const uint8_t* added, const uint8_t* removed, uint32_t* sums, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        sums[i] += colorization::readRaw14(added, i) - (removed != nullptr ? colorization::readRaw14(removed, i) : 0u);
+    }
+}
+
+void meanScalar(const uint32_t* sums, uint32_t framesCount, uint8_t* output, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        storePixel(output, i, (sums[i] + framesCount / 2) / framesCount);
+    }
+}
+
+void initAveragesScalar(const uint8_t* input, int32_t* averages, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        averages[i] = toFixed(colorization::readRaw14(input, i));
+    }
+}
+
+void exponentialScalar(const uint8_t* input, int32_t* averages, size_t count, unsigned shift)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        averages[i] += (toFixed(colorization::readRaw14(input, i)) - averages[i]) >> shift;
+    }
+}
+
+void motionGatedScalar(const uint8_t* input, int32_t* averages, size_t count, unsigned shift, int32_t threshold)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int32_t value = toFixed(colorization::readRaw14(input, i));
+        const int32_t difference = value - averages[i];
+        averages[i] = std::abs(difference) > threshold ? value : averages[i] + (difference >> shift);
+    }
+}
+
+void averagesToOutputScalar(const int32_t* averages, uint8_t* output, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        storePixel(output, i, static_cast<uint32_t>((averages[i] + FIXED_HALF) >> FRACTION_BITS));
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+// accumulators are aligned, 8 pixels per iteration keeps alignment
+CORE_TARGET_AVX2 size_t addToSumsAvx2(const uint8_t* added, const uint8_t* removed, uint32_t* sums, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto* sumsPointer = reinterpret_cast<__m256i*>(sums + i);
+        __m256i values = _mm256_add_epi32(_mm256_load_si256(sumsPointer), simd::loadRaw16x8(added + i * 2));
+        if (removed != nullptr)
+        {
+            values = _mm256_sub_epi32(values, simd::loadRaw16x8(removed + i * 2));
+        }
+        _mm256_store_si256(sumsPointer, values);
+    }
+
+    return i;
+}
+
+// sums are below 2^31 - exact in double, correctly rounded division => same result as integer division
+CORE_TARGET_AVX2 size_t meanAvx2(const uint32_t* sums, uint32_t framesCount, uint8_t* output, size_t count)
+{
+    const __m256i half = _mm256_set1_epi32(framesCount / 2);
+    const __m256d divisor = _mm256_set1_pd(framesCount);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i values = _mm256_add_epi32(_mm256_load_si256(reinterpret_cast<const __m256i*>(sums + i)), half);
+        const __m128i low = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(values)), divisor));
+        const __m128i high = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)), divisor));
+        simd::storeRaw16x8(output + i * 2, _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1));
+    }
+
+    return i;
+}
+
+CORE_TARGET_AVX2 size_t exponentialAvx2(const uint8_t* input, int32_t* averages, size_t count, unsigned shift)
+{
+    const __m128i shiftCount = _mm_cvtsi32_si128(static_cast<int>(shift));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto* averagesPointer = reinterpret_cast<__m256i*>(averages + i);
+        const __m256i average = _mm256_load_si256(averagesPointer);
+        const __m256i difference = _mm256_sub_epi32(_mm256_slli_epi32(simd::loadRaw16x8(input + i * 2), FRACTION_BITS), average);
+        _mm256_store_si256(averagesPointer, _mm256_add_epi32(average, _mm256_sra_epi32(difference, shiftCount)));
+    }
+
+    return i;
+}
+
+CORE_TARGET_AVX2 size_t motionGatedAvx2(const uint8_t* input, int32_t* averages, size_t count, unsigned shift, int32_t threshold)
+{
+    const __m128i shiftCount = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m256i thresholds = _mm256_set1_epi32(threshold);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto* averagesPointer = reinterpret_cast<__m256i*>(averages + i);
+        const __m256i average = _mm256_load_si256(averagesPointer);
+        const __m256i value = _mm256_slli_epi32(simd::loadRaw16x8(input + i * 2), FRACTION_BITS);
+        const __m256i difference = _mm256_sub_epi32(value, average);
+
+        const __m256i moved = _mm256_cmpgt_epi32(_mm256_abs_epi32(difference), thresholds);
+        const __m256i smoothed = _mm256_add_epi32(average, _mm256_sra_epi32(difference, shiftCount));
+        _mm256_store_si256(averagesPointer, _mm256_blendv_epi8(smoothed, value, moved));
+    }
+
+    return i;
+}
+
+CORE_TARGET_AVX2 size_t averagesToOutputAvx2(const int32_t* averages, uint8_t* output, size_t count)
+{
+    const __m256i half = _mm256_set1_epi32(FIXED_HALF);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i average = _mm256_load_si256(reinterpret_cast<const __m256i*>(averages + i));
+        simd::storeRaw16x8(output + i * 2, _mm256_srai_epi32(_mm256_add_epi32(average, half), FRACTION_BITS));
+    }
+
+    return i;
+}
+
+#endif // CORE_SIMD_X86
+
+} // namespace
+
+TemporalFilter::TemporalFilter() :
+    TemporalFilter(Settings())
+{
+}
+
+TemporalFilter::TemporalFilter(const Settings& settings)
+{
+    [[maybe_unused]] const auto result = setSettings(settings);
+    assert(result.isOk());
+}
+
+const TemporalFilter::Settings& TemporalFilter::getSettings() const
+{
+    return m_settings;
+}
+
+VoidResult TemporalFilter::setSettings(const Settings& settings)
+{
+    if (settings.windowSize < 1 || settings.windowSize > MAX_WINDOW_SIZE)
+    {
+        return VoidResult::createError("Invalid temporal filter settings!", utils::format("window size: {} allowed: 1 - {}", settings.windowSize, MAX_WINDOW_SIZE));
+    }
+
+    if (settings.smoothingShift < 1 || settings.smoothingShift > MAX_SMOOTHING_SHIFT)
+    {
+        return VoidResult::createError("Invalid temporal filter settings!", utils::format("smoothing shift: {} allowed: 1 - {}", settings.smoothingShift, MAX_SMOOTHING_SHIFT));
+    }
+
+    if (settings != m_settings)
+    {
+        m_settings = settings;
+        reset();
+    }
+
+    return VoidResult::createOk();
+}
+
+void TemporalFilter::reset()
+{
+    m_framesCount = 0;
+    m_windowPosition = 0;
+}
+
+size_t TemporalFilter::getFramesCount() const
+{
+    if (m_settings.mode == Mode::RUNNING_MEAN)
+    {
+        return std::min<size_t>(m_framesCount, m_settings.windowSize);
+    }
+
+    return m_framesCount;
+}
+
+VoidResult TemporalFilter::addFrame(std::span<const uint8_t> rawData)
+{
+    const size_t pixelsCount = rawData.size() / 2;
+    if (pixelsCount == 0 || rawData.size() % 2 != 0)
+    {
+        return VoidResult::createError("Unable to add frame!", utils::format("invalid frame size: {}", rawData.size()));
+    }
+
+    // buffers keep their capacity over resets
+    if (m_framesCount == 0)
+    {
+        m_pixelsCount = pixelsCount;
+        if (m_settings.mode == Mode::RUNNING_MEAN)
+        {
+            m_sums.assign(pixelsCount, 0);
+            m_window.resize(rawData.size() * m_settings.windowSize);
+        }
+        else
+        {
+            m_averages.resize(pixelsCount);
+        }
+    }
+    else if (pixelsCount != m_pixelsCount)
+    {
+        return VoidResult::createError("Unable to add frame!", utils::format("frame size: {} expected: {}", pixelsCount, m_pixelsCount));
+    }
+
+    switch (m_settings.mode)
+    {
+    case Mode::RUNNING_MEAN:
+    {
+        // oldest frame of full window is replaced by new one
+        uint8_t* slot = m_window.data() + m_windowPosition * rawData.size();
+        const uint8_t* removed = m_framesCount >= m_settings.windowSize ? slot : nullptr;
+
+        size_t vectorized = 0;
+#if defined(CORE_SIMD_X86)
+        if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+        {
+            vectorized = addToSumsAvx2(rawData.data(), removed, m_sums.data(), pixelsCount);
+        }
+#endif
+        addToSumsScalar(rawData.data() + vectorized * 2, removed != nullptr ? removed + vectorized * 2 : nullptr, m_sums.data() + vectorized, pixelsCount - vectorized);
+
+        std::copy(rawData.begin(), rawData.end(), slot);
+        m_windowPosition = (m_windowPosition + 1) % m_settings.windowSize;
+        break;
+    }
+
+    case Mode::EXPONENTIAL:
+    case Mode::MOTION_GATED:
+    {
+        if (m_framesCount == 0)
+        {
+            initAveragesScalar(rawData.data(), m_averages.data(), pixelsCount);
+            break;
+        }
+
+        const int32_t threshold = toFixed(m_settings.motionThreshold);
+        size_t vectorized = 0;
+#if defined(CORE_SIMD_X86)
+        if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+        {
+            vectorized = m_settings.mode == Mode::EXPONENTIAL ? exponentialAvx2(rawData.data(), m_averages.data(), pixelsCount, m_settings.smoothingShift)
+                                                              : motionGatedAvx2(rawData.data(), m_averages.data(), pixelsCount, m_settings.smoothingShift, threshold);
+        }
+#endif
+        if (m_settings.mode == Mode::EXPONENTIAL)
+        {
+            exponentialScalar(rawData.data() + vectorized * 2, m_averages.data() + vectorized, pixelsCount - vectorized, m_settings.smoothingShift);
+        }
+        else
+        {
+            motionGatedScalar(rawData.data() + vectorized * 2, m_averages.data() + vectorized, pixelsCount - vectorized, m_settings.smoothingShift, threshold);
+        }
+        break;
+    }
+    }
+
+    ++m_framesCount;
+    return VoidResult::createOk();
+}
+
+VoidResult TemporalFilter::addFrame(std::span<const uint16_t> frame)
+{
+    static_assert(std::endian::native == std::endian::little, "Frame is processed as little endian raw data!");
+
+    return addFrame(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(frame.data()), frame.size_bytes()));
+}
+
+VoidResult TemporalFilter::getAverage(std::span<uint8_t> rawOutput) const
+{
+    if (m_framesCount == 0)
+    {
+        return VoidResult::createError("Unable to get average!", "no frames added");
+    }
+
+    if (rawOutput.size() != m_pixelsCount * 2)
+    {
+        return VoidResult::createError("Unable to get average!", utils::format("output size: {} expected: {}", rawOutput.size(), m_pixelsCount * 2));
+    }
+
+    size_t vectorized = 0;
+    if (m_settings.mode == Mode::RUNNING_MEAN)
+    {
+        const auto framesCount = static_cast<uint32_t>(getFramesCount());
+#if defined(CORE_SIMD_X86)
+        if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+        {
+            vectorized = meanAvx2(m_sums.data(), framesCount, rawOutput.data(), m_pixelsCount);
+        }
+#endif
+        meanScalar(m_sums.data() + vectorized, framesCount, rawOutput.data() + vectorized * 2, m_pixelsCount - vectorized);
+    }
+    else
+    {
+#if defined(CORE_SIMD_X86)
+        if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+        {
+            vectorized = averagesToOutputAvx2(m_averages.data(), rawOutput.data(), m_pixelsCount);
+        }
+#endif
+        averagesToOutputScalar(m_averages.data() + vectorized, rawOutput.data() + vectorized * 2, m_pixelsCount - vectorized);
+    }
+
+    return VoidResult::createOk();
+}
+
+VoidResult TemporalFilter::getAverage(std::span<uint16_t> output) const
+{
+    return getAverage(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes()));
+}
+
+VoidResult TemporalFilter::filter(const ImageData& rawImageData, ImageData& output)
+{
+    return filter(rawImageData.type, rawImageData.data, rawImageData.metadata, output);
+}
+
+VoidResult TemporalFilter::filter(const Frame& rawFrame, ImageData& output)
+{
+    return filter(rawFrame.getType(), rawFrame.getData(), rawFrame.getMetadata(), output);
+}
+
+VoidResult TemporalFilter::filter(ImageData::Type type, std::span<const uint8_t> rawData, const FrameMetadata& metadata, ImageData& output)
+{
+    if (type != ImageData::Type::Raw14Bit)
+    {
+        return VoidResult::createError("Unable to filter frame!", "raw 14bit frame expected");
+    }
+
+    if (const auto result = addFrame(rawData); !result.isOk())
+    {
+        return result;
+    }
+
+    output.type = ImageData::Type::Raw14Bit;
+    output.data.resize(rawData.size());
+    output.metadata = metadata;
+    return getAverage(std::span<uint8_t>(output.data));
+}
+
+} // namespace core
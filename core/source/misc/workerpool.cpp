@@ -0,0 +1,34 @@
+#include "core/misc/workerpool.h"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+
+namespace core
+{
+
+namespace workerpool
+{
+
+namespace
+{
+
+// few threads are enough - frame itself is split among threads of parallel algorithms
+constexpr size_t THREADS_COUNT = 2;
+
+boost::asio::thread_pool& getThreadPool()
+{
+    static boost::asio::thread_pool pool(THREADS_COUNT);
+    return pool;
+}
+
+} // namespace
+
+void post(std::function<void ()> function)
+{
+    boost::asio::post(getThreadPool(), std::move(function));
+}
+
+} // namespace workerpool
+
+} // namespace core
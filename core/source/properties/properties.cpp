@@ -5,18 +5,37 @@
 #include "core/properties/propertydependencyvalidator.h"
 #include "core/properties/taskmanagerdirect.h"
 #include "core/properties/taskmanagerqueued.h"
+#include "core/connection/deviceinterfaceprefetched.h"
+#include "core/connection/deviceinterfacewritecombining.h"
 #include "core/logging.h"
 #include "core/misc/elapsedtimer.h"
 #include "core/misc/verify.h"
 #include "core/prtutils.h"
 
 #include <boost/polymorphic_cast.hpp>
+#include <boost/scope_exit.hpp>
 #include <thread>
 
 
 namespace core
 {
 
+namespace
+{
+
+connection::AddressRanges getBlockRanges(const PropertiesCache::Blocks& blocks)
+{
+    std::vector<connection::AddressRange> ranges;
+    for (const auto& [addressRange, data] : blocks)
+    {
+        ranges.push_back(addressRange);
+    }
+
+    return connection::AddressRanges(ranges);
+}
+
+} // namespace
+
 class Properties::TransactionData
 {
 public:
@@ -83,7 +102,8 @@ Properties::Properties(const std::shared_ptr<connection::IDeviceInterface>& devi
     Mode mode, const std::shared_ptr<IMainThreadIndicator>& indicator) :
     m_deviceInterface(deviceInterface),
     m_mainThreadIndicator(indicator),
-    m_propertyValues(PropertyValues::createInstance())
+    m_propertyValues(PropertyValues::createInstance()),
+    m_snapshot(std::make_shared<const PropertiesSnapshot>())
 {
     m_nonexclusiveTaskManager = createNewTaskManager(mode);
 }
@@ -184,6 +204,11 @@ const std::optional<DeviceType>& Properties::getCurrentDeviceType(const Properti
     return getDeviceType();
 }
 
+std::shared_ptr<const PropertiesSnapshot> Properties::getSnapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
 const std::vector<PropertyId>& Properties::getPropertiesToTouchAfterConnect(const PropertiesTransaction& transaction)
 {
     assert(transaction.getProperties().get() == this);
@@ -308,7 +333,15 @@ void Properties::addValueAdapter(const std::shared_ptr<PropertyValueBase>& value
         if (propertyId.has_value())
         {
             const auto writeResult = generalErrorMessage.empty() ? VoidResult::createOk() : VoidResult::createError(generalErrorMessage, detailErrorMessage);
-            m_transactionData.lock()->addPropertyWriteFinished(propertyId.value(), writeResult);
+            if (m_writeCombiningDeviceInterface != nullptr)
+            {
+                // written data are only queued - reported by applyValues after flush
+                m_writesFinishedBeforeFlush.emplace_back(propertyId.value(), writeResult);
+            }
+            else
+            {
+                m_transactionData.lock()->addPropertyWriteFinished(propertyId.value(), writeResult);
+            }
         }
     });
 
@@ -410,16 +443,216 @@ void Properties::invalidateProperties(const connection::AddressRanges& addressRa
     }
 }
 
-VoidResult Properties::tryLoadProperties(const std::set<PropertyId>& properties, const std::chrono::steady_clock::duration& timeout)
+void Properties::publishSnapshot(const PropertyValues::Transaction& valuesTransaction, const std::set<PropertyId>& propertiesChanged)
+{
+    // only writer is the finishing transaction (serialized by values mutex), readers just load the pointer
+    const auto snapshot = PropertiesSnapshot::createNextVersion(std::atomic_load(&m_snapshot),
+                                                                valuesTransaction.getAllPropertyValues(),
+                                                                propertiesChanged);
+    std::atomic_store(&m_snapshot, snapshot);
+}
+
+template<class PropertyIdContainer>
+std::vector<connection::AddressRange> Properties::getPrefetchAddressRanges(const PropertyIdContainer& properties, const PropertyValues::Transaction& valuesTransaction,
+                                                                           const std::function<bool (PropertyId)>& filter) const
 {
+    std::vector<connection::AddressRange> ranges;
+
+    for (const auto propertyId : properties)
     {
-        const auto transaction = createPropertiesTransaction();
-        for (const auto& property : properties)
+        const auto& adapter = m_propertyAdapters.at(propertyId);
+        if (!filter(propertyId) || !adapter->isActiveForDeviceType(getDeviceType()) || !adapter->isReadable(valuesTransaction))
         {
-            transaction.touch(property);
+            continue;
+        }
+
+        const auto addressRanges = adapter->getAddressRanges();
+        for (const auto& addressRange : addressRanges.getRanges())
+        {
+            if (addressRange.getSize() <= MAX_PREFETCHED_RANGE_SIZE)
+            {
+                ranges.push_back(addressRange);
+            }
         }
     }
 
+    return ranges;
+}
+
+connection::AddressRanges Properties::getPacketSavingBlocks(const std::vector<connection::AddressRange>& ranges) const
+{
+    // adjacent ranges are merged => maximal contiguous blocks
+    const connection::AddressRanges blocks(ranges);
+    const auto* device = getTaskManager()->getDevice();
+
+    // block is worth reading at once only if it takes fewer packets than its ranges read one by one (duplicate ranges, several ranges in one packet)
+    // e.g. WTC640 registers are read by one word per packet - merged registers would cost the same packets plus copying
+    std::vector<connection::AddressRange> savingBlocks;
+    for (const auto& block : blocks.getRanges())
+    {
+        const auto packetSize = device->getReadPacketSize(block.getFirstAddress());
+        if (!packetSize.has_value() || packetSize.value() == 0)
+        {
+            savingBlocks.push_back(block);
+            continue;
+        }
+
+        const auto getPacketsCount = [packetSize = packetSize.value()](const connection::AddressRange& range)
+        {
+            return (uint64_t(range.getSize()) + packetSize - 1) / packetSize;
+        };
+
+        uint64_t rangesPacketsCount = 0;
+        for (const auto& range : ranges)
+        {
+            if (block.contains(range))
+            {
+                rangesPacketsCount += getPacketsCount(range);
+            }
+        }
+
+        if (getPacketsCount(block) < rangesPacketsCount)
+        {
+            savingBlocks.push_back(block);
+        }
+    }
+
+    return connection::AddressRanges(savingBlocks);
+}
+
+template<class PropertyIdContainer>
+void Properties::touchPropertiesWithPrefetch(const PropertyIdContainer& properties, const PropertiesTransaction& transaction,
+                                             const std::shared_ptr<const PropertiesCache>& propertiesCache)
+{
+    if (getMode(getTaskManager()) == Mode::SYNC_DIRECT && getDeviceType().has_value())
+    {
+        const ElapsedTimer timer;
+        const auto& valuesTransaction = transaction.getValuesTransaction();
+
+        assert(m_prefetchedDeviceInterface == nullptr);
+        m_prefetchedDeviceInterface = std::make_shared<connection::DeviceInterfacePrefetched>(getTaskManager()->getDevice());
+
+        bool cacheRestored = false;
+        if (propertiesCache != nullptr)
+        {
+            const auto keyResult = readPropertiesCacheKey(getBlockRanges(propertiesCache->getBlocks()));
+            if (keyResult.isOk() && keyResult.getValue() == propertiesCache->getKey())
+            {
+                for (const auto& [addressRange, data] : propertiesCache->getBlocks())
+                {
+                    m_prefetchedDeviceInterface->addBlock(addressRange, data);
+                }
+                cacheRestored = true;
+            }
+            else
+            {
+                WW_LOG_PROPERTIES_DEBUG << "properties cache not used - different device";
+            }
+        }
+
+        if (cacheRestored)
+        {
+            // merged separately - merged cacheable ranges are contained in restored blocks, so only volatile ranges are read
+            m_prefetchedDeviceInterface->prefetch(getPacketSavingBlocks(getPrefetchAddressRanges(properties, valuesTransaction, [this, &valuesTransaction](PropertyId propertyId)
+            {
+                return isPropertyCacheable(propertyId) && !valuesTransaction.hasValueResult(propertyId);
+            })), ProgressTask());
+            m_prefetchedDeviceInterface->prefetch(getPacketSavingBlocks(getPrefetchAddressRanges(properties, valuesTransaction, [this, &valuesTransaction](PropertyId propertyId)
+            {
+                return !isPropertyCacheable(propertyId) && !valuesTransaction.hasValueResult(propertyId);
+            })), ProgressTask());
+        }
+        else
+        {
+            m_prefetchedDeviceInterface->prefetch(getPacketSavingBlocks(getPrefetchAddressRanges(properties, valuesTransaction, [&valuesTransaction](PropertyId propertyId)
+            {
+                return !valuesTransaction.hasValueResult(propertyId);
+            })), ProgressTask());
+        }
+
+        WW_LOG_PROPERTIES_DEBUG << utils::format("prefetched {} blocks in {}ms (cache restored: {})", m_prefetchedDeviceInterface->getPrefetchedBlocksCount(),
+                                                 timer.getElapsedMilliseconds(), cacheRestored);
+    }
+
+    for (const auto property : properties)
+    {
+        transaction.touch(property);
+    }
+
+    m_prefetchedDeviceInterface.reset();
+}
+
+ValueResult<std::string> Properties::readPropertiesCacheKey(const connection::AddressRanges& cachedRanges)
+{
+    using ResultType = ValueResult<std::string>;
+
+    TRY_GET_RESULT(const auto deviceKey, readPropertiesCacheDeviceKey(getTaskManager()->getDevice(), cachedRanges));
+
+    return utils::format("{}:{}", getDeviceType().value().getInternalId(), deviceKey);
+}
+
+ValueResult<PropertiesCache> Properties::createPropertiesCache(const ConnectionExclusiveTransaction& transaction)
+{
+    using ResultType = ValueResult<PropertiesCache>;
+
+    assert(transaction.getPropertiesTransaction().getProperties().get() == this);
+
+    if (!getDeviceType().has_value())
+    {
+        return ResultType::createError("Unable to create properties cache!", "device not connected");
+    }
+
+    connection::DeviceInterfacePrefetched deviceInterface(getTaskManager()->getDevice());
+    deviceInterface.prefetch(connection::AddressRanges(getPrefetchAddressRanges(m_propertyValues->getPropertyIds(), transaction.getPropertiesTransaction().getValuesTransaction(), [this](PropertyId propertyId)
+    {
+        return isPropertyCacheable(propertyId);
+    })), ProgressTask());
+
+    // key covers exactly the stored blocks - restore validates the same ranges
+    TRY_GET_RESULT(const auto key, readPropertiesCacheKey(getBlockRanges(deviceInterface.getBlocks())));
+
+    return PropertiesCache(key, deviceInterface.getBlocks());
+}
+
+void Properties::setPropertiesCache(const std::shared_ptr<const PropertiesCache>& propertiesCache, const PropertiesTransaction& transaction)
+{
+    assert(transaction.getProperties().get() == this);
+
+    m_propertiesCache = propertiesCache;
+}
+
+bool Properties::isPropertyCacheable(PropertyId) const
+{
+    return false;
+}
+
+ValueResult<std::string> Properties::readPropertiesCacheDeviceKey(connection::IDeviceInterface*, const connection::AddressRanges&)
+{
+    return ValueResult<std::string>::createError("Properties cache not supported!");
+}
+
+connection::IDeviceInterface* Properties::getTaskDevice()
+{
+    if (m_writeCombiningDeviceInterface != nullptr)
+    {
+        return m_writeCombiningDeviceInterface.get();
+    }
+
+    if (m_prefetchedDeviceInterface != nullptr)
+    {
+        return m_prefetchedDeviceInterface.get();
+    }
+
+    return getTaskManager()->getDevice();
+}
+
+VoidResult Properties::tryLoadProperties(const std::set<PropertyId>& properties, const std::chrono::steady_clock::duration& timeout)
+{
+    {
+        const auto transaction = createPropertiesTransaction();
+        touchPropertiesWithPrefetch(properties, transaction, nullptr);
+    }
+
     const ElapsedTimer timer(timeout);
     while (true)
     {
@@ -583,6 +816,11 @@ Properties::TransactionData::~TransactionData()
     auto propertiesValueChanged = m_valuesTransaction->getPropertiesChanged();
     propertiesValueChanged.insert(m_propertiesValuesChanged.begin(), m_propertiesValuesChanged.end());
 
+    if (!propertiesValueChanged.empty() || m_connectionChanged)
+    {
+        m_properties->publishSnapshot(m_valuesTransaction.value(), propertiesValueChanged);
+    }
+
     m_valuesTransaction.reset();
 
     m_properties->onTransactionFinished(TransactionSummary(
@@ -827,6 +1065,142 @@ VoidResult Properties::PropertiesTransaction::setValueAccording(PropertyId targe
     return derefPtr(getPropertyAdapter(targetPropertyId)).setValueAccording(getPropertyAdapter(sourcePropertyId), getValuesTransaction());
 }
 
+VoidResult Properties::PropertiesTransaction::applyValues(const std::map<PropertyId, std::any>& values) const
+{
+    const auto& valuesTransaction = getValuesTransaction();
+    auto* properties = getProperties().get();
+
+    std::vector<PropertyAdapterBase*> adapters;
+    std::set<std::shared_ptr<PropertyDependencyValidator>> validators;
+    for (const auto& [propertyId, value] : values)
+    {
+        auto* adapter = getPropertyAdapter(propertyId);
+        if (adapter == nullptr || !adapter->isWritable(valuesTransaction))
+        {
+            return VoidResult::createError("Unable to set value!", utils::format("property {} is not writable", propertyId.getIdString()));
+        }
+
+        if (adapter->getTypeInfo() != value.type())
+        {
+            return VoidResult::createError("Unable to set value!", utils::format("property {} invalid value type", propertyId.getIdString()));
+        }
+
+        adapters.push_back(adapter);
+        validators.insert(adapter->getDependencyValidators().begin(), adapter->getDependencyValidators().end());
+    }
+
+    for (auto* adapter : adapters)
+    {
+        adapter->setDependencyValidationSuppressed(true);
+    }
+    BOOST_SCOPE_EXIT(&adapters)
+    {
+        for (auto* adapter : adapters)
+        {
+            adapter->setDependencyValidationSuppressed(false);
+        }
+    } BOOST_SCOPE_EXIT_END
+
+    for (auto* adapter : adapters)
+    {
+        const auto result = adapter->validateAnyValueForWrite(values.at(adapter->getPropertyId()), valuesTransaction);
+        if (!result.isAcceptable())
+        {
+            return result.getResult();
+        }
+    }
+
+    for (const auto& validator : validators)
+    {
+        const auto result = validator->validateWhatIf(values, valuesTransaction);
+        if (!result.isAcceptable())
+        {
+            return result.getResult();
+        }
+    }
+
+    // adapters without device address (derived, components...) last
+    std::stable_sort(adapters.begin(), adapters.end(), [](const PropertyAdapterBase* adapter1, const PropertyAdapterBase* adapter2)
+    {
+        const auto ranges1 = adapter1->getAddressRanges();
+        const auto ranges2 = adapter2->getAddressRanges();
+        const auto address1 = ranges1.getRanges().empty() ? std::numeric_limits<uint64_t>::max() : uint64_t(ranges1.getRanges().front().getFirstAddress());
+        const auto address2 = ranges2.getRanges().empty() ? std::numeric_limits<uint64_t>::max() : uint64_t(ranges2.getRanges().front().getFirstAddress());
+        return address1 < address2;
+    });
+
+    const bool combineWrites = properties->getMode(properties->getTaskManager()) == Mode::SYNC_DIRECT && properties->m_prefetchedDeviceInterface == nullptr;
+    if (combineWrites)
+    {
+        assert(properties->m_writeCombiningDeviceInterface == nullptr);
+        properties->m_writeCombiningDeviceInterface = std::make_shared<connection::DeviceInterfaceWriteCombining>(properties->getTaskManager()->getDevice());
+    }
+
+    VoidResult writeResult = VoidResult::createOk();
+    for (auto* adapter : adapters)
+    {
+        if (const auto result = adapter->setAnyValue(values.at(adapter->getPropertyId()), valuesTransaction); !result.isOk())
+        {
+            writeResult = result;
+            break;
+        }
+    }
+
+    if (combineWrites)
+    {
+        const auto writeCombiningDeviceInterface = std::exchange(properties->m_writeCombiningDeviceInterface, nullptr);
+        // failures of this flush and of earlier flushes forced by reads of pending data are both in failed ranges
+        static_cast<void>(writeCombiningDeviceInterface->flush(ProgressTask()));
+        const connection::AddressRanges failedRanges(writeCombiningDeviceInterface->getFailedRanges());
+        const auto& failedWriteResult = writeCombiningDeviceInterface->getFirstFailedWriteResult();
+        const bool writesFailed = !failedRanges.getRanges().empty();
+
+        if (writesFailed)
+        {
+            // values were updated as if write succeeded
+            for (auto* adapter : adapters)
+            {
+                if (adapter->getAddressRanges().overlaps(failedRanges))
+                {
+                    valuesTransaction.resetValue(adapter->getPropertyId());
+                }
+            }
+
+            if (writeResult.isOk())
+            {
+                writeResult = failedWriteResult;
+            }
+        }
+
+        // adapters reported their writes when data were only queued - finished writes are reported now with result of flush
+        for (auto [propertyId, result] : std::exchange(properties->m_writesFinishedBeforeFlush, {}))
+        {
+            auto* adapter = getPropertyAdapter(propertyId);
+            if (result.isOk() && writesFailed && adapter != nullptr && adapter->getAddressRanges().overlaps(failedRanges))
+            {
+                result = VoidResult::createError(failedWriteResult.getGeneralErrorMessage(),
+                                                 utils::format("property: {} - {}", propertyId.getIdString(), failedWriteResult.getDetailErrorMessage()));
+                adapter->setLastWriteResult(result);
+            }
+
+            m_transactionData->addPropertyWriteFinished(propertyId, result);
+        }
+    }
+
+    for (const auto& validator : validators)
+    {
+        for (const auto propertyId : validator->getPropertyIds())
+        {
+            if (!values.contains(propertyId) && !valuesTransaction.hasValueResult(propertyId))
+            {
+                m_transactionData->touchDependentProperty(propertyId);
+            }
+        }
+    }
+
+    return writeResult;
+}
+
 std::vector<RankedValidationResult> Properties::PropertiesTransaction::getValueDependencyValidationResults(PropertyId propertyId) const
 {
     return derefPtr(getPropertyAdapter(propertyId)).getValueDependencyValidationResults();
@@ -931,11 +1305,15 @@ Properties::ConnectionStateTransactionData::~ConnectionStateTransactionData()
     m_transactionData->getProperties()->setCurrentDeviceType(getCurrentDeviceType(), m_transactionData->getValuesTransaction().value());
 
     const ConnectionExclusiveTransaction exclusiveTransaction = createConnectionExclusiveTransaction();
-    for (const auto property : m_transactionData->getProperties()->m_propertiesToTouchAfterConnect)
+    // cache is valid only at connect - later values may differ because of writes
+    std::shared_ptr<const PropertiesCache> propertiesCache;
+    if (getCurrentDeviceType().has_value())
     {
-        exclusiveTransaction.getPropertiesTransaction().touch(property);
+        propertiesCache = std::exchange(getProperties()->m_propertiesCache, nullptr);
     }
 
+    getProperties()->touchPropertiesWithPrefetch(getProperties()->m_propertiesToTouchAfterConnect, exclusiveTransaction.getPropertiesTransaction(), propertiesCache);
+
     m_stopAndBlockTasks = std::nullopt;
 }
 
@@ -1032,7 +1410,7 @@ void Properties::AdapterTaskCreator::createTaskSimple(const connection::AddressR
     const auto properties = m_properties.lock();
     properties->getTaskManager()->addTaskSimple(addressRanges, taskType, [taskFunction, properties]() // capture properties shared_ptr to keep properties alive till task ends
     {
-        return taskFunction(properties->getTaskManager()->getDevice(), [properties]()
+        return taskFunction(properties->getTaskDevice(), [properties]()
         {
             return properties->getTaskResultTransaction();
         });
@@ -1044,7 +1422,7 @@ void Properties::AdapterTaskCreator::createTaskWithProgress(const connection::Ad
     const auto properties = m_properties.lock();
     properties->getTaskManager()->addTaskWithProgress(addressRanges, taskType, [taskFunction, properties](ProgressController progressController) // capture properties shared_ptr to keep properties alive till task ends
     {
-        return taskFunction(properties->getTaskManager()->getDevice(), progressController, [properties]()
+        return taskFunction(properties->getTaskDevice(), progressController, [properties]()
         {
             return properties->getTaskResultTransaction();
         });
@@ -0,0 +1,172 @@
+#include "core/properties/propertiescache.h"
+
+#include "core/utils.h"
+
+#include <boost/endian.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+
+namespace core
+{
+
+namespace
+{
+
+void writeUint32(std::ofstream& file, uint32_t value)
+{
+    const uint32_t littleEndianValue = boost::endian::native_to_little(value);
+    file.write(reinterpret_cast<const char*>(&littleEndianValue), sizeof(littleEndianValue));
+}
+
+bool readUint32(std::ifstream& file, uint32_t& value)
+{
+    uint32_t littleEndianValue = 0;
+    if (!file.read(reinterpret_cast<char*>(&littleEndianValue), sizeof(littleEndianValue)))
+    {
+        return false;
+    }
+
+    value = boost::endian::little_to_native(littleEndianValue);
+    return true;
+}
+
+} // namespace
+
+PropertiesCache::PropertiesCache(const std::string& key, const Blocks& blocks) :
+    m_key(key),
+    m_blocks(blocks)
+{
+}
+
+const std::string& PropertiesCache::getKey() const
+{
+    return m_key;
+}
+
+const PropertiesCache::Blocks& PropertiesCache::getBlocks() const
+{
+    return m_blocks;
+}
+
+VoidResult PropertiesCache::saveToFile(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return VoidResult::createError("Error saving properties cache", utils::format("File {} is not accessible for write.", filename));
+    }
+
+    writeUint32(file, FILE_MAGIC);
+    writeUint32(file, FILE_FORMAT_VERSION);
+
+    writeUint32(file, static_cast<uint32_t>(m_key.size()));
+    file.write(m_key.data(), m_key.size());
+
+    writeUint32(file, static_cast<uint32_t>(m_blocks.size()));
+    for (const auto& [addressRange, data] : m_blocks)
+    {
+        assert(addressRange.getSize() == data.size());
+
+        writeUint32(file, addressRange.getFirstAddress());
+        writeUint32(file, addressRange.getSize());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    if (!file.good())
+    {
+        return VoidResult::createError("Error saving properties cache", utils::format("Write to file {} failed.", filename));
+    }
+
+    return VoidResult::createOk();
+}
+
+ValueResult<PropertiesCache> PropertiesCache::loadFromFile(const std::string& filename)
+{
+    using ResultType = ValueResult<PropertiesCache>;
+
+    auto createError = [&filename](const std::string& detailErrorMessage)
+    {
+        return ResultType::createError("Error loading properties cache", utils::format("{}: {}", filename, detailErrorMessage));
+    };
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return createError("file is not accessible for read");
+    }
+
+    // every size read from file is checked against rest of file before allocation - corrupted file must not cause huge allocations
+    const auto fileSize = static_cast<uint64_t>(std::max<std::streamoff>(file.tellg(), 0));
+    file.seekg(0);
+    auto getRemainingSize = [&file, fileSize]()
+    {
+        const auto position = file.tellg();
+        return position < 0 ? 0 : fileSize - std::min(fileSize, static_cast<uint64_t>(position));
+    };
+
+    uint32_t magic = 0;
+    uint32_t formatVersion = 0;
+    if (!readUint32(file, magic) || !readUint32(file, formatVersion) || magic != FILE_MAGIC)
+    {
+        return createError("invalid file format");
+    }
+
+    if (formatVersion != FILE_FORMAT_VERSION)
+    {
+        return createError(utils::format("unsupported format version {}", formatVersion));
+    }
+
+    uint32_t keySize = 0;
+    if (!readUint32(file, keySize) || keySize > getRemainingSize())
+    {
+        return createError("unexpected end of file");
+    }
+
+    std::string key(keySize, '\0');
+    uint32_t blocksCount = 0;
+    if (!file.read(key.data(), keySize) || !readUint32(file, blocksCount))
+    {
+        return createError("unexpected end of file");
+    }
+
+    // address and size of each block
+    if (static_cast<uint64_t>(blocksCount) * 2 * sizeof(uint32_t) > getRemainingSize())
+    {
+        return createError(utils::format("invalid blocks count {}", blocksCount));
+    }
+
+    Blocks blocks;
+    for (uint32_t i = 0; i < blocksCount; ++i)
+    {
+        uint32_t firstAddress = 0;
+        uint32_t size = 0;
+        if (!readUint32(file, firstAddress) || !readUint32(file, size))
+        {
+            return createError("unexpected end of file");
+        }
+
+        if (size == 0 || firstAddress + (size - 1) < firstAddress)
+        {
+            return createError("invalid block");
+        }
+
+        if (size > getRemainingSize())
+        {
+            return createError("unexpected end of file");
+        }
+
+        std::vector<uint8_t> data(size);
+        if (!file.read(reinterpret_cast<char*>(data.data()), size))
+        {
+            return createError("unexpected end of file");
+        }
+
+        blocks.emplace(connection::AddressRange::firstAndSize(firstAddress, size), std::move(data));
+    }
+
+    return PropertiesCache(key, blocks);
+}
+
+} // namespace core
@@ -0,0 +1,93 @@
+#include "core/properties/propertiessnapshot.h"
+
+#include "core/properties/propertyvaluebase.h"
+
+
+namespace core
+{
+
+PropertiesSnapshot::PropertiesSnapshot()
+{
+}
+
+std::shared_ptr<const PropertiesSnapshot> PropertiesSnapshot::createNextVersion(const std::shared_ptr<const PropertiesSnapshot>& previous,
+                                                                                const std::map<PropertyId, const PropertyValueBase*>& values,
+                                                                                const std::set<PropertyId>& propertiesChanged)
+{
+    auto snapshot = std::make_shared<PropertiesSnapshot>();
+    snapshot->m_version = previous != nullptr ? previous->m_version + 1 : 1;
+
+    for (const auto& [propertyId, propertyValue] : values)
+    {
+        if (previous != nullptr && !propertiesChanged.contains(propertyId))
+        {
+            // unchanged entries are shared with previous version
+            const auto it = previous->m_entries.find(propertyId);
+            if (it != previous->m_entries.end())
+            {
+                snapshot->m_entries.emplace_hint(snapshot->m_entries.end(), propertyId, it->second);
+                continue;
+            }
+        }
+
+        auto entry = std::make_shared<Entry>();
+        entry->value = propertyValue->getValueAsAny();
+        entry->valueAsString = propertyValue->getValueAsString();
+        entry->hasValueResult = propertyValue->hasValueResult();
+
+        snapshot->m_entries.emplace_hint(snapshot->m_entries.end(), propertyId, std::move(entry));
+    }
+
+    return snapshot;
+}
+
+uint64_t PropertiesSnapshot::getVersion() const
+{
+    return m_version;
+}
+
+std::set<PropertyId> PropertiesSnapshot::getPropertyIds() const
+{
+    std::set<PropertyId> propertyIds;
+
+    for (const auto& entry : m_entries)
+    {
+        propertyIds.insert(propertyIds.end(), entry.first);
+    }
+
+    return propertyIds;
+}
+
+bool PropertiesSnapshot::hasProperty(PropertyId propertyId) const
+{
+    return getEntry(propertyId) != nullptr;
+}
+
+bool PropertiesSnapshot::hasValueResult(PropertyId propertyId) const
+{
+    const auto* entry = getEntry(propertyId);
+    return entry != nullptr && entry->hasValueResult;
+}
+
+std::string PropertiesSnapshot::getValueAsString(PropertyId propertyId) const
+{
+    if (const auto* entry = getEntry(propertyId))
+    {
+        return entry->valueAsString;
+    }
+
+    return std::string();
+}
+
+const PropertiesSnapshot::Entry* PropertiesSnapshot::getEntry(PropertyId propertyId) const
+{
+    const auto it = m_entries.find(propertyId);
+    if (it == m_entries.end())
+    {
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+} // namespace core
@@ -166,6 +166,10 @@ const std::set<PropertyId>& PropertyAdapterBase::getValidationDependencyProperty
     return m_validationDependencyPropertyIds;
 }
 
+void PropertyAdapterBase::setLastWriteResult(const VoidResult&)
+{
+}
+
 connection::AddressRanges PropertyAdapterBase::getAddressRanges() const
 {
     return {};
@@ -196,6 +200,16 @@ const std::vector<std::shared_ptr<PropertyDependencyValidator>>& PropertyAdapter
     return m_dependencyValidators;
 }
 
+void PropertyAdapterBase::setDependencyValidationSuppressed(bool suppressed)
+{
+    m_dependencyValidationSuppressed = suppressed;
+}
+
+bool PropertyAdapterBase::isDependencyValidationSuppressed() const
+{
+    return m_dependencyValidationSuppressed;
+}
+
 void PropertyAdapterBase::setStatus(Status status, const PropertyValues::Transaction& transaction)
 {
     if (status != m_status)
@@ -28,6 +28,11 @@ const RankedValidationResult& PropertyDependencyValidator::getValidationResult()
     return m_validationResult;
 }
 
+RankedValidationResult PropertyDependencyValidator::validateWhatIf(const std::map<PropertyId, std::any>& values, PropertyValues::Transaction transaction)
+{
+    return validateWhatIfImpl(values, transaction);
+}
+
 void PropertyDependencyValidator::setValidationResult(const RankedValidationResult& result)
 {
     if (m_validationResult != result)
@@ -1,14 +1,146 @@
 #include "core/properties/propertyid.h"
 
-#include <algorithm>
+#include <deque>
+#include <functional>
 #include <cassert>
 
 namespace core
 {
 
-std::vector<PropertyId> PropertyId::m_allPropertyIds {};
-std::map<size_t, PropertyId::PropertyData> PropertyId::m_internalIdToData {};
-std::map<std::string, size_t> PropertyId::m_idStringToInternalId {};
+class PropertyId::Registry
+{
+public:
+    size_t getSize() const;
+
+    const std::string& getIdString(size_t internalId) const;
+    const std::string& getInfo(size_t internalId) const;
+
+    std::optional<size_t> findInternalId(std::string_view idString) const;
+
+    size_t addPropertyData(const std::string& idString, const std::string& info);
+
+    const std::vector<PropertyId>& getAllPropertyIds() const;
+
+private:
+    static constexpr size_t EMPTY_SLOT = static_cast<size_t>(-1);
+    static constexpr size_t INITIAL_HASH_TABLE_SIZE = 512;
+
+    size_t getFirstSlot(std::string_view idString) const;
+    void insertToHashTable(size_t internalId);
+    void rehash(size_t newSize);
+
+    struct PropertyData
+    {
+        std::string idString;
+        std::string info;
+    };
+
+    // deque keeps references returned by getIdString/getInfo valid
+    std::deque<PropertyData> m_data;
+    std::vector<PropertyId> m_allPropertyIds;
+
+    // linear probing, size is power of 2, load factor <= 0.5
+    std::vector<size_t> m_hashTable;
+};
+
+
+size_t PropertyId::Registry::getSize() const
+{
+    return m_data.size();
+}
+
+const std::string& PropertyId::Registry::getIdString(size_t internalId) const
+{
+    assert(internalId < m_data.size());
+
+    return m_data[internalId].idString;
+}
+
+const std::string& PropertyId::Registry::getInfo(size_t internalId) const
+{
+    assert(internalId < m_data.size());
+
+    return m_data[internalId].info;
+}
+
+std::optional<size_t> PropertyId::Registry::findInternalId(std::string_view idString) const
+{
+    if (m_hashTable.empty())
+    {
+        return std::nullopt;
+    }
+
+    const size_t mask = m_hashTable.size() - 1;
+    for (size_t slot = getFirstSlot(idString); m_hashTable[slot] != EMPTY_SLOT; slot = (slot + 1) & mask)
+    {
+        if (m_data[m_hashTable[slot]].idString == idString)
+        {
+            return m_hashTable[slot];
+        }
+    }
+
+    return std::nullopt;
+}
+
+size_t PropertyId::Registry::addPropertyData(const std::string& idString, const std::string& info)
+{
+    assert(!findInternalId(idString).has_value() && "id string duplicity!");
+
+    const auto internalId = m_data.size();
+
+    m_data.push_back(PropertyData{idString, info});
+    // ids are assigned in increasing order => vector stays sorted
+    m_allPropertyIds.push_back(PropertyId(internalId));
+
+    if (m_hashTable.empty())
+    {
+        rehash(INITIAL_HASH_TABLE_SIZE);
+    }
+    else if (2 * m_data.size() > m_hashTable.size())
+    {
+        rehash(2 * m_hashTable.size());
+    }
+    else
+    {
+        insertToHashTable(internalId);
+    }
+
+    return internalId;
+}
+
+const std::vector<PropertyId>& PropertyId::Registry::getAllPropertyIds() const
+{
+    return m_allPropertyIds;
+}
+
+size_t PropertyId::Registry::getFirstSlot(std::string_view idString) const
+{
+    return std::hash<std::string_view>()(idString) & (m_hashTable.size() - 1);
+}
+
+void PropertyId::Registry::insertToHashTable(size_t internalId)
+{
+    const size_t mask = m_hashTable.size() - 1;
+
+    size_t slot = getFirstSlot(m_data[internalId].idString);
+    while (m_hashTable[slot] != EMPTY_SLOT)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    m_hashTable[slot] = internalId;
+}
+
+void PropertyId::Registry::rehash(size_t newSize)
+{
+    m_hashTable.assign(newSize, EMPTY_SLOT);
+
+    for (size_t internalId = 0; internalId < m_data.size(); ++internalId)
+    {
+        insertToHashTable(internalId);
+    }
+}
+
 
 PropertyId::PropertyId(size_t internalId) :
         m_internalId(internalId)
@@ -22,62 +154,50 @@ size_t PropertyId::getInternalId() const
 
 const std::string& PropertyId::getIdString() const
 {
-    assert(m_internalIdToData.find(m_internalId) != m_internalIdToData.end());
-
-    return m_internalIdToData.at(m_internalId).idString;
+    return getRegistry().getIdString(m_internalId);
 }
 
 const std::string& PropertyId::getInfo() const
 {
-    assert(m_internalIdToData.find(m_internalId) != m_internalIdToData.end());
-
-    return m_internalIdToData.at(m_internalId).info;
+    return getRegistry().getInfo(m_internalId);
 }
 
 PropertyId PropertyId::createPropertyId(const std::string& idString, const std::string& info)
 {
     assert(!idString.empty());
 
-    const auto internalId = m_allPropertyIds.size();
-    const PropertyId propertyId(internalId);
-
-    assert(!std::binary_search(m_allPropertyIds.begin(), m_allPropertyIds.end(), propertyId));
-    assert(m_internalIdToData.find(internalId) == m_internalIdToData.end());
-    assert(m_idStringToInternalId.find(idString) == m_idStringToInternalId.end() && "id string duplicity!");
-
-    m_allPropertyIds.push_back(propertyId);
-    std::sort(m_allPropertyIds.begin(), m_allPropertyIds.end());
-
-    m_internalIdToData.emplace(internalId, PropertyData{idString, info});
-    m_idStringToInternalId.emplace(idString, internalId);
-
-    return propertyId;
+    return PropertyId(getRegistry().addPropertyData(idString, info));
 }
 
 std::optional<PropertyId> PropertyId::getPropertyIdByInternalId(size_t internalId)
 {
-    const auto it = std::lower_bound(m_allPropertyIds.begin(), m_allPropertyIds.end(), PropertyId(internalId));
-    if (it != m_allPropertyIds.end())
+    if (internalId < getRegistry().getSize())
     {
-        return *it;
+        return PropertyId(internalId);
     }
 
     return std::nullopt;
 }
 
-std::optional<PropertyId> PropertyId::getPropertyIdByIdString(const std::string& idString)
+std::optional<PropertyId> PropertyId::getPropertyIdByIdString(std::string_view idString)
 {
-    const auto it = m_idStringToInternalId.find(idString);
-    if (it != m_idStringToInternalId.end())
+    if (const auto internalId = getRegistry().findInternalId(idString))
     {
-        return PropertyId(it->second);
+        return PropertyId(internalId.value());
     }
     return std::nullopt;
 }
 
 const std::vector<PropertyId>& PropertyId::getAllPropertyIds()
 {
-    return m_allPropertyIds;
+    return getRegistry().getAllPropertyIds();
+}
+
+PropertyId::Registry& PropertyId::getRegistry()
+{
+    // function local static - ids are created during static initialization of other translation units
+    static Registry registry;
+    return registry;
 }
 
 } // namespace core
@@ -11,6 +11,7 @@ public:
     ~TransactionData();
 
     PropertyValueBase* getProperty(PropertyId propertyId) const;
+    std::map<PropertyId, const PropertyValueBase*> getAllProperties() const;
 
     void addPropertyChanged(PropertyId propertyId);
     const std::set<PropertyId>& getPropertiesChanged() const;
@@ -115,6 +116,18 @@ PropertyValueBase* PropertyValues::TransactionData::getProperty(PropertyId prope
     return it->second.get();
 }
 
+std::map<PropertyId, const PropertyValueBase*> PropertyValues::TransactionData::getAllProperties() const
+{
+    std::map<PropertyId, const PropertyValueBase*> properties;
+
+    for (const auto& value : m_propertyValues->m_values)
+    {
+        properties.emplace_hint(properties.end(), value.first, value.second.get());
+    }
+
+    return properties;
+}
+
 void PropertyValues::TransactionData::addPropertyChanged(PropertyId propertyId)
 {
     m_propertiesValueChanged.insert(propertyId);
@@ -165,4 +178,9 @@ const std::set<PropertyId>& PropertyValues::Transaction::getPropertiesChanged()
     return m_transactionData->getPropertiesChanged();
 }
 
+std::map<PropertyId, const PropertyValueBase*> PropertyValues::Transaction::getAllPropertyValues() const
+{
+    return m_transactionData->getAllProperties();
+}
+
 } // namespace core
@@ -0,0 +1,99 @@
+#include "core/stream/frame.h"
+
+#include <cstring>
+#include <utility>
+
+
+namespace core
+{
+
+Frame::~Frame()
+{
+    reset();
+}
+
+Frame::Frame(Frame&& other) noexcept :
+    m_type(other.m_type),
+    m_data(std::exchange(other.m_data, {})),
+    m_metadata(std::exchange(other.m_metadata, {})),
+    m_owner(std::move(other.m_owner)),
+    m_handle(std::exchange(other.m_handle, nullptr))
+{
+}
+
+Frame& Frame::operator=(Frame&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+
+        m_type = other.m_type;
+        m_data = std::exchange(other.m_data, {});
+        m_metadata = std::exchange(other.m_metadata, {});
+        m_owner = std::move(other.m_owner);
+        m_handle = std::exchange(other.m_handle, nullptr);
+    }
+
+    return *this;
+}
+
+ImageData::Type Frame::getType() const
+{
+    return m_type;
+}
+
+std::span<const uint8_t> Frame::getData() const
+{
+    return m_data;
+}
+
+bool Frame::isEmpty() const
+{
+    return m_data.empty();
+}
+
+const FrameMetadata& Frame::getMetadata() const
+{
+    return m_metadata;
+}
+
+void Frame::setMetadata(const FrameMetadata& metadata)
+{
+    m_metadata = metadata;
+}
+
+void Frame::assign(ImageData::Type type, std::span<const uint8_t> data, const std::shared_ptr<IFrameBufferOwner>& owner, void* handle)
+{
+    reset();
+
+    m_type = type;
+    m_data = data;
+    m_owner = owner;
+    m_handle = handle;
+}
+
+void Frame::reset()
+{
+    if (m_owner != nullptr)
+    {
+        m_owner->releaseFrameBuffer(m_handle);
+        m_owner.reset();
+    }
+
+    m_data = {};
+    m_metadata = {};
+    m_handle = nullptr;
+}
+
+void Frame::copyTo(ImageData& imageData) const
+{
+    imageData.type = m_type;
+    imageData.metadata = m_metadata;
+    imageData.data.resize(m_data.size());
+    if (!m_data.empty())
+    {
+        std::memcpy(imageData.data.data(), m_data.data(), m_data.size());
+    }
+}
+
+} // namespace core
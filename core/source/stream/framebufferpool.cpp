@@ -0,0 +1,81 @@
+#include "core/stream/framebufferpool.h"
+
+#include <cassert>
+
+
+namespace core
+{
+
+FrameBufferPool::FrameBufferPool(size_t buffersCount, size_t bufferSize) :
+    m_bufferSize(bufferSize)
+{
+    m_buffers.reserve(buffersCount);
+    m_freeBuffers.reserve(buffersCount);
+
+    for (size_t i = 0; i < buffersCount; ++i)
+    {
+        auto buffer = std::make_unique<std::vector<uint8_t>>();
+        buffer->reserve(bufferSize);
+
+        m_freeBuffers.push_back(buffer.get());
+        m_buffers.push_back(std::move(buffer));
+    }
+}
+
+std::shared_ptr<FrameBufferPool> FrameBufferPool::createInstance(size_t buffersCount, size_t bufferSize)
+{
+    return std::shared_ptr<FrameBufferPool>(new FrameBufferPool(buffersCount, bufferSize));
+}
+
+std::span<uint8_t> FrameBufferPool::acquire(Frame& frame, ImageData::Type type, size_t size)
+{
+    // may give buffer back to this pool
+    frame.reset();
+
+    std::vector<uint8_t>* buffer = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (m_freeBuffers.empty())
+        {
+            auto newBuffer = std::make_unique<std::vector<uint8_t>>();
+            newBuffer->reserve(m_bufferSize);
+
+            m_freeBuffers.reserve(m_buffers.size() + 1);
+            m_freeBuffers.push_back(newBuffer.get());
+            m_buffers.push_back(std::move(newBuffer));
+        }
+
+        buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+    }
+
+    buffer->resize(size);
+    frame.assign(type, *buffer, shared_from_this(), buffer);
+
+    return *buffer;
+}
+
+size_t FrameBufferPool::getBuffersCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_buffers.size();
+}
+
+size_t FrameBufferPool::getFreeBuffersCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_freeBuffers.size();
+}
+
+void FrameBufferPool::releaseFrameBuffer(void* handle)
+{
+    auto* buffer = static_cast<std::vector<uint8_t>*>(handle);
+
+    std::lock_guard lock(m_mutex);
+    assert(m_freeBuffers.size() < m_buffers.size());
+    // capacity reserved for all buffers - no allocation
+    m_freeBuffers.push_back(buffer);
+}
+
+} // namespace core
@@ -0,0 +1,374 @@
+#include "core/stream/framegrabber.h"
+
+#include "core/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace core
+{
+
+FrameGrabber::FrameGrabber(const std::shared_ptr<IStream>& stream, size_t capacity, OverflowPolicy overflowPolicy) :
+    m_stream(stream),
+    m_overflowPolicy(overflowPolicy),
+    m_capacity(capacity),
+    m_slots(std::make_unique<Slot[]>(capacity))
+{
+    assert(capacity > 0);
+}
+
+FrameGrabber::~FrameGrabber()
+{
+    stop();
+}
+
+std::shared_ptr<FrameGrabber> FrameGrabber::createInstance(const std::shared_ptr<IStream>& stream, size_t capacity, OverflowPolicy overflowPolicy)
+{
+    return std::shared_ptr<FrameGrabber>(new FrameGrabber(stream, std::max<size_t>(capacity, 1), overflowPolicy));
+}
+
+VoidResult FrameGrabber::start()
+{
+    if (m_thread.joinable())
+    {
+        return VoidResult::createOk();
+    }
+
+    if (m_stream == nullptr || !m_stream->isRunning())
+    {
+        return VoidResult::createError("Stream is not running!");
+    }
+
+    m_keepRunning = true;
+    m_thread = std::thread(&FrameGrabber::grabbingThread, this);
+
+    return VoidResult::createOk();
+}
+
+void FrameGrabber::stop()
+{
+    m_keepRunning = false;
+    {
+        std::lock_guard lock(m_frameMutex);
+    }
+    m_frameCondition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool FrameGrabber::isRunning() const
+{
+    return m_keepRunning;
+}
+
+std::shared_ptr<FrameGrabber::Consumer> FrameGrabber::createConsumer()
+{
+    auto cursor = std::make_shared<ConsumerCursor>();
+    cursor->nextSequence = m_publishedSequence.load(std::memory_order_acquire);
+
+    {
+        std::lock_guard lock(m_consumersMutex);
+        std::erase_if(m_consumerCursors, [](const auto& cursor)
+        {
+            return !cursor->active;
+        });
+        m_consumerCursors.push_back(cursor);
+        m_consumersChanged = true;
+    }
+
+    return std::make_shared<Consumer>(shared_from_this(), cursor);
+}
+
+size_t FrameGrabber::getCapacity() const
+{
+    return m_capacity;
+}
+
+FrameGrabber::OverflowPolicy FrameGrabber::getOverflowPolicy() const
+{
+    return m_overflowPolicy;
+}
+
+size_t FrameGrabber::getReadableFramesCount() const
+{
+    // lagging consumer skips oldest frames, so that pinned frame is not the one grabber overwrites next
+    if (m_overflowPolicy == OverflowPolicy::OVERWRITE_OLDEST)
+    {
+        return std::max<size_t>(m_capacity / 2, 1);
+    }
+
+    return m_capacity;
+}
+
+FrameGrabber::Statistics FrameGrabber::getStatistics() const
+{
+    Statistics statistics;
+    statistics.framesGrabbed = m_framesGrabbed.load(std::memory_order_relaxed);
+    statistics.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    statistics.readErrors = m_readErrors.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void FrameGrabber::grabbingThread()
+{
+    Frame frame;
+    while (m_keepRunning)
+    {
+        if (const auto result = m_stream->readFrame(frame); !result.isOk())
+        {
+            m_readErrors.fetch_add(1, std::memory_order_relaxed);
+            WW_LOG_CONNECTION_DEBUG << "frame grabbing failed: " << result.toString();
+
+            std::this_thread::sleep_for(READ_ERROR_DELAY);
+            continue;
+        }
+
+        m_framesGrabbed.fetch_add(1, std::memory_order_relaxed);
+
+        if (publish(frame))
+        {
+            {
+                std::lock_guard lock(m_frameMutex);
+            }
+            m_frameCondition.notify_all();
+        }
+    }
+}
+
+bool FrameGrabber::publish(Frame& frame)
+{
+    const auto firstSequence = m_publishedSequence.load(std::memory_order_relaxed);
+
+    if (m_overflowPolicy == OverflowPolicy::BACKPRESSURE && !waitForConsumers(firstSequence))
+    {
+        return false;
+    }
+
+    // pinned slot is skipped (its sequence is not published) - stream goes on while consumer holds old frame
+    for (uint64_t sequence = firstSequence; sequence < firstSequence + m_capacity; ++sequence)
+    {
+        auto& slot = m_slots[sequence % m_capacity];
+
+        // seq_cst pair with Consumer::tryRead - either consumer sees writing sequence, or grabber sees the pin
+        const auto previousSequence = slot.sequence.exchange(WRITING_SEQUENCE);
+        if (slot.pins.load() != 0)
+        {
+            if (m_overflowPolicy == OverflowPolicy::OVERWRITE_OLDEST)
+            {
+                slot.skippedSequence.store(sequence);
+                slot.sequence.store(previousSequence);
+                continue;
+            }
+
+            if (!waitForUnpinned(slot))
+            {
+                slot.sequence.store(previousSequence);
+                return false;
+            }
+        }
+
+        // previous frame of slot is released here (buffer returned to driver / pool)
+        slot.frame = std::move(frame);
+        slot.sequence.store(sequence, std::memory_order_release);
+        m_publishedSequence.store(sequence + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // every slot pinned
+    m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+    frame.reset();
+    return false;
+}
+
+bool FrameGrabber::waitForConsumers(uint64_t sequence)
+{
+    if (sequence < m_capacity)
+    {
+        return true;
+    }
+
+    if (m_consumersChanged.exchange(false))
+    {
+        std::lock_guard lock(m_consumersMutex);
+        m_grabbingThreadCursors = m_consumerCursors;
+    }
+
+    // frame being overwritten must be read by all consumers
+    const auto requiredSequence = sequence - m_capacity + 1;
+    for (const auto& cursor : m_grabbingThreadCursors)
+    {
+        // released consumers are not waited for
+        while (cursor->active && cursor->nextSequence.load(std::memory_order_acquire) < requiredSequence)
+        {
+            if (!m_keepRunning)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(WAIT_STEP);
+        }
+    }
+
+    return true;
+}
+
+bool FrameGrabber::waitForUnpinned(const Slot& slot)
+{
+    while (slot.pins.load() != 0)
+    {
+        if (!m_keepRunning)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(WAIT_STEP);
+    }
+
+    return true;
+}
+
+
+FrameGrabber::FrameRef::~FrameRef()
+{
+    reset();
+}
+
+FrameGrabber::FrameRef::FrameRef(FrameRef&& other) noexcept :
+    m_grabber(std::move(other.m_grabber)),
+    m_slot(std::exchange(other.m_slot, nullptr)),
+    m_sequence(std::exchange(other.m_sequence, INVALID_SEQUENCE))
+{
+}
+
+FrameGrabber::FrameRef& FrameGrabber::FrameRef::operator=(FrameRef&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+
+        m_grabber = std::move(other.m_grabber);
+        m_slot = std::exchange(other.m_slot, nullptr);
+        m_sequence = std::exchange(other.m_sequence, INVALID_SEQUENCE);
+    }
+
+    return *this;
+}
+
+bool FrameGrabber::FrameRef::isValid() const
+{
+    return m_slot != nullptr;
+}
+
+const Frame& FrameGrabber::FrameRef::getFrame() const
+{
+    assert(isValid());
+    return m_slot->frame;
+}
+
+uint64_t FrameGrabber::FrameRef::getSequence() const
+{
+    return m_sequence;
+}
+
+void FrameGrabber::FrameRef::reset()
+{
+    if (m_slot != nullptr)
+    {
+        m_slot->pins.fetch_sub(1, std::memory_order_release);
+        m_slot = nullptr;
+    }
+
+    m_sequence = INVALID_SEQUENCE;
+    m_grabber.reset();
+}
+
+
+FrameGrabber::Consumer::Consumer(const std::shared_ptr<FrameGrabber>& grabber, const std::shared_ptr<ConsumerCursor>& cursor) :
+    m_grabber(grabber),
+    m_cursor(cursor)
+{
+}
+
+FrameGrabber::Consumer::~Consumer()
+{
+    m_cursor->active = false;
+}
+
+bool FrameGrabber::Consumer::tryRead(FrameRef& frameRef)
+{
+    auto& grabber = *m_grabber;
+
+    auto next = m_cursor->nextSequence.load(std::memory_order_relaxed);
+    const auto published = grabber.m_publishedSequence.load(std::memory_order_acquire);
+
+    while (next < published)
+    {
+        if (published - next > grabber.getReadableFramesCount())
+        {
+            m_cursor->droppedFrames.fetch_add(published - grabber.getReadableFramesCount() - next, std::memory_order_relaxed);
+            next = published - grabber.getReadableFramesCount();
+        }
+
+        auto& slot = grabber.m_slots[next % grabber.m_capacity];
+        slot.pins.fetch_add(1);
+        const auto slotSequence = slot.sequence.load();
+        if (slotSequence == next)
+        {
+            frameRef.reset();
+            frameRef.m_grabber = m_grabber;
+            frameRef.m_slot = &slot;
+            frameRef.m_sequence = next;
+
+            m_cursor->nextSequence.store(next + 1, std::memory_order_release);
+            return true;
+        }
+
+        slot.pins.fetch_sub(1);
+
+        // grabber is writing slot or backing off from our pin - result decides whether frame is still there
+        if (slotSequence == WRITING_SEQUENCE)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // overwritten meanwhile, or skipped by grabber (no frame lost)
+        if (slot.skippedSequence.load() != next)
+        {
+            m_cursor->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        ++next;
+    }
+
+    m_cursor->nextSequence.store(next, std::memory_order_release);
+    return false;
+}
+
+bool FrameGrabber::Consumer::read(FrameRef& frameRef, std::chrono::steady_clock::duration timeout)
+{
+    if (tryRead(frameRef))
+    {
+        return true;
+    }
+
+    auto& grabber = *m_grabber;
+    {
+        std::unique_lock lock(grabber.m_frameMutex);
+        grabber.m_frameCondition.wait_for(lock, timeout, [this, &grabber]()
+        {
+            return !grabber.m_keepRunning || grabber.m_publishedSequence.load(std::memory_order_acquire) > m_cursor->nextSequence.load(std::memory_order_relaxed);
+        });
+    }
+
+    return tryRead(frameRef);
+}
+
+uint64_t FrameGrabber::Consumer::getDroppedFramesCount() const
+{
+    return m_cursor->droppedFrames.load(std::memory_order_relaxed);
+}
+
+} // namespace core
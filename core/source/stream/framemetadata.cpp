@@ -0,0 +1,65 @@
+#include "core/stream/framemetadata.h"
+
+
+namespace core
+{
+
+void FrameMetadataTracker::reset()
+{
+    m_lastSequenceNumber.reset();
+    m_lastBlockId.reset();
+    m_lastDeviceTimestamp.reset();
+    m_droppedFramesCount = 0;
+}
+
+FrameMetadata FrameMetadataTracker::createFromBlockId(uint64_t blockId, std::optional<std::chrono::nanoseconds> deviceTimestamp)
+{
+    uint64_t droppedFrames = 0;
+    // lower id means wrap around or restart of device stream - gap is unknown
+    if (m_lastBlockId.has_value() && blockId > m_lastBlockId.value())
+    {
+        droppedFrames = blockId - m_lastBlockId.value() - 1;
+    }
+    m_lastBlockId = blockId;
+
+    auto metadata = createNext(droppedFrames, deviceTimestamp);
+    metadata.blockId = blockId;
+    return metadata;
+}
+
+FrameMetadata FrameMetadataTracker::createFromDeviceTimestamp(std::optional<std::chrono::nanoseconds> deviceTimestamp, std::chrono::nanoseconds expectedFrameInterval)
+{
+    uint64_t droppedFrames = 0;
+    if (deviceTimestamp.has_value() && m_lastDeviceTimestamp.has_value() && expectedFrameInterval.count() > 0)
+    {
+        const auto interval = deviceTimestamp.value() - m_lastDeviceTimestamp.value();
+        // jitter up to half of frame interval is tolerated
+        if (interval > expectedFrameInterval + expectedFrameInterval / 2)
+        {
+            droppedFrames = static_cast<uint64_t>((interval + expectedFrameInterval / 2) / expectedFrameInterval) - 1;
+        }
+    }
+
+    return createNext(droppedFrames, deviceTimestamp);
+}
+
+FrameMetadata FrameMetadataTracker::createNext(uint64_t droppedFrames, std::optional<std::chrono::nanoseconds> deviceTimestamp)
+{
+    m_droppedFramesCount += droppedFrames;
+
+    FrameMetadata metadata;
+    metadata.hostTimestamp = std::chrono::steady_clock::now();
+    metadata.deviceTimestamp = deviceTimestamp;
+    metadata.sequenceNumber = m_lastSequenceNumber.has_value() ? m_lastSequenceNumber.value() + droppedFrames + 1 : 0;
+    metadata.droppedFramesCount = m_droppedFramesCount;
+
+    m_lastSequenceNumber = metadata.sequenceNumber;
+    if (deviceTimestamp.has_value())
+    {
+        m_lastDeviceTimestamp = deviceTimestamp;
+    }
+
+    return metadata;
+}
+
+} // namespace core
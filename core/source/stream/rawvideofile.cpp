@@ -0,0 +1,131 @@
+#include "core/stream/rawvideofile.h"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cassert>
+#include <cstring>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr uint32_t FLAG_DEVICE_TIMESTAMP = 1u << 0;
+constexpr uint32_t FLAG_BLOCK_ID = 1u << 1;
+
+} // namespace
+
+size_t RawVideoFile::getRecordSize(uint32_t dataSize)
+{
+    return FRAME_HEADER_SIZE + (dataSize + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+void RawVideoFile::writeFileHeader(const FileHeader& header, std::span<uint8_t> buffer)
+{
+    assert(buffer.size() >= FILE_HEADER_SIZE);
+
+    std::memset(buffer.data(), 0, FILE_HEADER_SIZE);
+    boost::endian::store_little_u32(buffer.data(), FILE_MAGIC);
+    boost::endian::store_little_u32(buffer.data() + 4, FORMAT_VERSION);
+    boost::endian::store_little_u32(buffer.data() + 8, header.width);
+    boost::endian::store_little_u32(buffer.data() + 12, header.height);
+}
+
+std::optional<RawVideoFile::FileHeader> RawVideoFile::readFileHeader(std::span<const uint8_t> buffer)
+{
+    if (buffer.size() < FILE_HEADER_SIZE ||
+        boost::endian::load_little_u32(buffer.data()) != FILE_MAGIC ||
+        boost::endian::load_little_u32(buffer.data() + 4) != FORMAT_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    FileHeader header;
+    header.width = boost::endian::load_little_u32(buffer.data() + 8);
+    header.height = boost::endian::load_little_u32(buffer.data() + 12);
+    return header;
+}
+
+void RawVideoFile::writeFrameHeader(const FrameHeader& header, std::span<uint8_t> buffer)
+{
+    assert(buffer.size() >= FRAME_HEADER_SIZE);
+
+    const auto& metadata = header.metadata;
+    const uint32_t flags = (metadata.deviceTimestamp.has_value() ? FLAG_DEVICE_TIMESTAMP : 0) | (metadata.blockId.has_value() ? FLAG_BLOCK_ID : 0);
+
+    std::memset(buffer.data(), 0, FRAME_HEADER_SIZE);
+    boost::endian::store_little_u32(buffer.data(), FRAME_MAGIC);
+    boost::endian::store_little_u32(buffer.data() + 4, static_cast<uint32_t>(header.type));
+    boost::endian::store_little_u32(buffer.data() + 8, header.dataSize);
+    boost::endian::store_little_u32(buffer.data() + 12, flags);
+    boost::endian::store_little_s64(buffer.data() + 16, std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.hostTimestamp.time_since_epoch()).count());
+    boost::endian::store_little_s64(buffer.data() + 24, metadata.deviceTimestamp.value_or(std::chrono::nanoseconds(0)).count());
+    boost::endian::store_little_u64(buffer.data() + 32, metadata.sequenceNumber);
+    boost::endian::store_little_u64(buffer.data() + 40, metadata.blockId.value_or(0));
+    boost::endian::store_little_u64(buffer.data() + 48, metadata.droppedFramesCount);
+}
+
+std::optional<RawVideoFile::FrameHeader> RawVideoFile::readFrameHeader(std::span<const uint8_t> buffer)
+{
+    if (buffer.size() < FRAME_HEADER_SIZE || boost::endian::load_little_u32(buffer.data()) != FRAME_MAGIC)
+    {
+        return std::nullopt;
+    }
+
+    const uint32_t type = boost::endian::load_little_u32(buffer.data() + 4);
+    if (type > static_cast<uint32_t>(ImageData::Type::RGB))
+    {
+        return std::nullopt;
+    }
+
+    const uint32_t flags = boost::endian::load_little_u32(buffer.data() + 12);
+
+    FrameHeader header;
+    header.type = static_cast<ImageData::Type>(type);
+    header.dataSize = boost::endian::load_little_u32(buffer.data() + 8);
+
+    auto& metadata = header.metadata;
+    metadata.hostTimestamp = std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(boost::endian::load_little_s64(buffer.data() + 16))));
+    if ((flags & FLAG_DEVICE_TIMESTAMP) != 0)
+    {
+        metadata.deviceTimestamp = std::chrono::nanoseconds(boost::endian::load_little_s64(buffer.data() + 24));
+    }
+    metadata.sequenceNumber = boost::endian::load_little_u64(buffer.data() + 32);
+    if ((flags & FLAG_BLOCK_ID) != 0)
+    {
+        metadata.blockId = boost::endian::load_little_u64(buffer.data() + 40);
+    }
+    metadata.droppedFramesCount = boost::endian::load_little_u64(buffer.data() + 48);
+
+    return header;
+}
+
+void RawVideoFile::writeFooter(const Footer& footer, std::span<uint8_t> buffer)
+{
+    assert(buffer.size() >= FOOTER_SIZE);
+
+    boost::endian::store_little_u64(buffer.data(), footer.indexOffset);
+    boost::endian::store_little_u64(buffer.data() + 8, footer.framesCount);
+    boost::endian::store_little_u32(buffer.data() + 16, FOOTER_MAGIC);
+    boost::endian::store_little_u32(buffer.data() + 20, FORMAT_VERSION);
+}
+
+std::optional<RawVideoFile::Footer> RawVideoFile::readFooter(std::span<const uint8_t> buffer)
+{
+    if (buffer.size() < FOOTER_SIZE ||
+        boost::endian::load_little_u32(buffer.data() + 16) != FOOTER_MAGIC ||
+        boost::endian::load_little_u32(buffer.data() + 20) != FORMAT_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    Footer footer;
+    footer.indexOffset = boost::endian::load_little_u64(buffer.data());
+    footer.framesCount = boost::endian::load_little_u64(buffer.data() + 8);
+    return footer;
+}
+
+} // namespace core
@@ -0,0 +1,265 @@
+#include "core/stream/rawvideorecorder.h"
+
+#include "core/utils.h"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+
+namespace core
+{
+
+RawVideoRecorder::RawVideoRecorder(size_t chunkSize, size_t chunksCount) :
+    m_chunkSize(std::max(chunkSize, RawVideoFile::FILE_HEADER_SIZE))
+{
+    // all memory allocated upfront - nothing is allocated during recording except index
+    for (size_t i = 0; i < std::max<size_t>(chunksCount, 2); ++i)
+    {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->data.resize(m_chunkSize);
+        m_freeChunks.push_back(std::move(chunk));
+    }
+}
+
+RawVideoRecorder::~RawVideoRecorder()
+{
+    (void)close();
+}
+
+std::shared_ptr<RawVideoRecorder> RawVideoRecorder::createInstance(size_t chunkSize, size_t chunksCount)
+{
+    return std::shared_ptr<RawVideoRecorder>(new RawVideoRecorder(chunkSize, chunksCount));
+}
+
+VoidResult RawVideoRecorder::open(const std::string& filename, uint32_t width, uint32_t height)
+{
+    if (m_isOpen)
+    {
+        return VoidResult::createError("Error opening video file", "Recording is already in progress.");
+    }
+
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+    {
+        return VoidResult::createError("Error opening video file", utils::format("File {} is not accessible for write.", filename));
+    }
+
+    m_stopRequested = false;
+    m_writeError.reset();
+    m_writeFailed = false;
+    m_index.clear();
+    m_framesRecorded = 0;
+    m_framesDropped = 0;
+    m_bytesWritten = 0;
+
+    const bool chunkAcquired = acquireChunk();
+    assert(chunkAcquired);
+    (void)chunkAcquired;
+
+    RawVideoFile::writeFileHeader(RawVideoFile::FileHeader{width, height}, m_currentChunk->data);
+    m_currentChunk->size = RawVideoFile::FILE_HEADER_SIZE;
+    m_fileOffset = RawVideoFile::FILE_HEADER_SIZE;
+
+    m_isOpen = true;
+    m_thread = std::thread(&RawVideoRecorder::writingThread, this);
+
+    return VoidResult::createOk();
+}
+
+VoidResult RawVideoRecorder::close()
+{
+    if (!m_isOpen)
+    {
+        return VoidResult::createOk();
+    }
+
+    if (m_currentChunk != nullptr && m_currentChunk->size > 0)
+    {
+        submitChunk();
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+
+    if (m_currentChunk != nullptr)
+    {
+        m_freeChunks.push_back(std::move(m_currentChunk));
+    }
+    m_isOpen = false;
+
+    // index and footer - writer is finished, file may be accessed directly
+    uint64_t indexOffset = m_fileOffset;
+    if (m_writeError.has_value())
+    {
+        // chunks are written whole and in order => frames before end of last written chunk are complete
+        // index follows written data (overwrites part of failed write), frames of dropped chunks are removed from it
+        indexOffset = m_bytesWritten;
+        m_index.erase(std::lower_bound(m_index.begin(), m_index.end(), indexOffset), m_index.end());
+        m_framesRecorded = m_index.size();
+
+        m_file.clear();
+        m_file.seekp(static_cast<std::streamoff>(indexOffset));
+    }
+
+    std::vector<uint8_t> tail(m_index.size() * sizeof(uint64_t) + RawVideoFile::FOOTER_SIZE);
+    for (size_t i = 0; i < m_index.size(); ++i)
+    {
+        boost::endian::store_little_u64(tail.data() + i * sizeof(uint64_t), m_index[i]);
+    }
+    RawVideoFile::writeFooter(RawVideoFile::Footer{indexOffset, m_index.size()}, std::span(tail).subspan(m_index.size() * sizeof(uint64_t)));
+
+    m_file.write(reinterpret_cast<const char*>(tail.data()), tail.size());
+    m_file.close();
+
+    if (m_writeError.has_value())
+    {
+        return m_writeError.value();
+    }
+    if (!m_file)
+    {
+        return VoidResult::createError("Error writing video file", "Write of frame index failed.");
+    }
+
+    return VoidResult::createOk();
+}
+
+bool RawVideoRecorder::isOpen() const
+{
+    return m_isOpen;
+}
+
+bool RawVideoRecorder::addFrame(const Frame& frame)
+{
+    return addFrame(frame.getType(), frame.getData(), frame.getMetadata());
+}
+
+bool RawVideoRecorder::addFrame(ImageData::Type type, std::span<const uint8_t> data, const FrameMetadata& metadata)
+{
+    if (!m_isOpen)
+    {
+        return false;
+    }
+
+    // writer drops all chunks after error - frames would be missing in file, but present in index
+    if (m_writeFailed)
+    {
+        ++m_framesDropped;
+        return false;
+    }
+
+    const size_t recordSize = RawVideoFile::getRecordSize(static_cast<uint32_t>(data.size()));
+    if (recordSize > m_chunkSize)
+    {
+        assert(false && "Chunk is too small for frame!");
+        ++m_framesDropped;
+        return false;
+    }
+
+    if (m_currentChunk != nullptr && m_currentChunk->size + recordSize > m_chunkSize)
+    {
+        submitChunk();
+    }
+
+    if (m_currentChunk == nullptr && !acquireChunk())
+    {
+        ++m_framesDropped;
+        return false;
+    }
+
+    auto record = std::span(m_currentChunk->data).subspan(m_currentChunk->size, recordSize);
+    RawVideoFile::writeFrameHeader(RawVideoFile::FrameHeader{type, static_cast<uint32_t>(data.size()), metadata}, record);
+    std::memcpy(record.data() + RawVideoFile::FRAME_HEADER_SIZE, data.data(), data.size());
+    std::memset(record.data() + RawVideoFile::FRAME_HEADER_SIZE + data.size(), 0, recordSize - RawVideoFile::FRAME_HEADER_SIZE - data.size());
+
+    m_currentChunk->size += recordSize;
+    m_index.push_back(m_fileOffset);
+    m_fileOffset += recordSize;
+    ++m_framesRecorded;
+
+    return true;
+}
+
+RawVideoRecorder::Statistics RawVideoRecorder::getStatistics() const
+{
+    return Statistics{m_framesRecorded, m_framesDropped, m_bytesWritten};
+}
+
+bool RawVideoRecorder::acquireChunk()
+{
+    assert(m_currentChunk == nullptr);
+
+    std::lock_guard lock(m_mutex);
+    if (m_freeChunks.empty())
+    {
+        return false;
+    }
+
+    m_currentChunk = std::move(m_freeChunks.back());
+    m_freeChunks.pop_back();
+    m_currentChunk->size = 0;
+    return true;
+}
+
+void RawVideoRecorder::submitChunk()
+{
+    assert(m_currentChunk != nullptr);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_fullChunks.push_back(std::move(m_currentChunk));
+    }
+    m_condition.notify_one();
+}
+
+void RawVideoRecorder::writingThread()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]()
+        {
+            return !m_fullChunks.empty() || m_stopRequested;
+        });
+
+        if (m_fullChunks.empty())
+        {
+            break;
+        }
+
+        auto chunk = std::move(m_fullChunks.front());
+        m_fullChunks.pop_front();
+
+        const bool failed = m_writeError.has_value();
+        lock.unlock();
+        if (!failed)
+        {
+            writeChunk(*chunk);
+        }
+        lock.lock();
+
+        m_freeChunks.push_back(std::move(chunk));
+    }
+}
+
+void RawVideoRecorder::writeChunk(const Chunk& chunk)
+{
+    m_file.write(reinterpret_cast<const char*>(chunk.data.data()), chunk.size);
+    if (!m_file)
+    {
+        std::lock_guard lock(m_mutex);
+        m_writeError = VoidResult::createError("Error writing video file", "Write of frames failed.");
+        m_writeFailed = true;
+        return;
+    }
+
+    m_bytesWritten += chunk.size;
+}
+
+} // namespace core
@@ -0,0 +1,279 @@
+#include "core/stream/rawvideoreplaystream.h"
+
+#include "core/utils.h"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <thread>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr auto STOP_CHECK_INTERVAL = std::chrono::milliseconds(10);
+
+} // namespace
+
+// mapping stays alive until last replayed frame is released
+class RawVideoReplayStream::MappedFile final : public IFrameBufferOwner
+{
+public:
+    explicit MappedFile(const std::string& filename) :
+        m_mapping(filename.c_str(), boost::interprocess::read_only),
+        m_region(m_mapping, boost::interprocess::read_only)
+    {
+        m_region.advise(boost::interprocess::mapped_region::advice_sequential);
+    }
+
+    std::span<const uint8_t> getData() const
+    {
+        return std::span(static_cast<const uint8_t*>(m_region.get_address()), m_region.get_size());
+    }
+
+    virtual void releaseFrameBuffer(void*) override
+    {
+    }
+
+private:
+    boost::interprocess::file_mapping m_mapping;
+    boost::interprocess::mapped_region m_region;
+};
+
+RawVideoReplayStream::RawVideoReplayStream(const std::shared_ptr<MappedFile>& file, const RawVideoFile::FileHeader& fileHeader, std::vector<uint64_t>&& index, Pacing pacing, bool loop) :
+    m_file(file),
+    m_fileHeader(fileHeader),
+    m_index(std::move(index)),
+    m_pacing(pacing),
+    m_loop(loop)
+{
+}
+
+RawVideoReplayStream::~RawVideoReplayStream()
+{
+}
+
+ValueResult<std::shared_ptr<RawVideoReplayStream>> RawVideoReplayStream::createStream(const std::string& filename, Pacing pacing, bool loop)
+{
+    using ResultType = ValueResult<std::shared_ptr<RawVideoReplayStream>>;
+
+    auto createError = [&filename](const std::string& detailErrorMessage)
+    {
+        return ResultType::createError("Error opening video file", utils::format("{}: {}", filename, detailErrorMessage));
+    };
+
+    std::shared_ptr<MappedFile> file;
+    try
+    {
+        file = std::make_shared<MappedFile>(filename);
+    }
+    catch (const boost::interprocess::interprocess_exception& exception)
+    {
+        return createError(utils::format("file is not accessible for read ({})", exception.what()));
+    }
+
+    const auto data = file->getData();
+    const auto fileHeader = RawVideoFile::readFileHeader(data);
+    if (!fileHeader.has_value())
+    {
+        return createError("invalid file format");
+    }
+
+    std::vector<uint64_t> index;
+    const auto footer = data.size() >= RawVideoFile::FILE_HEADER_SIZE + RawVideoFile::FOOTER_SIZE ? RawVideoFile::readFooter(data.last(RawVideoFile::FOOTER_SIZE)) : std::nullopt;
+    if (footer.has_value() && footer->indexOffset + footer->framesCount * sizeof(uint64_t) + RawVideoFile::FOOTER_SIZE == data.size())
+    {
+        index.resize(footer->framesCount);
+        for (size_t i = 0; i < index.size(); ++i)
+        {
+            index[i] = boost::endian::load_little_u64(data.data() + footer->indexOffset + i * sizeof(uint64_t));
+        }
+    }
+    else
+    {
+        // recording was interrupted - index complete frame records
+        uint64_t offset = RawVideoFile::FILE_HEADER_SIZE;
+        while (const auto frameHeader = RawVideoFile::readFrameHeader(data.subspan(offset)))
+        {
+            const size_t recordSize = RawVideoFile::getRecordSize(frameHeader->dataSize);
+            if (offset + RawVideoFile::FRAME_HEADER_SIZE + frameHeader->dataSize > data.size())
+            {
+                break;
+            }
+
+            index.push_back(offset);
+            offset = std::min<uint64_t>(offset + recordSize, data.size());
+        }
+    }
+
+    return std::shared_ptr<RawVideoReplayStream>(new RawVideoReplayStream(file, fileHeader.value(), std::move(index), pacing, loop));
+}
+
+VoidResult RawVideoReplayStream::startStream(ImageData::Type type)
+{
+    std::lock_guard lock(m_mutex);
+
+    m_playlist.clear();
+    for (const uint64_t offset : m_index)
+    {
+        const auto header = readFrameHeader(offset);
+        if (!header.has_value())
+        {
+            return VoidResult::createError("Corrupted video file!", utils::format("invalid frame record at offset {}", offset));
+        }
+        if (header->type == type)
+        {
+            m_playlist.push_back(offset);
+        }
+    }
+
+    if (m_playlist.empty())
+    {
+        return VoidResult::createError("Recording contains no frames of requested type!", utils::format("type {}", static_cast<int>(type)));
+    }
+
+    const auto first = readFrameHeader(m_playlist.front())->metadata;
+    const auto last = readFrameHeader(m_playlist.back())->metadata;
+
+    // one more (average) frame interval between last frame and first frame of next loop
+    const auto recordedDuration = getRecordedTime(last) - getRecordedTime(first);
+    m_loopDuration = m_playlist.size() > 1 ? recordedDuration + recordedDuration / static_cast<int64_t>(m_playlist.size() - 1) : std::chrono::nanoseconds(0);
+    m_loopSequenceLength = last.sequenceNumber - first.sequenceNumber + 1;
+
+    m_type = type;
+    m_position = 0;
+    m_loopsCount = 0;
+    m_recordedStart = getRecordedTime(first);
+    m_replayStart = std::chrono::steady_clock::now();
+    m_running = true;
+
+    return VoidResult::createOk();
+}
+
+VoidResult RawVideoReplayStream::stopStream()
+{
+    m_running = false;
+    return VoidResult::createOk();
+}
+
+bool RawVideoReplayStream::isRunning() const
+{
+    return m_running;
+}
+
+VoidResult RawVideoReplayStream::readFrame(Frame& frame)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (!m_running)
+    {
+        return VoidResult::createError("Stream is not running!");
+    }
+
+    if (m_position >= m_playlist.size())
+    {
+        if (!m_loop)
+        {
+            return VoidResult::createError("End of recording!");
+        }
+        m_position = 0;
+        ++m_loopsCount;
+    }
+
+    const uint64_t offset = m_playlist[m_position++];
+    const auto header = readFrameHeader(offset);
+    if (!header.has_value())
+    {
+        return VoidResult::createError("Corrupted video file!", utils::format("invalid frame record at offset {}", offset));
+    }
+
+    // later loops continue in sequence numbers and device time
+    auto metadata = header->metadata;
+    const auto loopTimeShift = m_loopDuration * static_cast<int64_t>(m_loopsCount);
+    metadata.sequenceNumber += m_loopSequenceLength * m_loopsCount;
+    if (metadata.deviceTimestamp.has_value())
+    {
+        metadata.deviceTimestamp = metadata.deviceTimestamp.value() + loopTimeShift;
+    }
+
+    const auto dueTime = m_replayStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(getRecordedTime(header->metadata) - m_recordedStart + loopTimeShift);
+    lock.unlock();
+
+    if (m_pacing == Pacing::RECORDED)
+    {
+        // stopStream is not blocked by long pause of recording
+        for (auto now = std::chrono::steady_clock::now(); m_running && now < dueTime; now = std::chrono::steady_clock::now())
+        {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(dueTime - now, STOP_CHECK_INTERVAL));
+        }
+    }
+
+    metadata.hostTimestamp = std::chrono::steady_clock::now();
+
+    frame.assign(header->type, m_file->getData().subspan(offset + RawVideoFile::FRAME_HEADER_SIZE, header->dataSize), m_file, nullptr);
+    frame.setMetadata(metadata);
+    return VoidResult::createOk();
+}
+
+const RawVideoFile::FileHeader& RawVideoReplayStream::getFileHeader() const
+{
+    return m_fileHeader;
+}
+
+size_t RawVideoReplayStream::getFramesCount() const
+{
+    return m_index.size();
+}
+
+VoidResult RawVideoReplayStream::seek(size_t position)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (!m_running)
+    {
+        return VoidResult::createError("Stream is not running!");
+    }
+    if (position >= m_playlist.size())
+    {
+        return VoidResult::createError("Invalid position!", utils::format("position {} of {} frames", position, m_playlist.size()));
+    }
+
+    const auto header = readFrameHeader(m_playlist[position]);
+    if (!header.has_value())
+    {
+        return VoidResult::createError("Corrupted video file!", utils::format("invalid frame record at offset {}", m_playlist[position]));
+    }
+
+    // sought frame is due immediately
+    m_position = position;
+    m_replayStart = std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(getRecordedTime(header->metadata) - m_recordedStart + m_loopDuration * static_cast<int64_t>(m_loopsCount));
+    return VoidResult::createOk();
+}
+
+std::optional<RawVideoFile::FrameHeader> RawVideoReplayStream::readFrameHeader(uint64_t offset) const
+{
+    const auto data = m_file->getData();
+    if (offset + RawVideoFile::FRAME_HEADER_SIZE > data.size())
+    {
+        return std::nullopt;
+    }
+
+    const auto header = RawVideoFile::readFrameHeader(data.subspan(offset));
+    if (!header.has_value() || offset + RawVideoFile::FRAME_HEADER_SIZE + header->dataSize > data.size())
+    {
+        return std::nullopt;
+    }
+    return header;
+}
+
+std::chrono::nanoseconds RawVideoReplayStream::getRecordedTime(const FrameMetadata& metadata)
+{
+    // device time is not affected by host scheduling during recording
+    return metadata.deviceTimestamp.value_or(std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.hostTimestamp.time_since_epoch()));
+}
+
+} // namespace core
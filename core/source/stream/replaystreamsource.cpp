@@ -0,0 +1,62 @@
+#include "core/stream/replaystreamsource.h"
+
+#include "core/misc/resultmacros.h"
+
+
+namespace core
+{
+
+ReplayStreamSource::ReplayStreamSource(const StreamFactory& streamFactory) :
+    m_streamFactory(streamFactory)
+{
+}
+
+std::shared_ptr<ReplayStreamSource> ReplayStreamSource::createFromRecording(const std::string& filename, RawVideoReplayStream::Pacing pacing, bool loop)
+{
+    return std::shared_ptr<ReplayStreamSource>(new ReplayStreamSource([filename, pacing, loop]() -> ValueResult<std::shared_ptr<IStream>>
+    {
+        using ResultType = ValueResult<std::shared_ptr<IStream>>;
+
+        TRY_GET_RESULT(auto stream, RawVideoReplayStream::createStream(filename, pacing, loop));
+        return ResultType(std::shared_ptr<IStream>(stream));
+    }));
+}
+
+std::shared_ptr<ReplayStreamSource> ReplayStreamSource::createSynthetic(std::chrono::nanoseconds frameInterval)
+{
+    return std::shared_ptr<ReplayStreamSource>(new ReplayStreamSource([frameInterval]() -> ValueResult<std::shared_ptr<IStream>>
+    {
+        return std::shared_ptr<IStream>(SyntheticStream::createStream(frameInterval));
+    }));
+}
+
+ValueResult<std::shared_ptr<IStream>> ReplayStreamSource::getOrCreateStream()
+{
+    using ResultType = ValueResult<std::shared_ptr<IStream>>;
+
+    std::lock_guard lock(m_mutex);
+
+    if (auto stream = m_stream.lock())
+    {
+        return ResultType(stream);
+    }
+
+    TRY_GET_RESULT(const auto stream, m_streamFactory());
+    m_stream = stream;
+    return ResultType(stream);
+}
+
+ValueResult<std::shared_ptr<IStream>> ReplayStreamSource::getStream()
+{
+    using ResultType = ValueResult<std::shared_ptr<IStream>>;
+
+    std::lock_guard lock(m_mutex);
+
+    if (auto stream = m_stream.lock())
+    {
+        return ResultType(stream);
+    }
+    return ResultType::createError("No stream is present!");
+}
+
+} // namespace core
@@ -0,0 +1,328 @@
+#include "core/stream/streamhub.h"
+
+#include "core/misc/imagecolorization.h"
+#include "core/execution.h"
+#include "core/utils.h"
+
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr size_t CACHED_TYPES_COUNT = 3;
+
+void convertRaw14ToPaletteIndices(std::span<const uint8_t> rawData, std::vector<uint8_t>& indices)
+{
+    const auto [min, max] = colorization::findRaw14MinMax(rawData);
+    const auto window = colorization::Raw14Window::create(min, max);
+
+    indices.resize(rawData.size() / 2);
+    const auto idxRange = boost::irange(std::size_t(0), indices.size());
+    std::for_each(STD_EXECUTION_PAR_UNSEQ idxRange.begin(), idxRange.end(), [&](const std::size_t idx)
+    {
+        indices[idx] = window.getPaletteIndex(colorization::readRaw14(rawData.data(), idx));
+    });
+}
+
+} // namespace
+
+StreamHub::StreamHub(const std::shared_ptr<IStream>& stream, size_t capacity) :
+    m_stream(stream),
+    m_grabber(FrameGrabber::createInstance(stream, capacity, FrameGrabber::OverflowPolicy::OVERWRITE_OLDEST)),
+    m_cacheCapacity(std::max<size_t>(capacity, 1) * CACHED_TYPES_COUNT)
+{
+}
+
+StreamHub::~StreamHub()
+{
+    stop();
+}
+
+std::shared_ptr<StreamHub> StreamHub::createInstance(const std::shared_ptr<IStream>& stream, size_t capacity)
+{
+    return std::shared_ptr<StreamHub>(new StreamHub(stream, capacity));
+}
+
+VoidResult StreamHub::start(ImageData::Type acquisitionType)
+{
+    if (m_grabber->isRunning())
+    {
+        if (acquisitionType != m_acquisitionType)
+        {
+            return VoidResult::createError("Stream hub is already running!", "different acquisition type requested");
+        }
+        return VoidResult::createOk();
+    }
+
+    if (m_stream == nullptr)
+    {
+        return VoidResult::createError("Stream is not available!");
+    }
+
+    // subscribers were checked against acquisition type valid when they subscribed, lock held until new type is set
+    std::lock_guard lock(m_subscribersMutex);
+    std::erase_if(m_subscribers, [](const std::weak_ptr<Subscriber>& subscriber)
+    {
+        return subscriber.expired();
+    });
+
+    for (const auto& weakSubscriber : m_subscribers)
+    {
+        if (const auto subscriber = weakSubscriber.lock(); subscriber != nullptr && !isConversionSupported(acquisitionType, subscriber->getType()))
+        {
+            return VoidResult::createError("Unsupported stream format!", utils::format("subscriber of {} cannot be served from {}", static_cast<int>(subscriber->getType()), static_cast<int>(acquisitionType)));
+        }
+    }
+
+    if (auto result = m_stream->startStream(acquisitionType); !result.isOk())
+    {
+        return result;
+    }
+
+    m_acquisitionType = acquisitionType;
+    if (auto result = m_grabber->start(); !result.isOk())
+    {
+        (void)m_stream->stopStream();
+        return result;
+    }
+
+    return VoidResult::createOk();
+}
+
+void StreamHub::stop()
+{
+    if (!m_grabber->isRunning())
+    {
+        return;
+    }
+
+    m_grabber->stop();
+    (void)m_stream->stopStream();
+
+    std::lock_guard lock(m_cacheMutex);
+    m_cache.clear();
+}
+
+bool StreamHub::isRunning() const
+{
+    return m_grabber->isRunning();
+}
+
+ImageData::Type StreamHub::getAcquisitionType() const
+{
+    return m_acquisitionType;
+}
+
+Palette StreamHub::getPalette() const
+{
+    std::lock_guard lock(m_paletteMutex);
+    return m_palette;
+}
+
+void StreamHub::setPalette(const Palette& palette)
+{
+    std::lock_guard lock(m_paletteMutex);
+    m_palette = palette;
+}
+
+bool StreamHub::isConversionSupported(ImageData::Type from, ImageData::Type to)
+{
+    if (from == to)
+    {
+        return true;
+    }
+
+    switch (to)
+    {
+    case ImageData::Type::PaletteIndices:
+        return from == ImageData::Type::Raw14Bit;
+    case ImageData::Type::RGB:
+        return from == ImageData::Type::Raw14Bit || from == ImageData::Type::PaletteIndices || from == ImageData::Type::YUYV422;
+    case ImageData::Type::Raw14Bit:
+    case ImageData::Type::YUYV422:
+        break;
+    }
+
+    return false;
+}
+
+ValueResult<std::shared_ptr<StreamHub::Subscriber>> StreamHub::subscribe(ImageData::Type type)
+{
+    using ResultType = ValueResult<std::shared_ptr<Subscriber>>;
+
+    // same lock as start - acquisition type cannot change in between
+    std::lock_guard lock(m_subscribersMutex);
+
+    if (!isConversionSupported(m_acquisitionType, type))
+    {
+        return ResultType::createError("Unsupported stream format!", utils::format("conversion from {} to {} is not supported", static_cast<int>(m_acquisitionType.load()), static_cast<int>(type)));
+    }
+
+    auto subscriber = std::make_shared<Subscriber>(shared_from_this(), m_grabber->createConsumer(), type);
+    std::erase_if(m_subscribers, [](const std::weak_ptr<Subscriber>& weakSubscriber)
+    {
+        return weakSubscriber.expired();
+    });
+    m_subscribers.push_back(subscriber);
+    return subscriber;
+}
+
+uint64_t StreamHub::getConversionsCount() const
+{
+    return m_conversionsCount;
+}
+
+FrameGrabber::Statistics StreamHub::getStatistics() const
+{
+    return m_grabber->getStatistics();
+}
+
+StreamHub::ConvertedData StreamHub::getConverted(const FrameGrabber::FrameRef& frameRef, ImageData::Type type)
+{
+    std::unique_lock lock(m_cacheMutex);
+
+    const auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CacheEntry& entry)
+    {
+        return entry.sequence == frameRef.getSequence() && entry.type == type;
+    });
+
+    if (it != m_cache.end())
+    {
+        // other subscriber may still be converting - wait for it instead of converting again
+        auto data = it->data;
+        lock.unlock();
+        return data.get();
+    }
+
+    std::promise<ConvertedData> promise;
+    m_cache.push_back(CacheEntry{frameRef.getSequence(), type, promise.get_future().share()});
+    while (m_cache.size() > m_cacheCapacity)
+    {
+        m_cache.pop_front();
+    }
+    lock.unlock();
+
+    // conversion outside of lock - different formats and frames are converted concurrently
+    try
+    {
+        auto result = convert(frameRef, type);
+        promise.set_value(result);
+        return result;
+    }
+    catch (...)
+    {
+        // subscribers waiting for this conversion get the same exception instead of broken promise
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+StreamHub::ConvertedData StreamHub::convert(const FrameGrabber::FrameRef& frameRef, ImageData::Type type)
+{
+    ++m_conversionsCount;
+
+    const auto& frame = frameRef.getFrame();
+    auto result = std::make_shared<ImageData>(type);
+    result->metadata = frame.getMetadata();
+
+    if (frame.getType() == type)
+    {
+        frame.copyTo(*result);
+        return result;
+    }
+
+    switch (type)
+    {
+    case ImageData::Type::PaletteIndices:
+        assert(frame.getType() == ImageData::Type::Raw14Bit);
+        convertRaw14ToPaletteIndices(frame.getData(), result->data);
+        break;
+
+    case ImageData::Type::RGB:
+    {
+        using namespace colorization;
+
+        if (frame.getType() == ImageData::Type::YUYV422)
+        {
+            result->data.resize(ImageColorization::getColorDataSize<PixelFormat::RGB24>(ImageData::Type::YUYV422, frame.getData().size()));
+            ImageColorization::colorize<PixelFormat::RGB24>(std::nullopt, ImageData::Type::YUYV422, frame.getData(), 0, result->data);
+            break;
+        }
+
+        // through (shared) palette indices - subscribers of indices and RGB convert raw data only once
+        const auto paletteIndices = frame.getType() == ImageData::Type::PaletteIndices ? nullptr : getConverted(frameRef, ImageData::Type::PaletteIndices);
+        const auto indices = paletteIndices != nullptr ? std::span<const uint8_t>(paletteIndices->data) : frame.getData();
+
+        result->data.resize(ImageColorization::getColorDataSize<PixelFormat::RGB24>(ImageData::Type::PaletteIndices, indices.size()));
+        ImageColorization::colorize<PixelFormat::RGB24>(getPalette(), ImageData::Type::PaletteIndices, indices, 0, result->data);
+        break;
+    }
+
+    case ImageData::Type::Raw14Bit:
+    case ImageData::Type::YUYV422:
+        assert(false && "Unsupported conversion!");
+        break;
+    }
+
+    return result;
+}
+
+
+StreamHub::Subscriber::Subscriber(const std::shared_ptr<StreamHub>& hub, const std::shared_ptr<FrameGrabber::Consumer>& consumer, ImageData::Type type) :
+    m_hub(hub),
+    m_consumer(consumer),
+    m_type(type)
+{
+}
+
+ImageData::Type StreamHub::Subscriber::getType() const
+{
+    return m_type;
+}
+
+std::shared_ptr<const ImageData> StreamHub::Subscriber::read(std::chrono::steady_clock::duration timeout)
+{
+    FrameGrabber::FrameRef frameRef;
+    if (!m_consumer->read(frameRef, timeout))
+    {
+        return nullptr;
+    }
+
+    // frame stays pinned during conversion
+    return m_hub->getConverted(frameRef, m_type);
+}
+
+bool StreamHub::Subscriber::readFrame(FrameGrabber::FrameRef& frameRef, std::chrono::steady_clock::duration timeout)
+{
+    return m_consumer->read(frameRef, timeout);
+}
+
+ValueResult<bool> StreamHub::Subscriber::readFiltered(TemporalFilter& filter, ImageData& output, std::chrono::steady_clock::duration timeout)
+{
+    FrameGrabber::FrameRef frameRef;
+    if (!m_consumer->read(frameRef, timeout))
+    {
+        return false;
+    }
+
+    if (const auto result = filter.filter(frameRef.getFrame(), output); !result.isOk())
+    {
+        return ValueResult<bool>::createFromError(result);
+    }
+
+    return true;
+}
+
+uint64_t StreamHub::Subscriber::getDroppedFramesCount() const
+{
+    return m_consumer->getDroppedFramesCount();
+}
+
+} // namespace core
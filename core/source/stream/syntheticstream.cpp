@@ -0,0 +1,165 @@
+#include "core/stream/syntheticstream.h"
+
+#include "core/utils.h"
+
+#include <cassert>
+#include <thread>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr auto STOP_CHECK_INTERVAL = std::chrono::milliseconds(10);
+
+constexpr uint16_t RAW14_BACKGROUND = 6000;
+constexpr uint16_t RAW14_HOT_SPOT = 12000;
+constexpr uint8_t Y_HOT_SPOT = 235;
+constexpr uint8_t UV_NEUTRAL = 128;
+constexpr size_t HOT_SPOT_SIZE = 32;
+
+struct Pattern
+{
+    explicit Pattern(uint64_t frameNumber) :
+        shift(frameNumber * 2),
+        hotSpotX((frameNumber * 3) % (SyntheticStream::WIDTH_INPUT_STREAM - HOT_SPOT_SIZE)),
+        hotSpotY((frameNumber * 2) % (SyntheticStream::HEIGHT_INPUT_STREAM - HOT_SPOT_SIZE))
+    {
+    }
+
+    bool isHotSpot(size_t x, size_t y) const
+    {
+        return x - hotSpotX < HOT_SPOT_SIZE && y - hotSpotY < HOT_SPOT_SIZE;
+    }
+
+    // diagonal gradient moving by two pixels per frame
+    size_t getGradient(size_t x, size_t y) const
+    {
+        return x + y + shift;
+    }
+
+    uint64_t shift;
+    size_t hotSpotX;
+    size_t hotSpotY;
+};
+
+} // namespace
+
+SyntheticStream::SyntheticStream(std::chrono::nanoseconds frameInterval) :
+    m_frameInterval(frameInterval),
+    m_bufferPool(FrameBufferPool::createInstance(BUFFERS_COUNT, WIDTH_INPUT_STREAM * HEIGHT_INPUT_STREAM * 2))
+{
+}
+
+SyntheticStream::~SyntheticStream()
+{
+}
+
+std::shared_ptr<SyntheticStream> SyntheticStream::createStream(std::chrono::nanoseconds frameInterval)
+{
+    return std::shared_ptr<SyntheticStream>(new SyntheticStream(frameInterval));
+}
+
+VoidResult SyntheticStream::startStream(ImageData::Type type)
+{
+    if (type != ImageData::Type::Raw14Bit && type != ImageData::Type::YUYV422)
+    {
+        return VoidResult::createError("Unknown video format!", utils::format("type {}", static_cast<int>(type)));
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_type = type;
+    m_frameNumber = 0;
+    m_startTime = std::chrono::steady_clock::now();
+    m_running = true;
+
+    return VoidResult::createOk();
+}
+
+VoidResult SyntheticStream::stopStream()
+{
+    m_running = false;
+    return VoidResult::createOk();
+}
+
+bool SyntheticStream::isRunning() const
+{
+    return m_running;
+}
+
+VoidResult SyntheticStream::readFrame(Frame& frame)
+{
+    std::unique_lock lock(m_mutex);
+    if (!m_running)
+    {
+        return VoidResult::createError("Stream is not running!");
+    }
+
+    const auto type = m_type;
+    const uint64_t frameNumber = m_frameNumber++;
+    const auto dueTime = m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_frameInterval * frameNumber);
+    lock.unlock();
+
+    for (auto now = std::chrono::steady_clock::now(); m_running && now < dueTime; now = std::chrono::steady_clock::now())
+    {
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(dueTime - now, STOP_CHECK_INTERVAL));
+    }
+
+    const auto data = m_bufferPool->acquire(frame, type, WIDTH_INPUT_STREAM * HEIGHT_INPUT_STREAM * 2);
+    if (type == ImageData::Type::Raw14Bit)
+    {
+        generateRaw14(frameNumber, data);
+    }
+    else
+    {
+        generateYuyv422(frameNumber, data);
+    }
+
+    FrameMetadata metadata;
+    metadata.hostTimestamp = std::chrono::steady_clock::now();
+    if (m_frameInterval.count() > 0)
+    {
+        metadata.deviceTimestamp = m_frameInterval * frameNumber;
+    }
+    metadata.sequenceNumber = frameNumber;
+    frame.setMetadata(metadata);
+
+    return VoidResult::createOk();
+}
+
+void SyntheticStream::generateRaw14(uint64_t frameNumber, std::span<uint8_t> data)
+{
+    assert(data.size() >= WIDTH_INPUT_STREAM * HEIGHT_INPUT_STREAM * 2);
+
+    const Pattern pattern(frameNumber);
+    for (size_t y = 0; y < HEIGHT_INPUT_STREAM; ++y)
+    {
+        uint8_t* row = data.data() + y * WIDTH_INPUT_STREAM * 2;
+        for (size_t x = 0; x < WIDTH_INPUT_STREAM; ++x)
+        {
+            const uint16_t value = pattern.isHotSpot(x, y) ? RAW14_HOT_SPOT : static_cast<uint16_t>(RAW14_BACKGROUND + (pattern.getGradient(x, y) % 1024) * 2);
+            row[x * 2] = static_cast<uint8_t>(value);
+            row[x * 2 + 1] = static_cast<uint8_t>(value >> 8);
+        }
+    }
+}
+
+void SyntheticStream::generateYuyv422(uint64_t frameNumber, std::span<uint8_t> data)
+{
+    assert(data.size() >= WIDTH_INPUT_STREAM * HEIGHT_INPUT_STREAM * 2);
+
+    const Pattern pattern(frameNumber);
+    for (size_t y = 0; y < HEIGHT_INPUT_STREAM; ++y)
+    {
+        uint8_t* row = data.data() + y * WIDTH_INPUT_STREAM * 2;
+        for (size_t x = 0; x < WIDTH_INPUT_STREAM; ++x)
+        {
+            row[x * 2] = pattern.isHotSpot(x, y) ? Y_HOT_SPOT : static_cast<uint8_t>(pattern.getGradient(x, y));
+            row[x * 2 + 1] = UV_NEUTRAL;
+        }
+    }
+}
+
+} // namespace core
@@ -361,10 +361,33 @@ DataLinkEbus::EbusStream::~EbusStream()
 {
 }
 
+namespace
+{
+
+class PipelineBufferOwner final : public IFrameBufferOwner
+{
+public:
+    explicit PipelineBufferOwner(const std::shared_ptr<PvPipeline>& pipeline) :
+        m_pipeline(pipeline)
+    {
+    }
+
+    virtual void releaseFrameBuffer(void* handle) override
+    {
+        m_pipeline->ReleaseBuffer(static_cast<PvBuffer*>(handle));
+    }
+
+private:
+    std::shared_ptr<PvPipeline> m_pipeline;
+};
+
+} // namespace
+
 DataLinkEbus::EbusStream::StreamData::StreamData(const std::shared_ptr<PvStream>& stream, const std::shared_ptr<PvPipeline>& pipeline, ImageData::Type dataType) :
     stream(stream),
     pipeline(pipeline),
-    dataType(dataType)
+    dataType(dataType),
+    bufferOwner(std::make_shared<PipelineBufferOwner>(pipeline))
 {
 }
 
@@ -515,6 +538,12 @@ VoidResult DataLinkEbus::EbusStream::startStream(ImageData::Type dataType)
     }
 
     m_streamData.emplace(stream, pipeline, dataType);
+    if (deviceParams->GetIntegerValue("GevTimestampTickFrequency", m_streamData->timestampTickFrequency).IsFailure())
+    {
+        m_streamData->timestampTickFrequency = 0;
+    }
+    m_metadataTracker.reset();
+
     return VoidResult::createOk();
 }
 
@@ -552,8 +581,10 @@ bool DataLinkEbus::EbusStream::isRunning() const
     return m_streamData.has_value();
 }
 
-VoidResult DataLinkEbus::EbusStream::readImageData(ImageData& imageData)
+VoidResult DataLinkEbus::EbusStream::readFrame(Frame& frame)
 {
+    frame.reset();
+
     if (!m_streamData.has_value())
     {
         return VoidResult::createError("Stream is not running!");
@@ -577,12 +608,16 @@ VoidResult DataLinkEbus::EbusStream::readImageData(ImageData& imageData)
         continue;
     }
 
-    imageData.type = streamData.dataType;
+    std::optional<std::chrono::nanoseconds> deviceTimestamp;
+    if (streamData.timestampTickFrequency > 0)
+    {
+        const auto ticks = pvBuffer->GetTimestamp();
+        const auto frequency = static_cast<uint64_t>(streamData.timestampTickFrequency);
+        deviceTimestamp = std::chrono::seconds(ticks / frequency) + std::chrono::nanoseconds((ticks % frequency) * 1000000000 / frequency);
+    }
 
-    uint8_t* buffer = pvBuffer->GetDataPointer();
-    imageData.data.resize(pvBuffer->GetSize());
-    std::memcpy(imageData.data.data(), buffer, pvBuffer->GetSize());
-    streamData.pipeline->ReleaseBuffer(pvBuffer);
+    frame.assign(streamData.dataType, std::span<const uint8_t>(pvBuffer->GetDataPointer(), pvBuffer->GetSize()), streamData.bufferOwner, pvBuffer);
+    frame.setMetadata(m_metadataTracker.createFromBlockId(pvBuffer->GetBlockID(), deviceTimestamp));
 
     return VoidResult::createOk();
 }
@@ -60,7 +60,7 @@ private:
         [[nodiscard]] virtual VoidResult startStream(ImageData::Type dataType) override;
         [[nodiscard]] virtual VoidResult stopStream() override;
         [[nodiscard]] virtual bool isRunning() const override;
-        [[nodiscard]] virtual VoidResult readImageData(ImageData& imageData) override;
+        [[nodiscard]] virtual VoidResult readFrame(Frame& frame) override;
 
         [[nodiscard]] static ValueResult<std::shared_ptr<EbusStream>> createStream(const std::shared_ptr<PvDevice>& device);
         static constexpr uint16_t WIDTH_INPUT_STREAM = 640;
@@ -74,10 +74,15 @@ private:
             std::shared_ptr<PvStream> stream;
             std::shared_ptr<PvPipeline> pipeline;
             ImageData::Type dataType;
+            // frames borrow pipeline buffers, buffer is released back to pipeline with frame
+            std::shared_ptr<IFrameBufferOwner> bufferOwner;
+            // ticks per second of PvBuffer timestamps, 0 if device does not report it
+            int64_t timestampTickFrequency {0};
 
             explicit StreamData(const std::shared_ptr<PvStream>& stream, const std::shared_ptr<PvPipeline>& pipeline, ImageData::Type dataType);
         };        
         std::optional<StreamData> m_streamData;
+        FrameMetadataTracker m_metadataTracker;
         PvString m_pathToExecutableFolder = "";
     };
 
@@ -140,14 +140,26 @@ void Example::videoThread()
             WW_LOG_PROPERTIES_WARNING << "Video thread: Failed to create properties transaction (likely blocked by exclusive lock).";
         }
 
+        // snapshot is readable even while exclusive lock is held
+        const auto snapshot = m_properties->getSnapshot();
+        auto snapshotTemperature = snapshot->getValue<double>(core::PropertyIdWtc640::SHUTTER_TEMPERATURE);
+        if (snapshotTemperature.containsValue())
+        {
+            WW_LOG_PROPERTIES_INFO << "Video thread: (Snapshot " << snapshot->getVersion() << ") Shutter temperature = " << snapshotTemperature.getValue();
+        }
+
         if (m_videoStream && m_videoStream->isRunning())
         {
-            core::ImageData imageData{core::ImageData::Type::RGB};
-            auto readResult = m_videoStream->readImageData(imageData);
+            core::Frame frame;
+            auto readResult = m_videoStream->readFrame(frame);
             if (!readResult.isOk())
             {
                 WW_LOG_CONNECTION_FATAL << "Video thread: Failed to read image data: " << readResult.toString();
             }
+            else
+            {
+                WW_LOG_CONNECTION_INFO << "Video thread: Frame " << frame.getMetadata().sequenceNumber << " (dropped so far: " << frame.getMetadata().droppedFramesCount << ")";
+            }
         }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -0,0 +1,37 @@
+#ifndef CORE_CAPTUREDFRAMES_H
+#define CORE_CAPTUREDFRAMES_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+// captured raw frames in one contiguous buffer
+class CapturedFrames
+{
+public:
+    explicit CapturedFrames() = default;
+    explicit CapturedFrames(size_t framesCount, size_t pixelsPerFrame);
+
+    size_t getFramesCount() const;
+    size_t getPixelsPerFrame() const;
+
+    std::span<const uint16_t> getFrame(size_t index) const;
+    std::span<uint16_t> getFrame(size_t index);
+
+    std::span<const uint16_t> getData() const;
+    std::span<uint16_t> getData();
+
+    std::vector<std::vector<uint16_t>> toVectors() const;
+
+private:
+    size_t m_pixelsPerFrame {0};
+    std::vector<uint16_t> m_data;
+};
+
+} // namespace core
+
+#endif // CORE_CAPTUREDFRAMES_H
@@ -0,0 +1,53 @@
+#ifndef CORE_DEADPIXELSREPLACEMENT_H
+#define CORE_DEADPIXELSREPLACEMENT_H
+
+#include "core/wtc640/deadpixels.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+// host-side dead pixel replacement for raw frames captured without on board replacement
+// dead pixel = average of its (1 or 2) replacement pixels, replacement pixels are never dead => order of entries does not matter
+class DeadPixelsReplacement
+{
+public:
+    explicit DeadPixelsReplacement() = default;
+
+    [[nodiscard]] static ValueResult<DeadPixelsReplacement> create(const DeadPixels& deadPixels);
+    [[nodiscard]] static ValueResult<DeadPixelsReplacement> create(const std::vector<DeadPixel>& deadPixels, const std::vector<ReplacementPixel>& replacements);
+
+    const core::Size& getResolutionInPixels() const;
+
+    // dead pixels with at least one replacement
+    size_t getSize() const;
+
+    // raw data are little endian 16bit values of whole frame
+    [[nodiscard]] VoidResult applyToRaw14(std::span<uint8_t> rawData) const;
+
+    [[nodiscard]] VoidResult apply(std::span<uint16_t> frame) const;
+
+    // frames (e.g. from captureImages) are processed in parallel
+    [[nodiscard]] VoidResult apply(std::vector<std::vector<uint16_t>>& frames) const;
+
+private:
+    void applyImpl(uint8_t* rawData) const;
+
+    core::Size m_resolutionInPixels {0, 0};
+
+    // gather table - pixel indices sorted by destination, one replacement => source A == source B
+    std::vector<uint32_t> m_destinations;
+    std::vector<uint32_t> m_sourcesA;
+    std::vector<uint32_t> m_sourcesB;
+
+    // vector gathers read 32 bits per pixel - entries using last pixel of frame are at the end and done by scalar code
+    size_t m_gatherSafeCount {0};
+};
+
+} // namespace core
+
+#endif // CORE_DEADPIXELSREPLACEMENT_H
@@ -32,6 +32,7 @@ public:
     [[nodiscard]] virtual VoidResult readData(std::span<uint8_t> data, uint32_t address, ProgressTask progress) override;
     [[nodiscard]] virtual VoidResult writeData(const std::span<const uint8_t> data, uint32_t address, ProgressTask progress) override;
     [[nodiscard]] virtual ValueResult<std::vector<uint8_t>> readSomeData(uint32_t address, ProgressTask progress) override;
+    virtual std::optional<uint32_t> getReadPacketSize(uint32_t address) const override;
 
     std::optional<uint32_t> getAccumulatedRegisterChangesAndReset();
 
@@ -0,0 +1,53 @@
+#ifndef CORE_NUCCORRECTION_H
+#define CORE_NUCCORRECTION_H
+
+#include "core/wtc640/postprocessingmatrices.h"
+#include "core/misc/result.h"
+#include "core/device.h"
+#include "core/misc/alignedallocator.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+// host-side non uniformity correction of raw frames with matrices from getPostProcessingMatrices
+// corrected = nuc * (raw + onuc) + offset, rounded and clamped to 14 bits
+class NucCorrection
+{
+public:
+    explicit NucCorrection() = default;
+
+    [[nodiscard]] static ValueResult<NucCorrection> create(const PostProcessingMatrices& matrices);
+
+    const core::Size& getResolutionInPixels() const;
+
+    // raw data are little endian 16bit values of whole frame
+    [[nodiscard]] VoidResult applyToRaw14(std::span<uint8_t> rawData) const;
+
+    [[nodiscard]] VoidResult apply(std::span<uint16_t> frame) const;
+
+    // tiles of all frames are processed in parallel
+    [[nodiscard]] VoidResult apply(std::vector<std::vector<uint16_t>>& frames) const;
+
+    static constexpr size_t TILE_ROWS = 16;
+
+private:
+    void applyToTile(uint8_t* rawData, size_t tile) const;
+
+    size_t getTilesCount() const;
+    size_t getFrameSize() const;
+
+    core::Size m_resolutionInPixels {0, 0};
+
+    // onuc and offset folded into one bias: corrected = gain * raw + bias
+    AlignedVector<float> m_gains;
+    AlignedVector<float> m_biases;
+};
+
+} // namespace core
+
+#endif // CORE_NUCCORRECTION_H
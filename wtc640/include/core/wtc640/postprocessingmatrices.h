@@ -0,0 +1,34 @@
+#ifndef CORE_POSTPROCESSINGMATRICES_H
+#define CORE_POSTPROCESSINGMATRICES_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace core
+{
+
+struct PostProcessingMatrices
+{
+    std::vector<float> nuc;
+    std::vector<int16_t> onuc;
+    std::vector<int16_t> offset;
+
+    PostProcessingMatrices() = default;
+
+    // matrices in device memory are interleaved - 4 words per pixel: reserved, onuc, nuc (fixed point), offset
+    static constexpr size_t WORDS_PER_PIXEL = 4;
+    static constexpr int16_t NUC_FACTOR = 1 << 14;
+
+    void resize(size_t pixelsCount);
+
+    // decodes words of whole pixels (e.g. one chunk of streamed read) to pixels from firstPixel - matrices must be already resized
+    void decodeInterleaved(std::span<const uint16_t> words, size_t firstPixel);
+
+    static PostProcessingMatrices createFromInterleaved(std::span<const uint16_t> words);
+};
+
+} // namespace core
+
+#endif // CORE_POSTPROCESSINGMATRICES_H
@@ -3,6 +3,8 @@
 
 #include "core/wtc640/devicewtc640.h"
 #include "core/wtc640/memoryspacewtc640.h"
+#include "core/wtc640/postprocessingmatrices.h"
+#include "core/wtc640/capturedframes.h"
 #include "core/properties/properties.h"
 #include "core/properties/propertyadaptervaluedevicesimple.h"
 #include "core/properties/propertyadaptervaluedeviceprogress.h"
@@ -92,15 +94,6 @@ public:
     [[nodiscard]] static uint32_t getMask(Item trigger);
 };
 
-struct PostProcessingMatrices
-{
-    std::vector<float> nuc;
-    std::vector<int16_t> onuc;
-    std::vector<int16_t> offset;
-
-    PostProcessingMatrices() = default;
-};
-
 class PropertiesWtc640 : public Properties
 {
     using BaseClass = Properties;
@@ -413,6 +406,22 @@ protected:
      */
     virtual void onTransactionFinished(const TransactionSummary& transactionSummary) override;
 
+    /**
+     * @brief Checks if the property may be restored from properties cache (its value is not changed by the device itself).
+     * @param propertyId The property ID.
+     * @return True if the property is cacheable, false otherwise.
+     */
+    virtual bool isPropertyCacheable(PropertyId propertyId) const override;
+
+    /**
+     * @brief Reads the properties cache key - serial number, main firmware version and checksum of the cached ranges
+     *        (palette registers are checksummed through their flash image).
+     * @param device The device interface.
+     * @param cachedRanges The address ranges stored in the cache.
+     * @return A result containing the key.
+     */
+    [[nodiscard]] virtual ValueResult<std::string> readPropertiesCacheDeviceKey(connection::IDeviceInterface* device, const connection::AddressRanges& cachedRanges) override;
+
 private:
     using AddressRange = connection::AddressRange;
     using MemorySpaceWtc640 = connection::MemorySpaceWtc640;
@@ -651,6 +660,8 @@ private:
     void addValueAdapterImpl(const std::shared_ptr<PropertyValueEnum<VideoFormat::Item>>& value, Args&&... args);
 
     static bool isUpdateGroupChanged(const StatusWtc640& status, const UpdateGroup updateGroup);
+    // range read for cache key instead of cached range (same data read in fewer packets)
+    static AddressRange getPropertiesCacheChecksummedRange(const AddressRange& cachedRange);
 
 private:
     static const std::map<Sensor::Item, std::string> ARTICLE_NUMBER_SENSORS;
@@ -737,6 +748,12 @@ public:
      */
     [[nodiscard]] VoidResult connectEbus(const connection::EbusDevice& device) const;
 
+    /**
+     * @brief Connects to an already opened data link (e.g. emulated device). Such connection can not be reconnected.
+     * @param dataLinkInterface The data link interface.
+     * @return A void result.
+     */
+    [[nodiscard]] VoidResult connectDataLink(const std::shared_ptr<connection::IDataLinkInterface>& dataLinkInterface) const;
 
 
     /**
@@ -833,6 +850,19 @@ public:
      * @return A result containing a vector of captured images.
      */
     [[nodiscard]] ValueResult<std::vector<std::vector<uint16_t>>> captureImages(int imagesCount, ProgressController progressController) const;
+
+    // called on shared worker pool for each frame once it is downloaded (while next frame is downloading), calls are sequential in frame order - error aborts download
+    // may wait for other worker pool tasks (e.g. colorization), must not block on download itself
+    using CapturedFrameCallback = std::function<VoidResult (size_t frameIndex, std::span<const uint16_t> frame)>;
+
+    /**
+     * @brief Captures images into one contiguous buffer, processing of each frame overlaps download of the next one.
+     * @param imagesCount The number of images to capture.
+     * @param frameCallback Optional callback receiving each frame once downloaded (e.g. for analysis or writing to disk).
+     * @param progressController The progress controller.
+     * @return A result containing the captured frames.
+     */
+    [[nodiscard]] ValueResult<CapturedFrames> captureFrames(int imagesCount, const CapturedFrameCallback& frameCallback, ProgressController progressController) const;
     /*!
      * @brief This data is read from RAM, if you want it call getPostProcessingMatrices(), do *NOT* copy/move this struct it cannot guarantee to be kept up to date.
      */
@@ -872,6 +902,25 @@ public:
      */
     [[nodiscard]] ValueResult<std::vector<std::vector<uint16_t>>> readCapturedFrames(uint8_t framesToCaptureCount, uint32_t captureAddress, ProgressController progressController) const;
 
+    /**
+     * @brief Reads the captured frames into one buffer, stops at first failed read or callback.
+     * @param framesToCaptureCount The number of captured frames.
+     * @param captureAddress The capture address.
+     * @param frameCallback Optional callback receiving each frame once downloaded.
+     * @param progressController The progress controller.
+     * @return A result containing the captured frames.
+     */
+    [[nodiscard]] ValueResult<CapturedFrames> readCapturedFrames(uint8_t framesToCaptureCount, uint32_t captureAddress, const CapturedFrameCallback& frameCallback,
+                                                                 ProgressController progressController) const;
+
+    /**
+     * @brief Triggers the capture and reads its address, reports errors to progress controller.
+     * @param imagesCount The number of images to capture.
+     * @param progressController The progress controller.
+     * @return A result containing the address.
+     */
+    [[nodiscard]] ValueResult<uint32_t> startCapture(int imagesCount, ProgressController progressController) const;
+
     /**
      * @brief Activates a trigger.
      * @tparam TriggerType The type of the trigger.
@@ -0,0 +1,61 @@
+#include "core/wtc640/capturedframes.h"
+
+#include <cassert>
+
+
+namespace core
+{
+
+CapturedFrames::CapturedFrames(size_t framesCount, size_t pixelsPerFrame) :
+    m_pixelsPerFrame(pixelsPerFrame),
+    m_data(framesCount * pixelsPerFrame, 0)
+{
+}
+
+size_t CapturedFrames::getFramesCount() const
+{
+    return m_pixelsPerFrame == 0 ? 0 : m_data.size() / m_pixelsPerFrame;
+}
+
+size_t CapturedFrames::getPixelsPerFrame() const
+{
+    return m_pixelsPerFrame;
+}
+
+std::span<const uint16_t> CapturedFrames::getFrame(size_t index) const
+{
+    assert(index < getFramesCount());
+    return getData().subspan(index * m_pixelsPerFrame, m_pixelsPerFrame);
+}
+
+std::span<uint16_t> CapturedFrames::getFrame(size_t index)
+{
+    assert(index < getFramesCount());
+    return getData().subspan(index * m_pixelsPerFrame, m_pixelsPerFrame);
+}
+
+std::span<const uint16_t> CapturedFrames::getData() const
+{
+    return m_data;
+}
+
+std::span<uint16_t> CapturedFrames::getData()
+{
+    return m_data;
+}
+
+std::vector<std::vector<uint16_t>> CapturedFrames::toVectors() const
+{
+    std::vector<std::vector<uint16_t>> frames;
+    frames.reserve(getFramesCount());
+
+    for (size_t i = 0; i < getFramesCount(); ++i)
+    {
+        const auto frame = getFrame(i);
+        frames.emplace_back(frame.begin(), frame.end());
+    }
+
+    return frames;
+}
+
+} // namespace core
@@ -0,0 +1,214 @@
+#include "core/wtc640/deadpixelsreplacement.h"
+
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+#include "core/misc/resultmacros.h"
+#include "core/utils.h"
+#include "core/execution.h"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+
+
+namespace core
+{
+
+namespace
+{
+
+inline void replacePixel(uint8_t* rawData, uint32_t destination, uint32_t sourceA, uint32_t sourceB)
+{
+    const uint32_t a = boost::endian::load_little_u16(rawData + sourceA * 2);
+    const uint32_t b = boost::endian::load_little_u16(rawData + sourceB * 2);
+    boost::endian::store_little_u16(rawData + destination * 2, static_cast<uint16_t>((a + b) >> 1));
+}
+
+void replacePixelsScalar(uint8_t* rawData, const uint32_t* destinations, const uint32_t* sourcesA, const uint32_t* sourcesB, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        replacePixel(rawData, destinations[i], sourcesA[i], sourcesB[i]);
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+// 32bit gathers of 16bit pixels - caller guarantees no source is last pixel of frame
+CORE_TARGET_AVX2 size_t replacePixelsAvx2(uint8_t* rawData, const uint32_t* destinations, const uint32_t* sourcesA, const uint32_t* sourcesB, size_t count)
+{
+    const auto* base = reinterpret_cast<const int*>(rawData);
+    const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indicesA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourcesA + i));
+        const __m256i indicesB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourcesB + i));
+
+        const __m256i a = _mm256_and_si256(_mm256_i32gather_epi32(base, indicesA, 2), lowMask);
+        const __m256i b = _mm256_and_si256(_mm256_i32gather_epi32(base, indicesB, 2), lowMask);
+        const __m256i average = _mm256_srli_epi32(_mm256_add_epi32(a, b), 1);
+
+        // no scatter in avx2
+        alignas(32) std::array<uint32_t, 8> values;
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values.data()), average);
+        for (size_t lane = 0; lane < values.size(); ++lane)
+        {
+            boost::endian::store_little_u16(rawData + destinations[i + lane] * 2, static_cast<uint16_t>(values[lane]));
+        }
+    }
+
+    return i;
+}
+
+#endif // CORE_SIMD_X86
+
+} // namespace
+
+ValueResult<DeadPixelsReplacement> DeadPixelsReplacement::create(const DeadPixels& deadPixels)
+{
+    using ResultType = ValueResult<DeadPixelsReplacement>;
+
+    DeadPixelsReplacement replacement;
+    replacement.m_resolutionInPixels = deadPixels.getResolutionInPixels();
+
+    const auto width = static_cast<unsigned>(replacement.m_resolutionInPixels.width);
+    const auto height = static_cast<unsigned>(replacement.m_resolutionInPixels.height);
+    const uint32_t lastPixelIndex = width * height - 1;
+
+    auto isValid = [width, height](const PixelCoordinates& coordinates)
+    {
+        return coordinates.column < width && coordinates.row < height;
+    };
+
+    struct Entry
+    {
+        uint32_t destination;
+        uint32_t sourceA;
+        uint32_t sourceB;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(deadPixels.getSize());
+
+    for (const auto& [deadPixel, replacements] : deadPixels.getDeadPixelToReplacementsMap())
+    {
+        if (!isValid(deadPixel))
+        {
+            return ResultType::createError("Invalid coordinates!", deadPixel.toString());
+        }
+
+        for (const auto& replacementCoordinates : replacements)
+        {
+            if (!isValid(replacementCoordinates))
+            {
+                return ResultType::createError("Invalid coordinates!", replacementCoordinates.toString());
+            }
+        }
+
+        // without replacement pixel stays as it is
+        if (replacements.empty())
+        {
+            continue;
+        }
+
+        const uint32_t sourceA = replacements.front().getPixelIndex(width);
+        entries.push_back({deadPixel.getPixelIndex(width), sourceA, replacements.size() > 1 ? replacements.at(1).getPixelIndex(width) : sourceA});
+    }
+
+    // map order = destination order, stable partition keeps it within both parts
+    const auto unsafeEntriesIt = std::stable_partition(entries.begin(), entries.end(), [lastPixelIndex](const Entry& entry)
+    {
+        return entry.sourceA != lastPixelIndex && entry.sourceB != lastPixelIndex;
+    });
+    replacement.m_gatherSafeCount = std::distance(entries.begin(), unsafeEntriesIt);
+
+    replacement.m_destinations.reserve(entries.size());
+    replacement.m_sourcesA.reserve(entries.size());
+    replacement.m_sourcesB.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+        replacement.m_destinations.push_back(entry.destination);
+        replacement.m_sourcesA.push_back(entry.sourceA);
+        replacement.m_sourcesB.push_back(entry.sourceB);
+    }
+
+    return replacement;
+}
+
+ValueResult<DeadPixelsReplacement> DeadPixelsReplacement::create(const std::vector<DeadPixel>& deadPixels, const std::vector<ReplacementPixel>& replacements)
+{
+    using ResultType = ValueResult<DeadPixelsReplacement>;
+
+    TRY_GET_RESULT(const auto pixels, DeadPixels::createDeadPixels(deadPixels, replacements));
+
+    return create(pixels);
+}
+
+const core::Size& DeadPixelsReplacement::getResolutionInPixels() const
+{
+    return m_resolutionInPixels;
+}
+
+size_t DeadPixelsReplacement::getSize() const
+{
+    return m_destinations.size();
+}
+
+VoidResult DeadPixelsReplacement::applyToRaw14(std::span<uint8_t> rawData) const
+{
+    const size_t expectedSize = static_cast<size_t>(m_resolutionInPixels.width) * m_resolutionInPixels.height * 2;
+    if (rawData.size() != expectedSize)
+    {
+        return VoidResult::createError("Unable to replace dead pixels!", utils::format("invalid frame size: {} expected: {}", rawData.size(), expectedSize));
+    }
+
+    applyImpl(rawData.data());
+    return VoidResult::createOk();
+}
+
+VoidResult DeadPixelsReplacement::apply(std::span<uint16_t> frame) const
+{
+    static_assert(std::endian::native == std::endian::little, "Frame is processed as little endian raw data!");
+
+    return applyToRaw14(std::span<uint8_t>(reinterpret_cast<uint8_t*>(frame.data()), frame.size_bytes()));
+}
+
+VoidResult DeadPixelsReplacement::apply(std::vector<std::vector<uint16_t>>& frames) const
+{
+    const size_t expectedSize = static_cast<size_t>(m_resolutionInPixels.width) * m_resolutionInPixels.height;
+    for (const auto& frame : frames)
+    {
+        if (frame.size() != expectedSize)
+        {
+            return VoidResult::createError("Unable to replace dead pixels!", utils::format("invalid frame size: {} expected: {}", frame.size(), expectedSize));
+        }
+    }
+
+    // few thousands pixels per frame at most - threads pay off only across frames
+    std::for_each(STD_EXECUTION_PAR_UNSEQ frames.begin(), frames.end(), [this](std::vector<uint16_t>& frame)
+    {
+        applyImpl(reinterpret_cast<uint8_t*>(frame.data()));
+    });
+
+    return VoidResult::createOk();
+}
+
+void DeadPixelsReplacement::applyImpl(uint8_t* rawData) const
+{
+    size_t done = 0;
+
+#if defined(CORE_SIMD_X86)
+    if (simd::getInstructionSet() == simd::InstructionSet::AVX2)
+    {
+        done = replacePixelsAvx2(rawData, m_destinations.data(), m_sourcesA.data(), m_sourcesB.data(), m_gatherSafeCount);
+    }
+#endif
+
+    replacePixelsScalar(rawData, m_destinations.data() + done, m_sourcesA.data() + done, m_sourcesB.data() + done, m_destinations.size() - done);
+}
+
+} // namespace core
@@ -168,6 +168,17 @@ ValueResult<std::vector<uint8_t>> DeviceInterfaceWtc640::readSomeData(uint32_t a
     return data;
 }
 
+std::optional<uint32_t> DeviceInterfaceWtc640::getReadPacketSize(uint32_t address) const
+{
+    const auto memoryDescriptor = getMemoryDescriptorWithChecks(address, std::nullopt, READ_ERROR);
+    if (!memoryDescriptor.isOk())
+    {
+        return std::nullopt;
+    }
+
+    return getMaxDataSize(memoryDescriptor.getValue());
+}
+
 std::optional<uint32_t> DeviceInterfaceWtc640::getAccumulatedRegisterChangesAndReset()
 {
     const std::scoped_lock lock(m_registerChangesMutex);
@@ -0,0 +1,189 @@
+#include "core/wtc640/nuccorrection.h"
+
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+#include "core/wtc640/devicewtc640.h"
+#include "core/utils.h"
+#include "core/execution.h"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/range/irange.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+
+namespace core
+{
+
+namespace
+{
+
+constexpr float MAX_RAW14_VALUE = 0x3FFF;
+
+void correctScalar(uint8_t* rawData, const float* gains, const float* biases, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float value = gains[i] * boost::endian::load_little_u16(rawData + i * 2) + biases[i];
+        boost::endian::store_little_u16(rawData + i * 2, static_cast<uint16_t>(std::nearbyint(std::clamp(value, 0.0f, MAX_RAW14_VALUE))));
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+CORE_TARGET_SSE41 size_t correctSse41(uint8_t* rawData, const float* gains, const float* biases, size_t count)
+{
+    const __m128 min = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(MAX_RAW14_VALUE);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i raw = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rawData + i * 2)));
+        __m128 value = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(raw), _mm_loadu_ps(gains + i)), _mm_loadu_ps(biases + i));
+        value = _mm_min_ps(_mm_max_ps(value, min), max);
+
+        const __m128i corrected = _mm_cvtps_epi32(value);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(rawData + i * 2), _mm_packus_epi32(corrected, corrected));
+    }
+
+    return i;
+}
+
+CORE_TARGET_AVX2 size_t correctAvx2(uint8_t* rawData, const float* gains, const float* biases, size_t count)
+{
+    const __m256 min = _mm256_setzero_ps();
+    const __m256 max = _mm256_set1_ps(MAX_RAW14_VALUE);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i raw = simd::loadRaw16x8(rawData + i * 2);
+        __m256 value = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(raw), _mm256_loadu_ps(gains + i)), _mm256_loadu_ps(biases + i));
+        value = _mm256_min_ps(_mm256_max_ps(value, min), max);
+
+        simd::storeRaw16x8(rawData + i * 2, _mm256_cvtps_epi32(value));
+    }
+
+    return i;
+}
+
+#endif // CORE_SIMD_X86
+
+void correct(uint8_t* rawData, const float* gains, const float* biases, size_t count)
+{
+    size_t done = 0;
+
+#if defined(CORE_SIMD_X86)
+    switch (simd::getInstructionSet())
+    {
+    case simd::InstructionSet::AVX2:
+        done = correctAvx2(rawData, gains, biases, count);
+        break;
+    case simd::InstructionSet::SSE41:
+        done = correctSse41(rawData, gains, biases, count);
+        break;
+    case simd::InstructionSet::SCALAR:
+        break;
+    }
+#endif
+
+    correctScalar(rawData + done * 2, gains + done, biases + done, count - done);
+}
+
+} // namespace
+
+ValueResult<NucCorrection> NucCorrection::create(const PostProcessingMatrices& matrices)
+{
+    using ResultType = ValueResult<NucCorrection>;
+
+    NucCorrection correction;
+    correction.m_resolutionInPixels = core::Size(DevicesWtc640::WIDTH, DevicesWtc640::HEIGHT);
+
+    const size_t pixelsCount = correction.getFrameSize();
+    if (matrices.nuc.size() != pixelsCount || matrices.onuc.size() != pixelsCount || matrices.offset.size() != pixelsCount)
+    {
+        return ResultType::createError("Invalid post processing matrices!", utils::format("sizes - nuc: {} onuc: {} offset: {} expected: {}",
+                                                                                          matrices.nuc.size(), matrices.onuc.size(), matrices.offset.size(), pixelsCount));
+    }
+
+    correction.m_gains.assign(matrices.nuc.begin(), matrices.nuc.end());
+    correction.m_biases.resize(pixelsCount);
+    for (size_t i = 0; i < pixelsCount; ++i)
+    {
+        correction.m_biases[i] = matrices.nuc[i] * matrices.onuc[i] + matrices.offset[i];
+    }
+
+    return correction;
+}
+
+const core::Size& NucCorrection::getResolutionInPixels() const
+{
+    return m_resolutionInPixels;
+}
+
+VoidResult NucCorrection::applyToRaw14(std::span<uint8_t> rawData) const
+{
+    if (rawData.size() != getFrameSize() * 2)
+    {
+        return VoidResult::createError("Unable to apply NUC!", utils::format("invalid frame size: {} expected: {}", rawData.size(), getFrameSize() * 2));
+    }
+
+    const auto tileRange = boost::irange(std::size_t(0), getTilesCount());
+    std::for_each(STD_EXECUTION_PAR_UNSEQ tileRange.begin(), tileRange.end(), [this, &rawData](const std::size_t tile)
+    {
+        applyToTile(rawData.data(), tile);
+    });
+
+    return VoidResult::createOk();
+}
+
+VoidResult NucCorrection::apply(std::span<uint16_t> frame) const
+{
+    static_assert(std::endian::native == std::endian::little, "Frame is processed as little endian raw data!");
+
+    return applyToRaw14(std::span<uint8_t>(reinterpret_cast<uint8_t*>(frame.data()), frame.size_bytes()));
+}
+
+VoidResult NucCorrection::apply(std::vector<std::vector<uint16_t>>& frames) const
+{
+    for (const auto& frame : frames)
+    {
+        if (frame.size() != getFrameSize())
+        {
+            return VoidResult::createError("Unable to apply NUC!", utils::format("invalid frame size: {} expected: {}", frame.size(), getFrameSize()));
+        }
+    }
+
+    const size_t tilesCount = getTilesCount();
+    const auto tileRange = boost::irange(std::size_t(0), frames.size() * tilesCount);
+    std::for_each(STD_EXECUTION_PAR_UNSEQ tileRange.begin(), tileRange.end(), [this, &frames, tilesCount](const std::size_t tile)
+    {
+        applyToTile(reinterpret_cast<uint8_t*>(frames[tile / tilesCount].data()), tile % tilesCount);
+    });
+
+    return VoidResult::createOk();
+}
+
+void NucCorrection::applyToTile(uint8_t* rawData, size_t tile) const
+{
+    const size_t width = m_resolutionInPixels.width;
+    const size_t firstPixel = tile * TILE_ROWS * width;
+    const size_t count = std::min(TILE_ROWS * width, getFrameSize() - firstPixel);
+
+    correct(rawData + firstPixel * 2, m_gains.data() + firstPixel, m_biases.data() + firstPixel, count);
+}
+
+size_t NucCorrection::getTilesCount() const
+{
+    return (static_cast<size_t>(m_resolutionInPixels.height) + TILE_ROWS - 1) / TILE_ROWS;
+}
+
+size_t NucCorrection::getFrameSize() const
+{
+    return static_cast<size_t>(m_resolutionInPixels.width) * m_resolutionInPixels.height;
+}
+
+} // namespace core
@@ -0,0 +1,104 @@
+#include "core/wtc640/postprocessingmatrices.h"
+
+#include "core/misc/instructionset.h"
+#include "core/misc/simdtarget.h"
+
+#include <cassert>
+
+
+namespace core
+{
+
+namespace
+{
+
+// power of two - multiplication gives same result as division
+constexpr float NUC_SCALE = 1.0f / PostProcessingMatrices::NUC_FACTOR;
+
+void decodeScalar(const uint16_t* words, size_t pixelsCount, float* nuc, int16_t* onuc, int16_t* offset)
+{
+    for (size_t i = 0; i < pixelsCount; ++i, words += PostProcessingMatrices::WORDS_PER_PIXEL)
+    {
+        onuc[i] = static_cast<int16_t>(words[1]);
+        nuc[i] = static_cast<float>(static_cast<int16_t>(words[2])) * NUC_SCALE;
+        offset[i] = static_cast<int16_t>(words[3]);
+    }
+}
+
+#if defined(CORE_SIMD_X86)
+
+// 8 pixels per iteration
+CORE_TARGET_SSE41 size_t decodeSse41(const uint16_t* words, size_t pixelsCount, float* nuc, int16_t* onuc, int16_t* offset)
+{
+    // 2 pixels per register: [x0 o0 n0 f0 x1 o1 n1 f1] -> [o0 o1 | n0 n1 | f0 f1 | x0 x1]
+    const __m128i groupWords = _mm_setr_epi8(2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15, 0, 1, 8, 9);
+    const __m128 scale = _mm_set1_ps(NUC_SCALE);
+
+    size_t i = 0;
+    for (; i + 8 <= pixelsCount; i += 8)
+    {
+        const auto* input = reinterpret_cast<const __m128i*>(words + i * PostProcessingMatrices::WORDS_PER_PIXEL);
+        const __m128i pixels01 = _mm_shuffle_epi8(_mm_loadu_si128(input), groupWords);
+        const __m128i pixels23 = _mm_shuffle_epi8(_mm_loadu_si128(input + 1), groupWords);
+        const __m128i pixels45 = _mm_shuffle_epi8(_mm_loadu_si128(input + 2), groupWords);
+        const __m128i pixels67 = _mm_shuffle_epi8(_mm_loadu_si128(input + 3), groupWords);
+
+        // [onuc 0-3 | nuc 0-3], [offset 0-3 | reserved 0-3]
+        const __m128i onucNuc0123 = _mm_unpacklo_epi32(pixels01, pixels23);
+        const __m128i offset0123 = _mm_unpackhi_epi32(pixels01, pixels23);
+        const __m128i onucNuc4567 = _mm_unpacklo_epi32(pixels45, pixels67);
+        const __m128i offset4567 = _mm_unpackhi_epi32(pixels45, pixels67);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(onuc + i), _mm_unpacklo_epi64(onucNuc0123, onucNuc4567));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(offset + i), _mm_unpacklo_epi64(offset0123, offset4567));
+
+        const __m128i nucFixed = _mm_unpackhi_epi64(onucNuc0123, onucNuc4567);
+        _mm_storeu_ps(nuc + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(nucFixed)), scale));
+        _mm_storeu_ps(nuc + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(nucFixed, 8))), scale));
+    }
+
+    return i;
+}
+
+#endif // CORE_SIMD_X86
+
+} // namespace
+
+void PostProcessingMatrices::resize(size_t pixelsCount)
+{
+    nuc.resize(pixelsCount);
+    onuc.resize(pixelsCount);
+    offset.resize(pixelsCount);
+}
+
+void PostProcessingMatrices::decodeInterleaved(std::span<const uint16_t> words, size_t firstPixel)
+{
+    assert(words.size() % WORDS_PER_PIXEL == 0);
+    const size_t pixelsCount = words.size() / WORDS_PER_PIXEL;
+    assert(firstPixel + pixelsCount <= nuc.size() && nuc.size() == onuc.size() && nuc.size() == offset.size());
+
+    float* const nucOutput = nuc.data() + firstPixel;
+    int16_t* const onucOutput = onuc.data() + firstPixel;
+    int16_t* const offsetOutput = offset.data() + firstPixel;
+
+    size_t done = 0;
+
+#if defined(CORE_SIMD_X86)
+    if (simd::getInstructionSet() != simd::InstructionSet::SCALAR)
+    {
+        done = decodeSse41(words.data(), pixelsCount, nucOutput, onucOutput, offsetOutput);
+    }
+#endif
+
+    decodeScalar(words.data() + done * WORDS_PER_PIXEL, pixelsCount - done, nucOutput + done, onucOutput + done, offsetOutput + done);
+}
+
+PostProcessingMatrices PostProcessingMatrices::createFromInterleaved(std::span<const uint16_t> words)
+{
+    PostProcessingMatrices matrices;
+    matrices.resize(words.size() / WORDS_PER_PIXEL);
+    matrices.decodeInterleaved(words.first(matrices.nuc.size() * WORDS_PER_PIXEL), 0);
+    return matrices;
+}
+
+} // namespace core
@@ -18,6 +18,7 @@
 
 #include "core/misc/buffereddatareader.h"
 #include "core/misc/elapsedtimer.h"
+#include "core/misc/workerpool.h"
 #include "core/logging.h"
 #include "core/prtutils.h"
 
@@ -29,9 +30,13 @@
 #include <boost/polymorphic_cast.hpp>
 #include <boost/icl/separate_interval_set.hpp>
 #include <boost/regex.hpp>
+#include <boost/crc.hpp>
 
+#include <array>
+#include <future>
 #include <ranges>
 #include <algorithm>
+#include <utility>
 
 
 namespace core
@@ -1617,6 +1622,73 @@ void PropertiesWtc640::onTransactionFinished(const TransactionSummary& transacti
     }
 }
 
+bool PropertiesWtc640::isPropertyCacheable(PropertyId propertyId) const
+{
+    // changed by device, but not covered by status update groups
+    static const std::set<PropertyId> NOT_CACHEABLE_PROPERTIES {PropertyIdWtc640::FPGA_BOARD_TEMPERATURE, PropertyIdWtc640::TARGET_MF_POSITION};
+
+    if (m_instantlyVolatileProperties.contains(propertyId) || NOT_CACHEABLE_PROPERTIES.contains(propertyId))
+    {
+        return false;
+    }
+
+    return std::none_of(m_volatileProperties.begin(), m_volatileProperties.end(), [propertyId](const auto& updateGroupProperties)
+    {
+        return std::find(updateGroupProperties.second.begin(), updateGroupProperties.second.end(), propertyId) != updateGroupProperties.second.end();
+    });
+}
+
+ValueResult<std::string> PropertiesWtc640::readPropertiesCacheDeviceKey(connection::IDeviceInterface* device, const connection::AddressRanges& cachedRanges)
+{
+    using ResultType = ValueResult<std::string>;
+
+    std::string key;
+    for (const auto& addressRange : {MemorySpaceWtc640::SERIAL_NUMBER_CURRENT, MemorySpaceWtc640::MAIN_FIRMWARE_VERSION})
+    {
+        TRY_GET_RESULT(const auto data, device->readAddressRange(addressRange, ProgressTask()));
+
+        for (const auto byte : data)
+        {
+            key += utils::numberToHex(byte, false);
+        }
+        key += ':';
+    }
+
+    // device has no change counter - checksum of all cached ranges detects data changed since cache was created (by another application,
+    // reset to factory defaults...)
+    std::vector<AddressRange> checksummedRanges;
+    for (const auto& addressRange : cachedRanges.getRanges())
+    {
+        checksummedRanges.push_back(getPropertiesCacheChecksummedRange(addressRange));
+    }
+
+    // merged => flash image read in full packets
+    const connection::AddressRanges checksummedBlocks(checksummedRanges);
+
+    boost::crc_32_type crc;
+    for (const auto& addressRange : checksummedBlocks.getRanges())
+    {
+        TRY_GET_RESULT(const auto data, device->readAddressRange(addressRange, ProgressTask()));
+
+        crc.process_bytes(data.data(), data.size());
+    }
+    key += utils::numberToHex(crc.checksum(), false);
+
+    return key;
+}
+
+connection::AddressRange PropertiesWtc640::getPropertiesCacheChecksummedRange(const AddressRange& cachedRange)
+{
+    // palette registers are read by one word per packet (~4k packets) - palettes are loaded at power up from their flash image, which is read
+    // in few packets; palette changed in registers only (not saved to flash) is not detected
+    if (MemorySpaceWtc640::PALETTES_REGISTERS.contains(cachedRange))
+    {
+        return cachedRange.moved(MemorySpaceWtc640::PALETTES_FLASH_OFFSET);
+    }
+
+    return cachedRange;
+}
+
 std::optional<Baudrate::Item> PropertiesWtc640::getCurrentBaudrateImpl() const
 {
     if (const auto* datalinkUart = dynamic_cast<const connection::DataLinkUart*>(m_dataLinkInterface.get()))
@@ -3548,6 +3620,20 @@ VoidResult PropertiesWtc640::ConnectionStateTransaction::connectEbus(const conne
     return VoidResult::createOk();
 }
 
+VoidResult PropertiesWtc640::ConnectionStateTransaction::connectDataLink(const std::shared_ptr<connection::IDataLinkInterface>& dataLinkInterface) const
+{
+    assert(dataLinkInterface != nullptr);
+
+    if (const auto result = setDataLinkInterface(dataLinkInterface); !result.isOk())
+    {
+        return result;
+    }
+
+    getProperties()->m_lastConnectedUartPort = std::nullopt;
+    getProperties()->m_lastConnectedEbusDevice = std::nullopt;
+    return VoidResult::createOk();
+}
+
 void PropertiesWtc640::ConnectionStateTransaction::disconnectCore() const
 {
     const auto result = setDataLinkInterface(nullptr);
@@ -3832,6 +3918,32 @@ ValueResult<std::vector<std::vector<uint16_t>>> PropertiesWtc640::ConnectionExcl
 {
     using ResultType = ValueResult<std::vector<std::vector<uint16_t>>>;
 
+    const auto captureAddressResult = startCapture(imagesCount, progressController);
+    if (!captureAddressResult.isOk())
+    {
+        return ResultType::createFromError(captureAddressResult);
+    }
+
+    return readCapturedFrames(imagesCount, captureAddressResult.getValue(), progressController);
+}
+
+ValueResult<CapturedFrames> PropertiesWtc640::ConnectionExclusiveTransactionWtc640::captureFrames(int imagesCount, const CapturedFrameCallback& frameCallback, ProgressController progressController) const
+{
+    using ResultType = ValueResult<CapturedFrames>;
+
+    const auto captureAddressResult = startCapture(imagesCount, progressController);
+    if (!captureAddressResult.isOk())
+    {
+        return ResultType::createFromError(captureAddressResult);
+    }
+
+    return readCapturedFrames(imagesCount, captureAddressResult.getValue(), frameCallback, progressController);
+}
+
+ValueResult<uint32_t> PropertiesWtc640::ConnectionExclusiveTransactionWtc640::startCapture(int imagesCount, ProgressController progressController) const
+{
+    using ResultType = ValueResult<uint32_t>;
+
     const auto& transaction = m_connectionExclusiveTransaction.getPropertiesTransaction();
     const auto imageFreezeValue = transaction.getValue<bool>(core::PropertyIdWtc640::IMAGE_FREEZE);
     if (imageFreezeValue.hasResult() && imageFreezeValue.getResult().isOk() && imageFreezeValue.getResult().getValue() && imagesCount != 1)
@@ -3841,48 +3953,64 @@ ValueResult<std::vector<std::vector<uint16_t>>> PropertiesWtc640::ConnectionExcl
         return RESULT;
     }
 
-    uint32_t captureAddress {0};
+    auto task = progressController.createTaskUnbound("Image capture", true);
+    const auto captureAddressResult = captureImagesAndReadAddress(imagesCount);
+    if (!captureAddressResult.isOk())
     {
-        auto task = progressController.createTaskUnbound("Image capture", true);
-        const auto captureAddressResult = captureImagesAndReadAddress(imagesCount);
-        if (!captureAddressResult.isOk())
-        {
-            const auto RESULT = ResultType::createFromError(captureAddressResult);
-            task.sendErrorMessage(RESULT.toString());
-            return RESULT;
-        }
-
-        captureAddress = captureAddressResult.getValue();
+        task.sendErrorMessage(captureAddressResult.toString());
     }
 
-    return readCapturedFrames(imagesCount, captureAddress, progressController);
+    return captureAddressResult;
 }
 
 ValueResult<PostProcessingMatrices> PropertiesWtc640::ConnectionExclusiveTransactionWtc640::getPostProcessingMatrices(ProgressController progressController) const
 {
-    static constexpr int16_t FACTOR = 1 << 14;
+    static constexpr size_t CHUNK_PIXELS = core::DevicesWtc640::WIDTH * 32;
+    static constexpr size_t BYTES_PER_PIXEL = PostProcessingMatrices::WORDS_PER_PIXEL * sizeof(uint16_t);
 
     using ResultType = ValueResult<PostProcessingMatrices>;
 
-    auto task = progressController.createTaskBound("Getting post processing matrices", core::DevicesWtc640::WIDTH * core::DevicesWtc640::HEIGHT * 4 * 2, false);
-    auto futureResult = m_connectionExclusiveTransaction.getPropertiesTransaction().readDataWithProgress<uint16_t>(core::connection::MemorySpaceWtc640::RAM_CALIBRATION_MATRICE.getFirstAddress(), core::DevicesWtc640::WIDTH*core::DevicesWtc640::HEIGHT*4, task);
-    const auto valueResult = futureResult.get();
-    if(!valueResult.isOk())
-    {
-        return ResultType::createError("Could not retrieve post processing matrice from RAM!", valueResult.toString());
-    }
+    const size_t pixelsCount = core::DevicesWtc640::WIDTH * core::DevicesWtc640::HEIGHT;
+    static_assert(MemorySpaceWtc640::RAM_CALIBRATION_MATRICE.getSize() == core::DevicesWtc640::WIDTH * core::DevicesWtc640::HEIGHT * BYTES_PER_PIXEL);
+
+    auto task = progressController.createTaskBound("Getting post processing matrices", pixelsCount * BYTES_PER_PIXEL, false);
 
     auto matrices = PostProcessingMatrices();
-    matrices.nuc.reserve(DevicesWtc640::HEIGHT*DevicesWtc640::WIDTH);
-    matrices.onuc.reserve(DevicesWtc640::HEIGHT*DevicesWtc640::WIDTH);
-    matrices.offset.reserve(DevicesWtc640::HEIGHT*DevicesWtc640::WIDTH);
-    const auto data = valueResult.getValue();
+    matrices.resize(pixelsCount);
+
+    // exclusive transaction reads synchronously in calling thread => previous chunk is decoded on worker pool meanwhile
+    // double buffered - chunk being read never shares buffer with chunk being decoded
+    std::array<std::vector<uint16_t>, 2> buffers;
+    std::future<void> decoding;
+    for (size_t firstPixel = 0, chunk = 0; firstPixel < pixelsCount; firstPixel += CHUNK_PIXELS, ++chunk)
+    {
+        auto& buffer = buffers[chunk % buffers.size()];
+        buffer.resize(std::min(CHUNK_PIXELS, pixelsCount - firstPixel) * PostProcessingMatrices::WORDS_PER_PIXEL);
+
+        const auto chunkResult = m_connectionExclusiveTransaction.readDataToBufferWithProgress<uint16_t>(buffer, MemorySpaceWtc640::RAM_CALIBRATION_MATRICE.getFirstAddress() + firstPixel * BYTES_PER_PIXEL, task);
+        if (!chunkResult.isOk())
+        {
+            // unlike future of std::async, worker pool future does not wait in destructor => decoding must not outlive buffers
+            if (decoding.valid())
+            {
+                decoding.wait();
+            }
+            return ResultType::createError("Could not retrieve post processing matrice from RAM!", chunkResult.toString());
+        }
+
+        if (decoding.valid())
+        {
+            decoding.get();
+        }
+        decoding = workerpool::run([&matrices, &buffer, firstPixel]()
+        {
+            matrices.decodeInterleaved(buffer, firstPixel);
+        });
+    }
 
-    for(size_t i = 1; i < data.size(); i += 4)
+    if (decoding.valid())
     {
-        matrices.onuc.push_back(static_cast<int16_t>(data[i]));
-        matrices.nuc.push_back(static_cast<float>(static_cast<int16_t>(data[i+1])) / FACTOR);
-        matrices.offset.push_back(static_cast<int16_t>(data[i + 2]));
+        decoding.get();
     }
 
     return matrices;
@@ -3920,29 +4048,95 @@ ValueResult<std::vector<std::vector<uint16_t>>> PropertiesWtc640::ConnectionExcl
 {
     using ResultType = ValueResult<std::vector<std::vector<uint16_t>>>;
 
+    const auto framesResult = readCapturedFrames(framesToCaptureCount, captureAddress, nullptr, progressController);
+    if (!framesResult.isOk())
+    {
+        return ResultType::createFromError(framesResult);
+    }
+
+    return framesResult.getValue().toVectors();
+}
+
+ValueResult<CapturedFrames> PropertiesWtc640::ConnectionExclusiveTransactionWtc640::readCapturedFrames(uint8_t framesToCaptureCount, uint32_t captureAddress, const CapturedFrameCallback& frameCallback,
+                                                                                                     ProgressController progressController) const
+{
+    using ResultType = ValueResult<CapturedFrames>;
+
     const auto pixelsCount = DevicesWtc640::WIDTH * DevicesWtc640::HEIGHT;
     const auto bytesPerImage = pixelsCount * sizeof(uint16_t);
 
     auto task = progressController.createTaskBound("Image capture", bytesPerImage * framesToCaptureCount, true);
 
-    std::vector<std::vector<uint16_t>> images;
-    images.reserve(framesToCaptureCount);
+    CapturedFrames frames(framesToCaptureCount, pixelsCount);
+
+    // callback of previous frame runs on worker pool while next frame is read on this thread
+    // worker pool future does not wait in destructor => every return waits for processing of frames
+    std::future<VoidResult> processing;
+
+    const auto createError = [&](const std::string& detailErrorMessage)
+    {
+        if (processing.valid())
+        {
+            processing.wait();
+        }
+
+        const auto RESULT = ResultType::createError("Image capture failed!", detailErrorMessage);
+        task.sendErrorMessage(RESULT.toString());
+        return RESULT;
+    };
+
+    const auto waitForProcessing = [&]()
+    {
+        try
+        {
+            return processing.get();
+        }
+        catch (const std::exception& exception)
+        {
+            return VoidResult::createError("Processing failed", exception.what());
+        }
+        catch (...)
+        {
+            return VoidResult::createError("Processing failed", "unknown exception");
+        }
+    };
 
     for (size_t i = 0; i < framesToCaptureCount; ++i)
     {
-        const auto frameResult = m_connectionExclusiveTransaction.readDataWithProgress<uint16_t>(captureAddress + i * bytesPerImage, pixelsCount,
-                                                                                                 task);
-        if (!frameResult.isOk())
+        if (const auto frameResult = m_connectionExclusiveTransaction.readDataToBufferWithProgress<uint16_t>(frames.getFrame(i), captureAddress + i * bytesPerImage, task);
+            !frameResult.isOk())
         {
-            const auto RESULT = ResultType::createError("Image capture failed!", utils::format("frame {} read: {}", i + 1, frameResult.getDetailErrorMessage()));
-            task.sendErrorMessage(RESULT.toString());
-            return RESULT;
+            return createError(utils::format("frame {} read: {}", i + 1, frameResult.getDetailErrorMessage()));
         }
 
-        images.push_back(frameResult.getValue());
+        if (!frameCallback)
+        {
+            continue;
+        }
+
+        if (processing.valid())
+        {
+            if (const auto result = waitForProcessing(); !result.isOk())
+            {
+                return createError(utils::format("frame {} processing: {}", i, result.toString()));
+            }
+        }
+
+        processing = workerpool::run([&frameCallback, &frames, i]()
+        {
+            return frameCallback(i, std::as_const(frames).getFrame(i));
+        });
+    }
+
+    if (processing.valid())
+    {
+        if (const auto result = waitForProcessing(); !result.isOk())
+        {
+            return createError(utils::format("frame {} processing: {}", framesToCaptureCount, result.toString()));
+        }
     }
 
-    return images;
+    return frames;
 }
 
 PropertiesWtc640::ConnectionStateTransaction PropertiesWtc640::ConnectionExclusiveTransactionWtc640::openConnectionStateTransaction() const